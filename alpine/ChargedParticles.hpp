@@ -67,7 +67,7 @@ using P3MSolver_t = ConditionalType<Dim == 3, ippl::P3MSolver<VField_t<T, Dim>,
 
 template <typename T = double, unsigned Dim = 3>
 using OpenSolver_t =
-    ConditionalType<Dim == 3, ippl::FFTPoissonSolver<VField_t<T, Dim>, Field_t<Dim>>>;
+    ConditionalType<Dim == 2 || Dim == 3, ippl::FFTPoissonSolver<VField_t<T, Dim>, Field_t<Dim>>>;
 
 template <typename T = double, unsigned Dim = 3>
 using Solver_t = VariantFromConditionalTypes<CGSolver_t<T, Dim>, FFTSolver_t<T, Dim>,
@@ -319,12 +319,12 @@ public:
         if constexpr (Dim == 2 || Dim == 3) {
             if (stype_m == "FFT") {
                 std::get<FFTSolver_t<T, Dim>>(solver_m).setRhs(rho_m);
+            } else if (stype_m == "OPEN") {
+                std::get<OpenSolver_t<T, Dim>>(solver_m).setRhs(rho_m);
             }
             if constexpr (Dim == 3) {
                 if (stype_m == "P3M") {
                     std::get<P3MSolver_t<T, Dim>>(solver_m).setRhs(rho_m);
-                } else if (stype_m == "OPEN") {
-                    std::get<OpenSolver_t<T, Dim>>(solver_m).setRhs(rho_m);
                 }
             }
         }
@@ -482,7 +482,7 @@ public:
                 std::get<P3MSolver_t<T, Dim>>(solver_m).solve();
             }
         } else if (stype_m == "OPEN") {
-            if constexpr (Dim == 3) {
+            if constexpr (Dim == 2 || Dim == 3) {
                 std::get<OpenSolver_t<T, Dim>>(solver_m).solve();
             }
         } else {
@@ -516,6 +516,8 @@ public:
         sp.add("output_type", CGSolver_t<T, Dim>::GRAD);
         // Increase tolerance in the 1D case
         sp.add("tolerance", 1e-10);
+        // Start from the projection onto the previous timesteps' potentials
+        sp.add("warm_start", CGSolver_t<T, Dim>::PROJECTION);
 
         initSolverWithParams<CGSolver_t<T, Dim>>(sp);
     }
@@ -555,7 +557,7 @@ public:
     }
 
     void initOpenSolver() {
-        if constexpr (Dim == 3) {
+        if constexpr (Dim == 2 || Dim == 3) {
             ippl::ParameterList sp;
             sp.add("output_type", OpenSolver_t<T, Dim>::GRAD);
             sp.add("use_heffte_defaults", false);
@@ -578,8 +580,7 @@ public:
         double kinEnergy = 0.0;
         double potEnergy = 0.0;
 
-        rho_m     = dot(E_m, E_m);
-        potEnergy = 0.5 * hr_m[0] * hr_m[1] * hr_m[2] * rho_m.sum();
+        potEnergy = 0.5 * hr_m[0] * hr_m[1] * hr_m[2] * ippl::sum(dot(E_m, E_m), E_m);
 
         Kokkos::parallel_reduce(
             "Particle Kinetic Energy", this->getLocalNum(),
@@ -715,32 +716,25 @@ public:
         double fieldEnergy, EzAmp;
 
         using index_array_type = typename ippl::RangePolicy<Dim>::index_array_type;
-        double temp            = 0.0;
+        double temp = 0.0, tempMax = 0.0;
         ippl::parallel_reduce(
-            "Ex inner product", ippl::getRangePolicy(Eview, nghostE),
-            KOKKOS_LAMBDA(const index_array_type& args, double& valL) {
+            "Ez stats", ippl::getRangePolicy(Eview, nghostE),
+            KOKKOS_LAMBDA(const index_array_type& args, double& E2, double& ENorm) {
                 // ippl::apply accesses the view at the given indices and obtains a
                 // reference; see src/Expression/IpplOperations.h
-                double myVal = std::pow(ippl::apply(Eview, args)[Dim - 1], 2);
-                valL += myVal;
+                double val = ippl::apply(Eview, args)[Dim - 1];
+                E2 += val * val;
+
+                double norm = Kokkos::fabs(val);
+                if (norm > ENorm) {
+                    ENorm = norm;
+                }
             },
-            Kokkos::Sum<double>(temp));
+            Kokkos::Sum<double>(temp), Kokkos::Max<double>(tempMax));
         double globaltemp = 0.0;
         MPI_Reduce(&temp, &globaltemp, 1, MPI_DOUBLE, MPI_SUM, 0, ippl::Comm->getCommunicator());
         fieldEnergy = std::reduce(hr_m.begin(), hr_m.end(), globaltemp, std::multiplies<double>());
 
-        double tempMax = 0.0;
-        ippl::parallel_reduce(
-            "Ex max norm", ippl::getRangePolicy(Eview, nghostE),
-            KOKKOS_LAMBDA(const index_array_type& args, double& valL) {
-                // ippl::apply accesses the view at the given indices and obtains a
-                // reference; see src/Expression/IpplOperations.h
-                double myVal = std::fabs(ippl::apply(Eview, args)[Dim - 1]);
-                if (myVal > valL) {
-                    valL = myVal;
-                }
-            },
-            Kokkos::Max<double>(tempMax));
         EzAmp = 0.0;
         MPI_Reduce(&tempMax, &EzAmp, 1, MPI_DOUBLE, MPI_MAX, 0, ippl::Comm->getCommunicator());
 
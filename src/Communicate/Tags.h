@@ -109,7 +109,7 @@ namespace ippl {
 #define IPPL_PARTICLE_SEND      9000
 #define IPPL_PARTICLE_RECV      10000
 
-// FFT Poisson Solver
+// FFT Poisson Solver and the redistribution of fields between layouts
 #define IPPL_SOLVER_SEND        13000
 #define IPPL_SOLVER_RECV        14000
 #define IPPL_VICO_SEND          16000
@@ -118,4 +118,16 @@ namespace ippl {
 #define OPEN_SOLVER_TAG         18000
 #define VICO_SOLVER_TAG         70000
 
+// Pruned FFT reshapes
+#define IPPL_FFT_SEND           3000
+#define IPPL_FFT_RECV           4000
+
+#define FFT_PRUNED_TAG          19000
+
+// Multigrid redistribution of levels whose local domains cannot be halved
+#define IPPL_MG_SEND            5000
+#define IPPL_MG_RECV            6000
+
+#define MG_REDISTRIBUTION_TAG   29000
+
 #endif  // TAGS_H
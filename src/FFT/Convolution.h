@@ -0,0 +1,161 @@
+//
+// Class Convolution
+//   Discrete convolution of fields with a kernel using Fourier transforms, e.g.
+//   for smoothing filters or custom Green's functions. The kernel is given as a
+//   field or as a function of the displacement and is transformed once when it is
+//   set; each convolution then takes one forward and one backward transform.
+//
+//   Convolutions are either periodic or linear. For linear convolutions, the field
+//   is zero-padded to twice its size in each dimension as in Hockney's method for
+//   open boundaries, so that the kernel does not wrap around the domain.
+//
+//   The transforms use the heffte plan cache, so a convolution shares its plans
+//   with the FFT-based solvers and other convolutions on the same grid and with
+//   the same heffte options.
+//
+
+#ifndef IPPL_FFT_CONVOLUTION_H
+#define IPPL_FFT_CONVOLUTION_H
+
+#include <memory>
+#include <vector>
+
+#include "Types/Vector.h"
+
+#include "Utility/IpplException.h"
+#include "Utility/IpplTimings.h"
+#include "Utility/ParameterList.h"
+
+#include "Communicate/Archive.h"
+#include "FFT/FFT.h"
+#include "Field/HaloCells.h"
+#include "Field/Redistribution.h"
+#include "FieldLayout/FieldLayout.h"
+
+namespace ippl {
+
+    template <typename Field>
+    class Convolution {
+        constexpr static unsigned Dim = Field::dim;
+        using T                       = typename Field::value_type;
+
+    public:
+        using Field_t      = Field;
+        using FFT_t        = FFT<RCTransform, Field>;
+        using CxField_t    = typename FFT_t::ComplexField;
+        using Layout_t     = FieldLayout<Dim>;
+        using mesh_type    = typename Field::Mesh_t;
+        using vector_type  = typename mesh_type::vector_type;
+        using memory_space = typename Field::memory_space;
+        using buffer_type  = Communicate::buffer_type<memory_space>;
+
+        enum Boundary {
+            PERIODIC    = 0,
+            ZERO_PADDED = 1
+        };
+
+        /*!
+         * Sets up the transforms of a convolution on a grid; this is collective
+         * @param layout the layout of the fields to convolve
+         * @param mesh the mesh of the fields to convolve
+         * @param params the parameters, "boundary" (PERIODIC or ZERO_PADDED)
+         * and the heffte parameters
+         */
+        Convolution(Layout_t& layout, mesh_type& mesh, const ParameterList& params);
+
+        ~Convolution() = default;
+
+        /*!
+         * Sets the kernel from a field on the kernel layout, in which index i of a
+         * dimension of size n stands for the displacement i for i < n/2 and i - n
+         * otherwise. The transform of the kernel is kept until the next call.
+         * @param kernel the kernel
+         */
+        void setKernel(Field& kernel);
+
+        /*!
+         * Sets the kernel from a function of the displacement, which is evaluated
+         * in a kernel and must therefore be callable on the device
+         * @tparam Functor the type of the function
+         * @param kernel the function, taking the displacement as a vector_type
+         */
+        template <typename Functor>
+        void setKernel(const Functor& kernel);
+
+        /*!
+         * Convolves a field with the kernel, i.e. out(i) = sum_j K(i - j) in(j),
+         * where the sum runs over the cells of the grid. The sum is not weighted
+         * by the cell volume; kernels approximating an integral must include it.
+         * @param in the field to convolve
+         * @param out the field in which to store the result, which may be in
+         */
+        void convolve(Field& in, Field& out);
+
+        /*!
+         * Convolves a field with the kernel in place
+         * @param field the field
+         */
+        void convolve(Field& field) { convolve(field, field); }
+
+        /*!
+         * The layout and mesh on which the kernel is given, which are those of the
+         * fields for periodic convolutions and of the padded grid otherwise
+         */
+        Layout_t& getKernelLayout() { return padded_m ? *layout2_m : *layout_mp; }
+        mesh_type& getKernelMesh() { return padded_m ? *mesh2_m : *mesh_mp; }
+
+    private:
+        void setDefaultParameters();
+
+        /*!
+         * Copies the part of a field that lies in another layout's domains into the
+         * field on that layout, communicating with the ranks that own the data
+         * @param sends the blocks of src to send
+         * @param recvs the blocks of dst to receive
+         * @param src the field to copy from
+         * @param dst the field to copy to
+         */
+        void transfer(const std::vector<detail::CommBlock<Dim>>& sends,
+                      const std::vector<detail::CommBlock<Dim>>& recvs, Field& src, Field& dst);
+
+        ParameterList params_m;
+
+        // whether the convolution is linear, i.e. the fields are zero-padded
+        bool padded_m;
+
+        // layout and mesh of the fields to convolve
+        Layout_t* layout_mp;
+        mesh_type* mesh_mp;
+
+        // layout and mesh of the padded grid, only set up for linear convolutions
+        std::unique_ptr<Layout_t> layout2_m;
+        std::unique_ptr<mesh_type> mesh2_m;
+
+        // from the physical to the padded grid; reversed for the way back
+        detail::CommPlan<Dim> paddedPlan_m;
+
+        // layout and mesh of the transforms
+        std::unique_ptr<Layout_t> layoutComplex_m;
+        std::unique_ptr<mesh_type> meshComplex_m;
+
+        // field on the kernel layout, which holds the padded fields of linear
+        // convolutions and the values of functor kernels
+        Field_t work_m;
+
+        // transform of the field and of the kernel
+        CxField_t fieldTr_m;
+        CxField_t kernelTr_m;
+
+        std::unique_ptr<FFT_t> fft_m;
+
+        // number of points of the transforms, by which the result is scaled
+        T normalization_m;
+
+        // buffer for communication
+        detail::FieldBufferData<T> fd_m;
+    };
+}  // namespace ippl
+
+#include "FFT/Convolution.hpp"
+
+#endif
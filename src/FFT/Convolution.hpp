@@ -0,0 +1,170 @@
+//
+// Class Convolution
+//   Discrete convolution of fields with a kernel using Fourier transforms.
+//
+
+namespace ippl {
+
+    template <typename Field>
+    Convolution<Field>::Convolution(Layout_t& layout, mesh_type& mesh, const ParameterList& params)
+        : layout_mp(&layout)
+        , mesh_mp(&mesh) {
+        static_assert(Dim == 2 || Dim == 3, "heFFTe only supports 2D and 3D");
+
+        setDefaultParameters();
+        params_m.merge(params);
+
+        const int boundary = params_m.template get<int>("boundary");
+        if (boundary != PERIODIC && boundary != ZERO_PADDED) {
+            throw IpplException("Convolution::Convolution", "Unrecognized boundary type");
+        }
+        padded_m = (boundary == ZERO_PADDED);
+
+        const vector_type& hr     = mesh.getMeshSpacing();
+        const vector_type& origin = mesh.getOrigin();
+
+        e_dim_tag decomp[Dim];
+        for (unsigned d = 0; d < Dim; ++d) {
+            decomp[d] = layout.getRequestedDistribution(d);
+        }
+
+        // linear convolutions are done on a grid that is doubled in each dimension
+        const NDIndex<Dim>& domain = layout.getDomain();
+        NDIndex<Dim> domain2;
+        for (unsigned d = 0; d < Dim; ++d) {
+            domain2[d] = Index(padded_m ? 2 * domain[d].length() : domain[d].length());
+        }
+
+        if (padded_m) {
+            mesh2_m   = std::make_unique<mesh_type>(domain2, hr, origin);
+            layout2_m = std::make_unique<Layout_t>(domain2, decomp);
+
+            paddedPlan_m = detail::makeCommPlan(*layout_mp, *layout2_m);
+        }
+
+        // one of the dimensions has only (n/2 + 1) points as the fields are real
+        const int RCDirection = params_m.template get<int>("r2c_direction");
+        NDIndex<Dim> domainComplex;
+        normalization_m = 1;
+        for (unsigned d = 0; d < Dim; ++d) {
+            const int n      = domain2[d].length();
+            domainComplex[d] = Index((int)d == RCDirection ? n / 2 + 1 : n);
+            normalization_m *= n;
+        }
+
+        meshComplex_m   = std::make_unique<mesh_type>(domainComplex, hr, origin);
+        layoutComplex_m = std::make_unique<Layout_t>(domainComplex, decomp);
+
+        work_m.initialize(getKernelMesh(), getKernelLayout());
+        fieldTr_m.initialize(*meshComplex_m, *layoutComplex_m);
+        kernelTr_m.initialize(*meshComplex_m, *layoutComplex_m);
+
+        fft_m = std::make_unique<FFT_t>(getKernelLayout(), *layoutComplex_m, params_m);
+    }
+
+    template <typename Field>
+    void Convolution<Field>::setDefaultParameters() {
+        using heffteBackend       = typename FFT_t::heffteBackend;
+        heffte::plan_options opts = heffte::default_options<heffteBackend>();
+        params_m.add("boundary", PERIODIC);
+        params_m.add("use_heffte_defaults", true);
+        params_m.add("use_pencils", opts.use_pencils);
+        params_m.add("use_reorder", opts.use_reorder);
+        params_m.add("use_gpu_aware", opts.use_gpu_aware);
+        params_m.add("comm", p2p_pl);
+        params_m.add("r2c_direction", 0);
+    }
+
+    template <typename Field>
+    void Convolution<Field>::setKernel(Field& kernel) {
+        if (kernel.getLayout() != getKernelLayout()) {
+            throw IpplException("Convolution::setKernel",
+                                "The kernel must be given on the kernel layout");
+        }
+
+        static IpplTimings::TimerRef fftk = IpplTimings::getTimer("Convolution: Kernel");
+        IpplTimings::startTimer(fftk);
+        fft_m->transform(FORWARD, kernel, kernelTr_m);
+        IpplTimings::stopTimer(fftk);
+    }
+
+    template <typename Field>
+    template <typename Functor>
+    void Convolution<Field>::setKernel(const Functor& kernel) {
+        auto view        = work_m.getView();
+        const int nghost = work_m.getNghost();
+        const auto& ldom = getKernelLayout().getLocalNDIndex();
+        const auto& hr   = mesh_mp->getMeshSpacing();
+
+        Vector<int, Dim> size;
+        for (unsigned d = 0; d < Dim; ++d) {
+            size[d] = getKernelLayout().getDomain()[d].length();
+        }
+
+        // the upper half of each dimension holds the negative displacements
+        using index_array_type = typename RangePolicy<Dim>::index_array_type;
+        ippl::parallel_for(
+            "Convolution kernel", work_m.getFieldRangePolicy(),
+            KOKKOS_LAMBDA(const index_array_type& args) {
+                vector_type x;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    const int ig     = args[d] - nghost + ldom[d].first();
+                    const bool upper = (2 * ig >= size[d]);
+                    x[d]             = (ig - upper * size[d]) * hr[d];
+                }
+                apply(view, args) = kernel(x);
+            });
+
+        setKernel(work_m);
+    }
+
+    template <typename Field>
+    void Convolution<Field>::convolve(Field& in, Field& out) {
+        if (in.getLayout() != *layout_mp || out.getLayout() != *layout_mp) {
+            throw IpplException("Convolution::convolve",
+                                "The fields must be on the layout of the convolution");
+        }
+
+        static IpplTimings::TimerRef convolution = IpplTimings::getTimer("Convolution");
+        IpplTimings::startTimer(convolution);
+
+        // for linear convolutions, the field is stored in the physical part of the
+        // padded grid; the rest of the grid is treated as zero by the forward FFT
+        Field& field = padded_m ? work_m : in;
+        if (padded_m) {
+            transfer(paddedPlan_m.sends, paddedPlan_m.recvs, in, work_m);
+        }
+
+        const NDIndex<Dim>& physical = layout_mp->getDomain();
+        fft_m->transform(FORWARD, field, fieldTr_m, physical);
+
+        fieldTr_m = fieldTr_m * kernelTr_m;
+
+        // both forward transforms are normalized by the number of points
+        if (padded_m) {
+            fft_m->transform(BACKWARD, work_m, fieldTr_m, physical, normalization_m);
+            transfer(paddedPlan_m.recvs, paddedPlan_m.sends, work_m, out);
+        } else {
+            fft_m->transform(BACKWARD, out, fieldTr_m, physical, normalization_m);
+        }
+
+        IpplTimings::stopTimer(convolution);
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // redistribution between the physical and the padded grid
+    template <typename Field>
+    void Convolution<Field>::transfer(const std::vector<detail::CommBlock<Dim>>& sends,
+                                      const std::vector<detail::CommBlock<Dim>>& recvs,
+                                      Field& src, Field& dst) {
+        auto dstView        = dst.getView();
+        const int nghostDst = dst.getNghost();
+        const auto& dstDom  = dst.getLayout().getLocalNDIndex();
+
+        detail::exchange(sends, recvs, src.getView(), src.getNghost(),
+                         src.getLayout().getLocalNDIndex(), fd_m, OPEN_SOLVER_TAG,
+                         IPPL_SOLVER_SEND, IPPL_SOLVER_RECV, [&](const auto& block) {
+                             detail::unpack(block.domain, dstView, fd_m, nghostDst, dstDom);
+                         });
+    }
+}  // namespace ippl
@@ -17,18 +17,25 @@
 
 #include <Kokkos_Complex.hpp>
 #include <array>
+#include <cmath>
 #include <heffte_fft3d.h>
 #include <heffte_fft3d_r2c.h>
+#include <limits>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include "Utility/IpplException.h"
 #include "Utility/ParameterList.h"
 
 #include "Field/Field.h"
 
+#include "FFT/FFTAutotune.h"
+#include "FFT/FFTPlanCache.h"
+#include "Field/Redistribution.h"
 #include "FieldLayout/FieldLayout.h"
 #include "Index/NDIndex.h"
+#include "Partition/Partitioner.h"
 
 namespace heffte {
     template <>
@@ -105,6 +112,20 @@ namespace ippl {
             using backendCos  = heffte::backend::stock_cos;
         };
 #endif
+
+        /*!
+         * Estimates the relative error (in the L2 norm) that rounding introduces into
+         * the result of a forward and a backward transform with a pointwise multiplication
+         * in between, as done by the FFT based solvers. The error of a transform grows
+         * with the logarithm of its size.
+         * @tparam T the precision of the transforms
+         * @param n the number of points of the transforms
+         * @return The relative error estimate
+         */
+        template <typename T>
+        T fftErrorEstimate(size_t n) {
+            return std::numeric_limits<T>::epsilon() * (2 + 2 * std::log2(static_cast<T>(n)));
+        }
     }  // namespace detail
 
     template <typename Field, template <typename...> class FFT, typename Backend,
@@ -116,6 +137,7 @@ namespace ippl {
         using heffteBackend = Backend;
         using workspace_t   = typename FFT<heffteBackend>::template buffer_container<BufferType>;
         using Layout_t      = FieldLayout<Dim>;
+        using plan_cache    = FFTPlanCache<FFT<heffteBackend, long long>, workspace_t>;
 
         FFTBase(const Layout_t& layout, const ParameterList& params);
         ~FFTBase() = default;
@@ -128,12 +150,52 @@ namespace ippl {
         void setup(const heffte::box3d<long long>& inbox, const heffte::box3d<long long>& outbox,
                    const ParameterList& params);
 
+        /*!
+         * Builds a heffte plan; this is collective
+         * @param inbox the input box of this rank
+         * @param outbox the output box of this rank
+         * @param r2cDirection the r2c dimension, ignored by other transforms
+         * @param options the heffte options
+         * @return The plan
+         */
+        static std::shared_ptr<FFT<heffteBackend, long long>> makePlan(
+            const heffte::box3d<long long>& inbox, const heffte::box3d<long long>& outbox,
+            int r2cDirection, const heffte::plan_options& options);
+
+        /*!
+         * Chooses the fastest heffte options for the boxes by timing forward and
+         * backward transforms for every combination of pencils, reorder and
+         * communication algorithm, unless they are known from earlier in the run
+         * or from the tuning file; this is collective
+         * @param inbox the input box of this rank
+         * @param outbox the output box of this rank
+         * @param r2cDirection the r2c dimension, or -1 for other transforms
+         * @param options the options whose other fields are kept
+         * @param params the FFT parameters with the tuning settings
+         * @return The tuned options
+         */
+        static heffte::plan_options autotune(const heffte::box3d<long long>& inbox,
+                                             const heffte::box3d<long long>& outbox,
+                                             int r2cDirection, heffte::plan_options options,
+                                             const ParameterList& params);
+
+        /*!
+         * The order in which the dimensions are stored in memory, fastest first,
+         * for the heffte boxes. It follows the layout of the field views so that
+         * heffte can work on the field storage directly when it has no ghost cells.
+         * @return The dimension indices from the fastest to the slowest
+         */
+        static std::array<int, 3> boxOrder();
+
+        // the plan and workspace may be shared with other FFTs through the plan cache
         std::shared_ptr<FFT<heffteBackend, long long>> heffte_m;
-        workspace_t workspace_m;
+        std::shared_ptr<workspace_t> workspace_m;
 
+        // contiguous copies of the fields without ghost cells, in the layout of the fields
         template <typename FieldType>
         using temp_view_type =
-            typename Kokkos::View<typename FieldType::view_type::data_type, Kokkos::LayoutLeft,
+            typename Kokkos::View<typename FieldType::view_type::data_type,
+                                  typename FieldType::view_type::array_layout,
                                   typename FieldType::memory_space>::uniform_type;
         temp_view_type<Field> tempField;
     };
@@ -207,8 +269,149 @@ namespace ippl {
          */
         void transform(TransformDirection direction, RealField& f, ComplexField& g);
 
+        /*!
+         * Perform FFT of a real field that is only needed inside of a region,
+         * such as a zero-padded field. Only the region of the real field is read
+         * by the forward transform, which treats the field as zero elsewhere,
+         * and only the region is written by the backward transform. Unless the
+         * region covers the whole domain, the transform is pruned: it is done as
+         * 1D transforms along one dimension after the other, each only over the
+         * pencils that are not known to be zero (see Pruning).
+         * @param direction Forward or backward transformation
+         * @param f Real field whose transformation to compute
+         * @param g Field in which to store the transformation
+         * @param region Global index region of the real field
+         * @param scale Factor by which the output is multiplied
+         */
+        void transform(TransformDirection direction, RealField& f, ComplexField& g,
+                       const NDIndex<Dim>& region, Real_t scale = 1);
+
+        // contiguous batch of transforms without ghost cells, one after the other
+        // along the slowest running dimension (see detail::batchDimension)
+        using batch_view_type = typename Base::template temp_view_type<ComplexField>;
+
+        /*!
+         * Perform the FFTs of several real fields on the same layout as a single
+         * batch, so that heffte exchanges the data of all transforms in the same
+         * messages. The transforms are stored in a single view, such that they can
+         * be processed by a single kernel.
+         * @param direction Forward or backward transformation
+         * @param f Real fields whose transformations to compute
+         * @param g Batch of transforms, which can be created from a complex field
+         * of the output layout with detail::batchedShrinkView
+         */
+        void transform(TransformDirection direction, const std::vector<RealField*>& f,
+                       batch_view_type& g);
+
+        /*!
+         * Perform the batched FFTs of several real fields that are only needed
+         * inside of a region (see the single field transform with a region)
+         * @param direction Forward or backward transformation
+         * @param f Real fields whose transformations to compute
+         * @param g Batch of transforms
+         * @param region Global index region of the real fields
+         * @param scale Factor by which the output is multiplied
+         */
+        void transform(TransformDirection direction, const std::vector<RealField*>& f,
+                       batch_view_type& g, const NDIndex<Dim>& region, Real_t scale = 1);
+
+        /*!
+         * Perform the FFTs of all components of a vector field as a single batch,
+         * so that heffte exchanges the data of all transforms in the same messages
+         * @param direction Forward or backward transformation
+         * @param f Vector field whose components to transform
+         * @param g Batch of transforms, one per component
+         */
+        template <typename VectorField>
+        void transform(TransformDirection direction, VectorField& f, batch_view_type& g);
+
     private:
+        using memory_space    = typename RealField::memory_space;
+        using execution_space = typename RealField::execution_space;
+
+        template <typename T>
+        using buffer_view_type = Kokkos::View<T*, memory_space>;
+
+        // pencils along one dimension, which is the fastest running one
+        template <typename T>
+        using pencil_view_type =
+            typename detail::ViewType<T, Dim, Kokkos::LayoutStride, memory_space,
+                                      Kokkos::MemoryUnmanaged>::view_type;
+
+        /*!
+         * The stages of the pruned transforms of a real field that is zero outside
+         * of a region. Each stage holds the pencils along the dimension that it
+         * transforms, the r2c dimension first. In the dimensions that are not
+         * transformed yet, the pencils only span the region, so every reshape
+         * between the stages only moves the data that is not known to be zero.
+         * The 1D transforms of a stage run as a batch on each rank.
+         */
+        struct Pruning {
+            // the region for which the stages are set up
+            NDIndex<Dim> region;
+
+            // the dimension transformed by each stage
+            std::array<int, Dim> dims;
+
+            // the local pencils of the real input of the first stage and of each stage
+            NDIndex<Dim> realDomain;
+            std::array<NDIndex<Dim>, Dim> domains;
+
+            // from the input to the first stage, between the stages and from the
+            // last stage to the output; reversed for backward transforms
+            std::array<detail::CommPlan<Dim>, Dim + 1> plans;
+
+            buffer_view_type<Real_t> real;
+            std::array<buffer_view_type<Complex_t>, Dim> complex;
+
+            // 1D transforms on this rank; the first stage is r2c
+            std::shared_ptr<heffte::fft3d_r2c<heffteBackend, long long>> r2c;
+            std::array<std::shared_ptr<heffte::fft3d<heffteBackend, long long>>, Dim> c2c;
+            workspace_t workspace;
+        };
+
+        /*!
+         * Sets up the stages of the pruned transforms for a region, unless they
+         * were set up for it already; this is collective
+         * @param region Global index region of the real field
+         */
+        void prune(const NDIndex<Dim>& region);
+
+        /*!
+         * Perform a pruned FFT (see Pruning)
+         * @param direction Forward or backward transformation
+         * @param f Real field whose transformation to compute
+         * @param gview View in which to store the transformation
+         * @param nghostg Number of ghost cells of the view
+         * @param region Global index region of the real field
+         * @param scale Factor by which the output is multiplied
+         */
+        template <typename ComplexView>
+        void prunedTransform(TransformDirection direction, RealField& f, const ComplexView& gview,
+                             int nghostg, const NDIndex<Dim>& region, Real_t scale);
+
+        template <typename T>
+        static pencil_view_type<T> pencils(const buffer_view_type<T>& data,
+                                           const NDIndex<Dim>& domain, int dim);
+
         typename Base::template temp_view_type<ComplexField> tempFieldComplex;
+
+        // contiguous buffer for batched transforms
+        typename Base::template temp_view_type<RealField> tempFieldBatch;
+
+        // global domains and the local domains of all ranks of the input and output
+        NDIndex<Dim> domainInput_m;
+        NDIndex<Dim> domainOutput_m;
+        std::vector<NDIndex<Dim>> lDomsInput_m;
+        std::vector<NDIndex<Dim>> lDomsOutput_m;
+
+        int r2cDirection_m;
+
+        std::unique_ptr<Pruning> pruning_m;
+
+        // buffers for the reshapes of the pruned transforms
+        detail::FieldBufferData<Real_t> fdReal_m;
+        detail::FieldBufferData<Complex_t> fdComplex_m;
     };
 
     /**
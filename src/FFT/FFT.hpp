@@ -15,6 +15,10 @@
    Implementations for FFT constructor/destructor and transforms
 */
 
+#include <algorithm>
+#include <limits>
+#include <typeinfo>
+
 #include "Utility/IpplTimings.h"
 
 #include "Field/BareField.h"
@@ -31,12 +35,29 @@ namespace ippl {
         const NDIndex<Dim> lDom = layout.getLocalNDIndex();
         domainToBounds(lDom, low, high);
 
-        heffte::box3d<long long> inbox  = {low, high};
-        heffte::box3d<long long> outbox = {low, high};
+        heffte::box3d<long long> inbox  = {low, high, boxOrder()};
+        heffte::box3d<long long> outbox = {low, high, boxOrder()};
 
         setup(inbox, outbox, params);
     }
 
+    template <typename Field, template <typename...> class FFT, typename Backend, typename T>
+    std::array<int, 3> FFTBase<Field, FFT, Backend, T>::boxOrder() {
+        using layout = typename Field::view_type::array_layout;
+        static_assert(std::is_same_v<layout, Kokkos::LayoutLeft>
+                          || std::is_same_v<layout, Kokkos::LayoutRight>,
+                      "heFFTe requires fields with layout left or layout right");
+
+        // unused dimensions of 2D transforms have length 1 and go last
+        if constexpr (std::is_same_v<layout, Kokkos::LayoutLeft>) {
+            return {0, 1, 2};
+        } else if constexpr (Dim == 3) {
+            return {2, 1, 0};
+        } else {
+            return {1, 0, 2};
+        }
+    }
+
     template <typename Field, template <typename...> class FFT, typename Backend, typename T>
     void FFTBase<Field, FFT, Backend, T>::domainToBounds(const NDIndex<Dim>& domain,
                                                          std::array<long long, 3>& low,
@@ -88,19 +109,140 @@ namespace ippl {
             }
         }
 
+        constexpr bool isR2C = !std::is_same_v<FFT<heffteBackend>, heffte::fft3d<heffteBackend>>;
+        const int r2cDirection = isR2C ? params.get<int>("r2c_direction") : -1;
+
+        if (params.get<bool>("heffte_autotune", false)) {
+            heffteOptions = autotune(inbox, outbox, r2cDirection, heffteOptions, params);
+        }
+
+        // the boxes of all ranks, so that the ranks only reuse plans of the same
+        // decomposition
+        std::array<long long, 12> bounds;
+        std::copy(inbox.low.begin(), inbox.low.end(), bounds.begin());
+        std::copy(inbox.high.begin(), inbox.high.end(), bounds.begin() + 3);
+        std::copy(outbox.low.begin(), outbox.low.end(), bounds.begin() + 6);
+        std::copy(outbox.high.begin(), outbox.high.end(), bounds.begin() + 9);
+
+        typename plan_cache::Key key{std::vector<long long>(bounds.size() * Comm->size()),
+                                     inbox.order,
+                                     outbox.order,
+                                     static_cast<int>(heffteOptions.algorithm),
+                                     heffteOptions.use_pencils,
+                                     heffteOptions.use_reorder,
+                                     heffteOptions.use_gpu_aware,
+                                     r2cDirection};
+        MPI_Allgather(bounds.data(), bounds.size(), MPI_LONG_LONG, key.boxes.data(),
+                      bounds.size(), MPI_LONG_LONG, Comm->getCommunicator());
+
+        // building a plan is collective, so a cached plan is only used if
+        // every rank has one
+        bool found = plan_cache::lookup(key, heffte_m, workspace_m);
+        bool all;
+        MPI_Allreduce(&found, &all, 1, MPI_C_BOOL, MPI_LAND, Comm->getCommunicator());
+        if (all) {
+            return;
+        }
+
+        heffte_m = makePlan(inbox, outbox, r2cDirection, heffteOptions);
+
+        // heffte::gpu::device_set(Comm->rank() % heffte::gpu::device_count());
+        workspace_m = std::make_shared<workspace_t>(heffte_m->size_workspace());
+
+        plan_cache::insert(key, heffte_m, workspace_m);
+    }
+
+    template <typename Field, template <typename...> class FFT, typename Backend, typename T>
+    std::shared_ptr<FFT<Backend, long long>> FFTBase<Field, FFT, Backend, T>::makePlan(
+        const heffte::box3d<long long>& inbox, const heffte::box3d<long long>& outbox,
+        int r2cDirection, const heffte::plan_options& options) {
         if constexpr (std::is_same_v<FFT<heffteBackend>, heffte::fft3d<heffteBackend>>) {
-            heffte_m = std::make_shared<FFT<heffteBackend, long long>>(
-                inbox, outbox, Comm->getCommunicator(), heffteOptions);
+            return std::make_shared<FFT<heffteBackend, long long>>(
+                inbox, outbox, Comm->getCommunicator(), options);
         } else {
-            heffte_m = std::make_shared<FFT<heffteBackend, long long>>(
-                inbox, outbox, params.get<int>("r2c_direction"), Comm->getCommunicator(),
-                heffteOptions);
+            return std::make_shared<FFT<heffteBackend, long long>>(
+                inbox, outbox, r2cDirection, Comm->getCommunicator(), options);
         }
+    }
 
-        // heffte::gpu::device_set(Comm->rank() % heffte::gpu::device_count());
-        if (workspace_m.size() < heffte_m->size_workspace()) {
-            workspace_m = workspace_t(heffte_m->size_workspace());
+    template <typename Field, template <typename...> class FFT, typename Backend, typename T>
+    heffte::plan_options FFTBase<Field, FFT, Backend, T>::autotune(
+        const heffte::box3d<long long>& inbox, const heffte::box3d<long long>& outbox,
+        int r2cDirection, heffte::plan_options options, const ParameterList& params) {
+        const std::string type = std::string(typeid(FFT<heffteBackend, long long>).name()) + "/"
+                                 + typeid(typename Field::value_type).name() + "/"
+                                 + typeid(T).name();
+        const std::string key  = detail::tuningKey(type, inbox, outbox, r2cDirection);
+        const std::string path =
+            params.get<std::string>("heffte_autotune_file", "ippl_heffte_tuning.txt");
+
+        auto& tuned = detail::tunedOptions();
+        if (auto it = tuned.find(key); it != tuned.end()) {
+            return it->second;
+        }
+        if (!path.empty() && detail::readTunedOptions(path, key, options)) {
+            tuned[key] = options;
+            return options;
         }
+
+        static IpplTimings::TimerRef tuneTimer = IpplTimings::getTimer("FFT: Autotune");
+        IpplTimings::startTimer(tuneTimer);
+
+        using input_t =
+            typename FFT<heffteBackend>::template buffer_container<typename Field::value_type>;
+        using output_t = typename FFT<heffteBackend>::template buffer_container<T>;
+
+        const int trials = params.get<int>("heffte_autotune_trials", 3);
+
+        heffte::plan_options best = options;
+        double bestTime           = std::numeric_limits<double>::max();
+        for (bool pencils : {true, false}) {
+            for (bool reorder : {true, false}) {
+                for (auto algorithm :
+                     {heffte::reshape_algorithm::alltoallv, heffte::reshape_algorithm::alltoall,
+                      heffte::reshape_algorithm::p2p, heffte::reshape_algorithm::p2p_plined}) {
+                    heffte::plan_options candidate = options;
+                    candidate.use_pencils          = pencils;
+                    candidate.use_reorder          = reorder;
+                    candidate.algorithm            = algorithm;
+
+                    auto plan = makePlan(inbox, outbox, r2cDirection, candidate);
+                    input_t input(plan->size_inbox());
+                    output_t output(plan->size_outbox());
+                    workspace_t workspace(plan->size_workspace());
+
+                    // the first pair of transforms is not timed
+                    double start = 0;
+                    for (int trial = -1; trial < trials; ++trial) {
+                        if (trial == 0) {
+                            Kokkos::fence();
+                            MPI_Barrier(Comm->getCommunicator());
+                            start = MPI_Wtime();
+                        }
+                        plan->forward(input.data(), output.data(), workspace.data());
+                        plan->backward(output.data(), input.data(), workspace.data());
+                    }
+                    Kokkos::fence();
+
+                    // the slowest rank determines the time of a transform
+                    double elapsed = MPI_Wtime() - start;
+                    MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX,
+                                  Comm->getCommunicator());
+                    if (elapsed < bestTime) {
+                        bestTime = elapsed;
+                        best     = candidate;
+                    }
+                }
+            }
+        }
+
+        IpplTimings::stopTimer(tuneTimer);
+
+        tuned[key] = best;
+        if (!path.empty()) {
+            detail::writeTunedOptions(path, key, best);
+        }
+        return best;
     }
 
     template <typename ComplexField>
@@ -111,41 +253,45 @@ namespace ippl {
         const int nghost = f.getNghost();
 
         /**
-         *This copy to a temporary Kokkos view is needed because of following
-         *reasons:
-         *1) heffte wants the input and output fields without ghost layers
-         *2) heffte accepts data in layout left (by default) eventhough this
-         *can be changed during heffte box creation
+         * heffte wants the fields without ghost layers. Its boxes follow the layout
+         * of the field views, so the transform runs directly on the field storage
+         * unless there are ghost cells; only then are the owned cells copied to a
+         * temporary view and back.
          */
+        const bool copy = nghost > 0;
         auto& tempField = this->tempField;
-        if (tempField.size() != f.getOwned().size()) {
-            tempField = detail::shrinkView("tempField", fview, nghost);
-        }
 
         using index_array_type = typename RangePolicy<Dim>::index_array_type;
-        ippl::parallel_for(
-            "copy from Kokkos FFT", getRangePolicy(fview, nghost),
-            KOKKOS_LAMBDA(const index_array_type& args) {
-                apply(tempField, args - nghost).real(apply(fview, args).real());
-                apply(tempField, args - nghost).imag(apply(fview, args).imag());
-            });
+        if (copy) {
+            if (tempField.size() != f.getOwned().size()) {
+                tempField = detail::shrinkView("tempField", fview, nghost);
+            }
+
+            ippl::parallel_for(
+                "copy from Kokkos FFT", getRangePolicy(fview, nghost),
+                KOKKOS_LAMBDA(const index_array_type& args) {
+                    apply(tempField, args - nghost).real(apply(fview, args).real());
+                    apply(tempField, args - nghost).imag(apply(fview, args).imag());
+                });
+        }
 
+        auto data = copy ? tempField.data() : fview.data();
         if (direction == FORWARD) {
-            this->heffte_m->forward(tempField.data(), tempField.data(), this->workspace_m.data(),
-                                    heffte::scale::full);
+            this->heffte_m->forward(data, data, this->workspace_m->data(), heffte::scale::full);
         } else if (direction == BACKWARD) {
-            this->heffte_m->backward(tempField.data(), tempField.data(), this->workspace_m.data(),
-                                     heffte::scale::none);
+            this->heffte_m->backward(data, data, this->workspace_m->data(), heffte::scale::none);
         } else {
             throw std::logic_error("Only 1:forward and -1:backward are allowed as directions");
         }
 
-        ippl::parallel_for(
-            "copy to Kokkos FFT", getRangePolicy(fview, nghost),
-            KOKKOS_LAMBDA(const index_array_type& args) {
-                apply(fview, args).real() = apply(tempField, args - nghost).real();
-                apply(fview, args).imag() = apply(tempField, args - nghost).imag();
-            });
+        if (copy) {
+            ippl::parallel_for(
+                "copy to Kokkos FFT", getRangePolicy(fview, nghost),
+                KOKKOS_LAMBDA(const index_array_type& args) {
+                    apply(fview, args).real() = apply(tempField, args - nghost).real();
+                    apply(fview, args).imag() = apply(tempField, args - nghost).imag();
+                });
+        }
     }
 
     //========================================================================
@@ -176,73 +322,504 @@ namespace ippl {
         this->domainToBounds(lDomInput, lowInput, highInput);
         this->domainToBounds(lDomOutput, lowOutput, highOutput);
 
-        heffte::box3d<long long> inbox  = {lowInput, highInput};
-        heffte::box3d<long long> outbox = {lowOutput, highOutput};
+        heffte::box3d<long long> inbox  = {lowInput, highInput, this->boxOrder()};
+        heffte::box3d<long long> outbox = {lowOutput, highOutput, this->boxOrder()};
 
         this->setup(inbox, outbox, params);
+
+        // the domains of all ranks for the pruned transforms
+        domainInput_m  = layoutInput.getDomain();
+        domainOutput_m = layoutOutput.getDomain();
+        for (int rank = 0; rank < Comm->size(); ++rank) {
+            lDomsInput_m.push_back(layoutInput.getLocalNDIndex(rank));
+            lDomsOutput_m.push_back(layoutOutput.getLocalNDIndex(rank));
+        }
+        r2cDirection_m = params.get<int>("r2c_direction");
     }
 
     template <typename RealField>
     void FFT<RCTransform, RealField>::transform(TransformDirection direction, RealField& f,
                                                 ComplexField& g) {
+        transform(direction, f, g, f.getDomain());
+    }
+
+    template <typename RealField>
+    void FFT<RCTransform, RealField>::transform(TransformDirection direction, RealField& f,
+                                                ComplexField& g, const NDIndex<Dim>& region,
+                                                Real_t scale) {
         static_assert(Dim == 2 || Dim == 3, "heFFTe only supports 2D and 3D");
 
+        if (!region.contains(f.getDomain())) {
+            prunedTransform(direction, f, g.getView(), g.getNghost(), region, scale);
+            return;
+        }
+
         auto fview        = f.getView();
         auto gview        = g.getView();
         const int nghostf = f.getNghost();
         const int nghostg = g.getNghost();
 
         /**
-         *This copy to a temporary Kokkos view is needed because of following
-         *reasons:
-         *1) heffte wants the input and output fields without ghost layers
-         *2) heffte accepts data in layout left (by default) eventhough this
-         *can be changed during heffte box creation
+         * heffte wants the fields without ghost layers. Its boxes follow the layout
+         * of the field views, so it works directly on the storage of a field without
+         * ghost cells. A copy to a temporary view is only needed for fields with
+         * ghost cells.
          */
+        const bool copyf = nghostf > 0;
+        const bool copyg = nghostg > 0;
+
         auto& tempFieldf = this->tempField;
         auto& tempFieldg = this->tempFieldComplex;
-        if (tempFieldf.size() != f.getOwned().size()) {
+        if (copyf && tempFieldf.size() != f.getOwned().size()) {
             tempFieldf = detail::shrinkView("tempFieldf", fview, nghostf);
         }
-        if (tempFieldg.size() != g.getOwned().size()) {
+        if (copyg && tempFieldg.size() != g.getOwned().size()) {
             tempFieldg = detail::shrinkView("tempFieldg", gview, nghostg);
         }
 
+        auto dataf = copyf ? tempFieldf.data() : fview.data();
+        auto datag = copyg ? tempFieldg.data() : gview.data();
+
+        // The input of heffte is left untouched, so only the input needs to be
+        // copied before and only the output after the transform
+        using index_array_type = typename RangePolicy<Dim>::index_array_type;
+        if (direction == FORWARD) {
+            if (copyf) {
+                ippl::parallel_for(
+                    "copy from Kokkos f field in FFT", getRangePolicy(fview, nghostf),
+                    KOKKOS_LAMBDA(const index_array_type& args) {
+                        apply(tempFieldf, args - nghostf) = apply(fview, args);
+                    });
+            }
+
+            this->heffte_m->forward(dataf, datag, this->workspace_m->data(), heffte::scale::full);
+
+            if (copyg) {
+                ippl::parallel_for(
+                    "copy to Kokkos g field FFT", getRangePolicy(gview, nghostg),
+                    KOKKOS_LAMBDA(const index_array_type& args) {
+                        apply(gview, args).real() =
+                            scale * apply(tempFieldg, args - nghostg).real();
+                        apply(gview, args).imag() =
+                            scale * apply(tempFieldg, args - nghostg).imag();
+                    });
+            } else if (scale != 1) {
+                ippl::parallel_for(
+                    "scale Kokkos g field FFT", getRangePolicy(gview),
+                    KOKKOS_LAMBDA(const index_array_type& args) {
+                        apply(gview, args) *= scale;
+                    });
+            }
+        } else if (direction == BACKWARD) {
+            if (copyg) {
+                ippl::parallel_for(
+                    "copy from Kokkos g field in FFT", getRangePolicy(gview, nghostg),
+                    KOKKOS_LAMBDA(const index_array_type& args) {
+                        apply(tempFieldg, args - nghostg).real(apply(gview, args).real());
+                        apply(tempFieldg, args - nghostg).imag(apply(gview, args).imag());
+                    });
+            }
+
+            this->heffte_m->backward(datag, dataf, this->workspace_m->data(), heffte::scale::none);
+
+            if (copyf) {
+                ippl::parallel_for(
+                    "copy to Kokkos f field FFT", getRangePolicy(fview, nghostf),
+                    KOKKOS_LAMBDA(const index_array_type& args) {
+                        apply(fview, args) = scale * apply(tempFieldf, args - nghostf);
+                    });
+            } else if (scale != 1) {
+                ippl::parallel_for(
+                    "scale Kokkos f field FFT", getRangePolicy(fview),
+                    KOKKOS_LAMBDA(const index_array_type& args) {
+                        apply(fview, args) *= scale;
+                    });
+            }
+        } else {
+            throw std::logic_error("Only 1:forward and -1:backward are allowed as directions");
+        }
+    }
+
+    template <typename RealField>
+    void FFT<RCTransform, RealField>::transform(TransformDirection direction,
+                                                const std::vector<RealField*>& f,
+                                                batch_view_type& g) {
+        if (!f.empty()) {
+            transform(direction, f, g, f[0]->getDomain());
+        }
+    }
+
+    template <typename RealField>
+    void FFT<RCTransform, RealField>::transform(TransformDirection direction,
+                                                const std::vector<RealField*>& f,
+                                                batch_view_type& g, const NDIndex<Dim>& region,
+                                                Real_t scale) {
+        static_assert(Dim == 2 || Dim == 3, "heFFTe only supports 2D and 3D");
+
+        const size_t batch = f.size();
+        if (batch == 0) {
+            return;
+        }
+        if (g.size() != batch * this->heffte_m->size_outbox()) {
+            throw IpplException("FFT::transform",
+                                "The batch view does not hold one transform per field");
+        }
+
+        const int nghostf = f[0]->getNghost();
+
+        // the real fields are stored one after the other like the transforms
+        auto& tempFieldf      = this->tempFieldBatch;
+        constexpr unsigned bd = detail::batchDimension<std::decay_t<decltype(tempFieldf)>>();
+
+        // the pruned transforms write to the part of the batch that holds each field
+        if (!region.contains(f[0]->getDomain())) {
+            const size_t length = g.extent(bd) / batch;
+            for (size_t b = 0; b < batch; ++b) {
+                const std::pair<size_t, size_t> range(b * length, (b + 1) * length);
+                auto gb = [&]() {
+                    if constexpr (bd == 0 && Dim == 2) {
+                        return Kokkos::subview(g, range, Kokkos::ALL);
+                    } else if constexpr (bd == 0) {
+                        return Kokkos::subview(g, range, Kokkos::ALL, Kokkos::ALL);
+                    } else if constexpr (Dim == 2) {
+                        return Kokkos::subview(g, Kokkos::ALL, range);
+                    } else {
+                        return Kokkos::subview(g, Kokkos::ALL, Kokkos::ALL, range);
+                    }
+                }();
+                prunedTransform(direction, *f[b], gb, 0, region, scale);
+            }
+            return;
+        }
+
+        if (tempFieldf.size() != batch * f[0]->getOwned().size()) {
+            tempFieldf = detail::batchedShrinkView<std::decay_t<decltype(tempFieldf)>>(
+                "tempFieldBatchf", f[0]->getView(), nghostf, batch);
+        }
+
+        const size_t batchSize = batch * this->heffte_m->size_workspace();
+        if (this->workspace_m->size() < batchSize) {
+            // resized in place, as the workspace may be shared with other FFTs
+            *this->workspace_m = workspace_t(batchSize);
+        }
+
+        using index_array_type = typename RangePolicy<Dim>::index_array_type;
+        if (direction == FORWARD) {
+            for (size_t b = 0; b < batch; ++b) {
+                auto fview         = f[b]->getView();
+                const size_t shift = b * (fview.extent(bd) - 2 * nghostf);
+                ippl::parallel_for(
+                    "copy from Kokkos f fields in batched FFT", getRangePolicy(fview, nghostf),
+                    KOKKOS_LAMBDA(const index_array_type& args) {
+                        index_array_type idx = args - nghostf;
+                        idx[bd] += shift;
+                        apply(tempFieldf, idx) = apply(fview, args);
+                    });
+            }
+
+            this->heffte_m->forward(batch, tempFieldf.data(), g.data(), this->workspace_m->data(),
+                                    heffte::scale::full);
+
+            if (scale != 1) {
+                ippl::parallel_for(
+                    "scale batched FFT", getRangePolicy(g),
+                    KOKKOS_LAMBDA(const index_array_type& args) {
+                        apply(g, args) *= scale;
+                    });
+            }
+        } else if (direction == BACKWARD) {
+            this->heffte_m->backward(batch, g.data(), tempFieldf.data(), this->workspace_m->data(),
+                                     heffte::scale::none);
+
+            for (size_t b = 0; b < batch; ++b) {
+                auto fview         = f[b]->getView();
+                const size_t shift = b * (fview.extent(bd) - 2 * nghostf);
+                ippl::parallel_for(
+                    "copy to Kokkos f fields batched FFT", getRangePolicy(fview, nghostf),
+                    KOKKOS_LAMBDA(const index_array_type& args) {
+                        index_array_type idx = args - nghostf;
+                        idx[bd] += shift;
+                        apply(fview, args) = scale * apply(tempFieldf, idx);
+                    });
+            }
+        } else {
+            throw std::logic_error("Only 1:forward and -1:backward are allowed as directions");
+        }
+    }
+
+    template <typename RealField>
+    template <typename VectorField>
+    void FFT<RCTransform, RealField>::transform(TransformDirection direction, VectorField& f,
+                                                batch_view_type& g) {
+        static_assert(Dim == 2 || Dim == 3, "heFFTe only supports 2D and 3D");
+
+        constexpr size_t batch = VectorField::value_type::dim;
+        if (g.size() != batch * this->heffte_m->size_outbox()) {
+            throw IpplException("FFT::transform",
+                                "The batch view does not hold one transform per component");
+        }
+
+        auto fview        = f.getView();
+        const int nghostf = f.getNghost();
+
+        // The transforms are stored one after the other along the slowest running
+        // dimension of the buffer, as heffte expects for batches. Unlike scalar
+        // transforms, they cannot run on the field storage, which interleaves the
+        // vector components
+        auto& tempFieldf = this->tempFieldBatch;
+        if (tempFieldf.size() != batch * f.getOwned().size()) {
+            tempFieldf = detail::batchedShrinkView<std::decay_t<decltype(tempFieldf)>>(
+                "tempFieldBatchf", fview, nghostf, batch);
+        }
+
+        const size_t batchSize = batch * this->heffte_m->size_workspace();
+        if (this->workspace_m->size() < batchSize) {
+            // resized in place, as the workspace may be shared with other FFTs
+            *this->workspace_m = workspace_t(batchSize);
+        }
+
         using index_array_type = typename RangePolicy<Dim>::index_array_type;
-        ippl::parallel_for(
-            "copy from Kokkos f field in FFT", getRangePolicy(fview, nghostf),
-            KOKKOS_LAMBDA(const index_array_type& args) {
-                apply(tempFieldf, args - nghostf) = apply(fview, args);
-            });
-        ippl::parallel_for(
-            "copy from Kokkos g field in FFT", getRangePolicy(gview, nghostg),
-            KOKKOS_LAMBDA(const index_array_type& args) {
-                apply(tempFieldg, args - nghostg).real(apply(gview, args).real());
-                apply(tempFieldg, args - nghostg).imag(apply(gview, args).imag());
-            });
+        constexpr unsigned bd  = detail::batchDimension<std::decay_t<decltype(tempFieldf)>>();
+        const size_t lastf     = fview.extent(bd) - 2 * nghostf;
 
         if (direction == FORWARD) {
-            this->heffte_m->forward(tempFieldf.data(), tempFieldg.data(), this->workspace_m.data(),
+            ippl::parallel_for(
+                "copy from Kokkos f field in batched FFT", getRangePolicy(fview, nghostf),
+                KOKKOS_LAMBDA(const index_array_type& args) {
+                    index_array_type idx = args - nghostf;
+                    for (size_t b = 0; b < batch; ++b) {
+                        apply(tempFieldf, idx) = apply(fview, args)[b];
+                        idx[bd] += lastf;
+                    }
+                });
+
+            this->heffte_m->forward(batch, tempFieldf.data(), g.data(), this->workspace_m->data(),
                                     heffte::scale::full);
         } else if (direction == BACKWARD) {
-            this->heffte_m->backward(tempFieldg.data(), tempFieldf.data(), this->workspace_m.data(),
+            this->heffte_m->backward(batch, g.data(), tempFieldf.data(), this->workspace_m->data(),
                                      heffte::scale::none);
+
+            ippl::parallel_for(
+                "copy to Kokkos f field batched FFT", getRangePolicy(fview, nghostf),
+                KOKKOS_LAMBDA(const index_array_type& args) {
+                    index_array_type idx = args - nghostf;
+                    for (size_t b = 0; b < batch; ++b) {
+                        apply(fview, args)[b] = apply(tempFieldf, idx);
+                        idx[bd] += lastf;
+                    }
+                });
         } else {
             throw std::logic_error("Only 1:forward and -1:backward are allowed as directions");
         }
+    }
+
+    template <typename RealField>
+    void FFT<RCTransform, RealField>::prune(const NDIndex<Dim>& region) {
+        if (pruning_m && pruning_m->region.contains(region) && region.contains(pruning_m->region)) {
+            return;
+        }
+
+        pruning_m        = std::make_unique<Pruning>();
+        Pruning& pruning = *pruning_m;
+        pruning.region   = region;
+
+        // the r2c dimension goes first, then the others in ascending order
+        pruning.dims[0] = r2cDirection_m;
+        for (unsigned d = 0, s = 1; d < Dim; ++d) {
+            if ((int)d != r2cDirection_m) {
+                pruning.dims[s++] = d;
+            }
+        }
 
-        ippl::parallel_for(
-            "copy to Kokkos f field FFT", getRangePolicy(fview, nghostf),
-            KOKKOS_LAMBDA(const index_array_type& args) {
-                apply(fview, args) = apply(tempFieldf, args - nghostf);
-            });
+        const int ranks = Comm->size();
+        const int rank  = Comm->rank();
 
-        ippl::parallel_for(
-            "copy to Kokkos g field FFT", getRangePolicy(gview, nghostg),
-            KOKKOS_LAMBDA(const index_array_type& args) {
-                apply(gview, args).real() = apply(tempFieldg, args - nghostg).real();
-                apply(gview, args).imag() = apply(tempFieldg, args - nghostg).imag();
-            });
+        // A stage spans the whole transform in the dimensions that it and the
+        // stages before it transform, and the region in the others. Its pencils
+        // are not split in the dimension that it transforms.
+        detail::Partitioner<Dim> partitioner;
+        Kokkos::View<NDIndex<Dim>*, Kokkos::HostSpace> split("pencil domains", ranks);
+
+        std::array<std::vector<NDIndex<Dim>>, Dim> domains;
+        NDIndex<Dim> domain = region;
+        for (unsigned s = 0; s < Dim; ++s) {
+            const int t = pruning.dims[s];
+            domain[t]   = domainOutput_m[t];
+
+            e_dim_tag decomp[Dim];
+            for (unsigned d = 0; d < Dim; ++d) {
+                decomp[d] = ((int)d == t) ? SERIAL : PARALLEL;
+            }
+            partitioner.split(domain, split, decomp, ranks);
+
+            domains[s].assign(split.data(), split.data() + ranks);
+            pruning.domains[s] = domains[s][rank];
+        }
+
+        // the real pencils of the first stage span the real extent of the r2c dimension
+        std::vector<NDIndex<Dim>> realDomains = domains[0];
+        for (auto& realDomain : realDomains) {
+            realDomain[r2cDirection_m] = domainInput_m[r2cDirection_m];
+        }
+        pruning.realDomain = realDomains[rank];
+
+        // Only the region is taken from the input. Between the stages, the blocks
+        // are restricted to the region by the domains of the stages themselves.
+        pruning.plans[0] = detail::makeCommPlan(lDomsInput_m, realDomains, region);
+        for (unsigned s = 1; s < Dim; ++s) {
+            pruning.plans[s] = detail::makeCommPlan(domains[s - 1], domains[s], domainOutput_m);
+        }
+        pruning.plans[Dim] = detail::makeCommPlan(domains[Dim - 1], lDomsOutput_m, domainOutput_m);
+
+        // The 1D transforms of a stage are a batch of transforms on this rank,
+        // one per pencil, which are stored one after the other
+        heffte::plan_options options = heffte::default_options<heffteBackend>();
+        size_t workspaceSize         = 0;
+
+        pruning.real = buffer_view_type<Real_t>("pruned FFT real", pruning.realDomain.size());
+        for (unsigned s = 0; s < Dim; ++s) {
+            const int t         = pruning.dims[s];
+            const long long n   = (s == 0) ? pruning.realDomain[t].length()
+                                           : pruning.domains[s][t].length();
+            const size_t batch  = pruning.domains[s].size() / pruning.domains[s][t].length();
+            const size_t length = pruning.domains[s].size();
+
+            pruning.complex[s] = buffer_view_type<Complex_t>("pruned FFT complex", length);
+
+            heffte::box3d<long long> box = {{0, 0, 0}, {n - 1, 0, 0}, {0, 1, 2}};
+            if (s == 0) {
+                heffte::box3d<long long> boxComplex = {{0, 0, 0}, {n / 2, 0, 0}, {0, 1, 2}};
+                pruning.r2c = std::make_shared<heffte::fft3d_r2c<heffteBackend, long long>>(
+                    box, boxComplex, 0, MPI_COMM_SELF, options);
+                workspaceSize = std::max(workspaceSize, batch * pruning.r2c->size_workspace());
+            } else {
+                pruning.c2c[s] = std::make_shared<heffte::fft3d<heffteBackend, long long>>(
+                    box, box, MPI_COMM_SELF, options);
+                workspaceSize = std::max(workspaceSize, batch * pruning.c2c[s]->size_workspace());
+            }
+        }
+        pruning.workspace = workspace_t(workspaceSize);
+    }
+
+    template <typename RealField>
+    template <typename ComplexView>
+    void FFT<RCTransform, RealField>::prunedTransform(TransformDirection direction, RealField& f,
+                                                      const ComplexView& gview, int nghostg,
+                                                      const NDIndex<Dim>& region, Real_t scale) {
+        prune(region);
+        Pruning& pruning = *pruning_m;
+
+        auto fview         = f.getView();
+        const int nghostf  = f.getNghost();
+        const int rank     = Comm->rank();
+        const auto& lDomf  = lDomsInput_m[rank];
+        const auto& lDomg  = lDomsOutput_m[rank];
+        const auto& dims   = pruning.dims;
+        const auto& lDoms  = pruning.domains;
+        auto& complexStage = pruning.complex;
+
+        auto real = pencils(pruning.real, pruning.realDomain, dims[0]);
+        std::array<pencil_view_type<Complex_t>, Dim> complex;
+        std::array<int, Dim> batch;
+        for (unsigned s = 0; s < Dim; ++s) {
+            complex[s] = pencils(complexStage[s], lDoms[s], dims[s]);
+            batch[s]   = lDoms[s].size() / lDoms[s][dims[s]].length();
+        }
+
+        // copies the blocks of a plan from one view to another, or those of the
+        // reversed plan for backward transforms
+        auto reshape = [&](const detail::CommPlan<Dim>& plan, const auto& src, int nghostSrc,
+                           const NDIndex<Dim>& lDomSrc, auto& fd, const auto& dst,
+                           int nghostDst, const NDIndex<Dim>& lDomDst) {
+            const bool forward = (direction == FORWARD);
+            detail::exchange(forward ? plan.sends : plan.recvs, forward ? plan.recvs : plan.sends,
+                             src, nghostSrc, lDomSrc, fd, FFT_PRUNED_TAG, IPPL_FFT_SEND,
+                             IPPL_FFT_RECV, [&](const auto& block) {
+                                 detail::unpack(block.domain, dst, fd, nghostDst, lDomDst);
+                             });
+        };
+
+        auto rescale = [](const buffer_view_type<Complex_t>& data, Real_t factor) {
+            Kokkos::parallel_for(
+                "scale pruned FFT", Kokkos::RangePolicy<execution_space>(0, data.size()),
+                KOKKOS_LAMBDA(const size_t i) { data(i) *= factor; });
+        };
+
+        auto workspace = pruning.workspace.data();
+        if (direction == FORWARD) {
+            // the pencils are zero outside of the region
+            Kokkos::deep_copy(pruning.real, Real_t(0));
+            reshape(pruning.plans[0], fview, nghostf, lDomf, fdReal_m, real, 0,
+                    pruning.realDomain);
+
+            if (batch[0] > 0) {
+                pruning.r2c->forward(batch[0], pruning.real.data(), complexStage[0].data(),
+                                     workspace, heffte::scale::none);
+            }
+
+            for (unsigned s = 1; s < Dim; ++s) {
+                Kokkos::deep_copy(complexStage[s], Complex_t(0));
+                reshape(pruning.plans[s], complex[s - 1], 0, lDoms[s - 1], fdComplex_m,
+                        complex[s], 0, lDoms[s]);
+
+                if (batch[s] > 0) {
+                    auto data = complexStage[s].data();
+                    pruning.c2c[s]->forward(batch[s], data, data, workspace, heffte::scale::none);
+                }
+            }
+
+            // normalized by the number of points like the full transform
+            rescale(complexStage[Dim - 1], scale / domainInput_m.size());
+            reshape(pruning.plans[Dim], complex[Dim - 1], 0, lDoms[Dim - 1], fdComplex_m, gview,
+                    nghostg, lDomg);
+        } else if (direction == BACKWARD) {
+            reshape(pruning.plans[Dim], gview, nghostg, lDomg, fdComplex_m, complex[Dim - 1], 0,
+                    lDoms[Dim - 1]);
+
+            // only the part of each stage inside of the region is kept
+            for (unsigned s = Dim - 1; s > 0; --s) {
+                if (batch[s] > 0) {
+                    auto data = complexStage[s].data();
+                    pruning.c2c[s]->backward(batch[s], data, data, workspace, heffte::scale::none);
+                }
+
+                reshape(pruning.plans[s], complex[s], 0, lDoms[s], fdComplex_m, complex[s - 1],
+                        0, lDoms[s - 1]);
+            }
+
+            if (scale != 1) {
+                rescale(complexStage[0], scale);
+            }
+            if (batch[0] > 0) {
+                pruning.r2c->backward(batch[0], complexStage[0].data(), pruning.real.data(),
+                                      workspace, heffte::scale::none);
+            }
+
+            reshape(pruning.plans[0], real, 0, pruning.realDomain, fdReal_m, fview, nghostf,
+                    lDomf);
+        } else {
+            throw std::logic_error("Only 1:forward and -1:backward are allowed as directions");
+        }
+    }
+
+    template <typename RealField>
+    template <typename T>
+    typename FFT<RCTransform, RealField>::template pencil_view_type<T>
+    FFT<RCTransform, RealField>::pencils(const buffer_view_type<T>& data,
+                                         const NDIndex<Dim>& domain, int dim) {
+        // the transform dimension runs fastest, then the others in ascending order
+        Kokkos::LayoutStride layout;
+        size_t stride         = domain[dim].length();
+        layout.dimension[dim] = domain[dim].length();
+        layout.stride[dim]    = 1;
+        for (unsigned d = 0; d < Dim; ++d) {
+            if ((int)d != dim) {
+                layout.dimension[d] = domain[d].length();
+                layout.stride[d]    = stride;
+                stride *= domain[d].length();
+            }
+        }
+        return pencil_view_type<T>(data.data(), layout);
     }
 
     template <typename Field>
@@ -253,39 +830,43 @@ namespace ippl {
         const int nghost = f.getNghost();
 
         /**
-         *This copy to a temporary Kokkos view is needed because of following
-         *reasons:
-         *1) heffte wants the input and output fields without ghost layers
-         *2) heffte accepts data in layout left (by default) eventhough this
-         *can be changed during heffte box creation
+         * heffte wants the fields without ghost layers. Its boxes follow the layout
+         * of the field views, so the transform runs directly on the field storage
+         * unless there are ghost cells; only then are the owned cells copied to a
+         * temporary view and back.
          */
+        const bool copy = nghost > 0;
         auto& tempField = this->tempField;
-        if (tempField.size() != f.getOwned().size()) {
-            tempField = detail::shrinkView("tempField", fview, nghost);
-        }
 
         using index_array_type = typename RangePolicy<Dim>::index_array_type;
-        ippl::parallel_for(
-            "copy from Kokkos FFT", getRangePolicy(fview, nghost),
-            KOKKOS_LAMBDA(const index_array_type& args) {
-                apply(tempField, args - nghost) = apply(fview, args);
-            });
+        if (copy) {
+            if (tempField.size() != f.getOwned().size()) {
+                tempField = detail::shrinkView("tempField", fview, nghost);
+            }
+
+            ippl::parallel_for(
+                "copy from Kokkos FFT", getRangePolicy(fview, nghost),
+                KOKKOS_LAMBDA(const index_array_type& args) {
+                    apply(tempField, args - nghost) = apply(fview, args);
+                });
+        }
 
+        auto data = copy ? tempField.data() : fview.data();
         if (direction == FORWARD) {
-            this->heffte_m->forward(tempField.data(), tempField.data(), this->workspace_m.data(),
-                                    heffte::scale::full);
+            this->heffte_m->forward(data, data, this->workspace_m->data(), heffte::scale::full);
         } else if (direction == BACKWARD) {
-            this->heffte_m->backward(tempField.data(), tempField.data(), this->workspace_m.data(),
-                                     heffte::scale::none);
+            this->heffte_m->backward(data, data, this->workspace_m->data(), heffte::scale::none);
         } else {
             throw std::logic_error("Only 1:forward and -1:backward are allowed as directions");
         }
 
-        ippl::parallel_for(
-            "copy to Kokkos FFT", getRangePolicy(fview, nghost),
-            KOKKOS_LAMBDA(const index_array_type& args) {
-                apply(fview, args) = apply(tempField, args - nghost);
-            });
+        if (copy) {
+            ippl::parallel_for(
+                "copy to Kokkos FFT", getRangePolicy(fview, nghost),
+                KOKKOS_LAMBDA(const index_array_type& args) {
+                    apply(fview, args) = apply(tempField, args - nghost);
+                });
+        }
     }
 
     template <typename Field>
@@ -296,39 +877,43 @@ namespace ippl {
         const int nghost = f.getNghost();
 
         /**
-         *This copy to a temporary Kokkos view is needed because of following
-         *reasons:
-         *1) heffte wants the input and output fields without ghost layers
-         *2) heffte accepts data in layout left (by default) eventhough this
-         *can be changed during heffte box creation
+         * heffte wants the fields without ghost layers. Its boxes follow the layout
+         * of the field views, so the transform runs directly on the field storage
+         * unless there are ghost cells; only then are the owned cells copied to a
+         * temporary view and back.
          */
+        const bool copy = nghost > 0;
         auto& tempField = this->tempField;
-        if (tempField.size() != f.getOwned().size()) {
-            tempField = detail::shrinkView("tempField", fview, nghost);
-        }
 
         using index_array_type = typename RangePolicy<Dim>::index_array_type;
-        ippl::parallel_for(
-            "copy from Kokkos FFT", getRangePolicy(fview, nghost),
-            KOKKOS_LAMBDA(const index_array_type& args) {
-                apply(tempField, args - nghost) = apply(fview, args);
-            });
+        if (copy) {
+            if (tempField.size() != f.getOwned().size()) {
+                tempField = detail::shrinkView("tempField", fview, nghost);
+            }
 
+            ippl::parallel_for(
+                "copy from Kokkos FFT", getRangePolicy(fview, nghost),
+                KOKKOS_LAMBDA(const index_array_type& args) {
+                    apply(tempField, args - nghost) = apply(fview, args);
+                });
+        }
+
+        auto data = copy ? tempField.data() : fview.data();
         if (direction == FORWARD) {
-            this->heffte_m->forward(tempField.data(), tempField.data(), this->workspace_m.data(),
-                                    heffte::scale::full);
+            this->heffte_m->forward(data, data, this->workspace_m->data(), heffte::scale::full);
         } else if (direction == BACKWARD) {
-            this->heffte_m->backward(tempField.data(), tempField.data(), this->workspace_m.data(),
-                                     heffte::scale::none);
+            this->heffte_m->backward(data, data, this->workspace_m->data(), heffte::scale::none);
         } else {
             throw std::logic_error("Only 1:forward and -1:backward are allowed as directions");
         }
 
-        ippl::parallel_for(
-            "copy to Kokkos FFT", getRangePolicy(fview, nghost),
-            KOKKOS_LAMBDA(const index_array_type& args) {
-                apply(fview, args) = apply(tempField, args - nghost);
-            });
+        if (copy) {
+            ippl::parallel_for(
+                "copy to Kokkos FFT", getRangePolicy(fview, nghost),
+                KOKKOS_LAMBDA(const index_array_type& args) {
+                    apply(fview, args) = apply(tempField, args - nghost);
+                });
+        }
     }
 }  // namespace ippl
 
@@ -0,0 +1,118 @@
+//
+// FFT autotuning
+//   Helpers for FFTBase's opt-in autotuning of the heffte options (pencils,
+//   reorder and the communication algorithm). The tuned options are remembered
+//   for the rest of the run and in a small text file, one line per setup, so
+//   that later runs with the same transform type, global boxes and number of
+//   ranks skip the search. Rank 0 reads and writes the file; the options are
+//   broadcast to the other ranks.
+//
+
+#ifndef IPPL_FFT_AUTOTUNE_H
+#define IPPL_FFT_AUTOTUNE_H
+
+#include <array>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+
+#include <heffte_fft3d.h>
+
+#include "Communicate/Communicate.h"
+
+namespace ippl {
+    namespace detail {
+        /*!
+         * Tuned options found so far in this run, by tuning key
+         */
+        inline std::map<std::string, heffte::plan_options>& tunedOptions() {
+            static std::map<std::string, heffte::plan_options> options;
+            return options;
+        }
+
+        /*!
+         * Builds the key under which the tuned options of a setup are stored;
+         * it contains no whitespace
+         * @param type identifies the transform type and precision
+         * @param inbox the local input box of this rank
+         * @param outbox the local output box of this rank
+         * @param r2cDirection the r2c dimension, or -1 for other transforms
+         * @return The key, which is the same on all ranks
+         */
+        inline std::string tuningKey(const std::string& type,
+                                     const heffte::box3d<long long>& inbox,
+                                     const heffte::box3d<long long>& outbox, int r2cDirection) {
+            std::array<long long, 6> low, high;
+            for (unsigned d = 0; d < 3; ++d) {
+                low[d]      = inbox.low[d];
+                low[d + 3]  = outbox.low[d];
+                high[d]     = inbox.high[d];
+                high[d + 3] = outbox.high[d];
+            }
+            MPI_Allreduce(MPI_IN_PLACE, low.data(), 6, MPI_LONG_LONG, MPI_MIN,
+                          Comm->getCommunicator());
+            MPI_Allreduce(MPI_IN_PLACE, high.data(), 6, MPI_LONG_LONG, MPI_MAX,
+                          Comm->getCommunicator());
+
+            std::ostringstream key;
+            key << type << ":ranks=" << Comm->size() << ":r2c=" << r2cDirection << ":grid";
+            for (unsigned i = 0; i < 6; ++i) {
+                key << (i == 0 ? "=" : ",") << low[i] << ".." << high[i];
+            }
+            return key.str();
+        }
+
+        /*!
+         * Reads tuned options from a tuning file; the last matching line wins
+         * @param path the file path
+         * @param key the tuning key
+         * @param options set to the stored options if the key is found; only
+         * the tuned fields are changed
+         * @return Whether the key was found
+         */
+        inline bool readTunedOptions(const std::string& path, const std::string& key,
+                                     heffte::plan_options& options) {
+            // found, pencils, reorder, algorithm
+            std::array<int, 4> stored = {0, 0, 0, 0};
+            if (Comm->rank() == 0) {
+                std::ifstream file(path);
+                std::string line;
+                while (std::getline(file, line)) {
+                    std::istringstream fields(line);
+                    std::string lineKey;
+                    int pencils, reorder, algorithm;
+                    if (fields >> lineKey >> pencils >> reorder >> algorithm && lineKey == key) {
+                        stored = {1, pencils, reorder, algorithm};
+                    }
+                }
+            }
+            MPI_Bcast(stored.data(), 4, MPI_INT, 0, Comm->getCommunicator());
+
+            if (stored[0] == 0) {
+                return false;
+            }
+            options.use_pencils = stored[1];
+            options.use_reorder = stored[2];
+            options.algorithm   = static_cast<heffte::reshape_algorithm>(stored[3]);
+            return true;
+        }
+
+        /*!
+         * Appends tuned options to a tuning file
+         * @param path the file path
+         * @param key the tuning key
+         * @param options the tuned options
+         */
+        inline void writeTunedOptions(const std::string& path, const std::string& key,
+                                      const heffte::plan_options& options) {
+            if (Comm->rank() == 0) {
+                std::ofstream file(path, std::ios::app);
+                file << key << " " << options.use_pencils << " " << options.use_reorder << " "
+                     << static_cast<int>(options.algorithm) << "\n";
+            }
+        }
+    }  // namespace detail
+}  // namespace ippl
+
+#endif
@@ -0,0 +1,96 @@
+//
+// Class FFTPlanCache
+//   Process-wide cache of heffte plans and their workspaces, shared by all FFT
+//   objects of the same plan type. Building a plan sets up the reshape
+//   communication patterns of the distributed transform, which is expensive,
+//   so FFTs for the same boxes and options, such as those of solvers sharing a
+//   layout or of a solver whose layout returns to a previous decomposition after
+//   load balancing, reuse the cached plan. The workspace is shared along with the
+//   plan; FFTs that share a plan must not transform concurrently.
+//
+//   Plans are built collectively, so the ranks have to agree on whether to reuse
+//   one: the keys hold the boxes of all ranks, and FFTBase::setup only uses
+//   cached plans if all ranks find the key.
+//   The least recently used entries are evicted once the capacity is exceeded.
+//
+
+#ifndef IPPL_FFT_PLAN_CACHE_H
+#define IPPL_FFT_PLAN_CACHE_H
+
+#include <array>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace ippl {
+
+    template <typename Plan, typename Workspace>
+    class FFTPlanCache {
+    public:
+        /*!
+         * Identifies a plan by the decomposition of all ranks, so that the key is
+         * the same on every rank and a cached plan of one rank always belongs to
+         * the same heffte plan as those of the other ranks
+         */
+        struct Key {
+            // the bounds of the input and output boxes, rank after rank
+            std::vector<long long> boxes;
+            std::array<int, 3> inOrder, outOrder;
+            int algorithm;
+            bool pencils, reorder, gpuAware;
+            int r2cDirection;
+
+            bool operator<(const Key& other) const;
+        };
+
+        /*!
+         * Retrieves a cached plan and its workspace
+         * @param key the key
+         * @param plan set to the cached plan if the key is found
+         * @param workspace set to the cached workspace if the key is found
+         * @return Whether the key was found
+         */
+        static bool lookup(const Key& key, std::shared_ptr<Plan>& plan,
+                           std::shared_ptr<Workspace>& workspace);
+
+        /*!
+         * Adds a plan and its workspace to the cache
+         * @param key the key
+         * @param plan the plan
+         * @param workspace the workspace
+         */
+        static void insert(const Key& key, const std::shared_ptr<Plan>& plan,
+                           const std::shared_ptr<Workspace>& workspace);
+
+        /*!
+         * Sets the maximum number of cached plans
+         * @param capacity the capacity; 0 disables caching
+         */
+        static void setCapacity(size_t capacity);
+
+        static size_t size() { return entries().size(); }
+
+        /*!
+         * Removes all cached plans; FFT objects keep the plans they use
+         */
+        static void clear() { entries().clear(); }
+
+    private:
+        struct Entry {
+            std::shared_ptr<Plan> plan;
+            std::shared_ptr<Workspace> workspace;
+            size_t lastUse;
+        };
+
+        static std::map<Key, Entry>& entries();
+
+        static void evict();
+
+        inline static size_t capacity_m = 8;
+        inline static size_t clock_m    = 0;
+    };
+}  // namespace ippl
+
+#include "FFT/FFTPlanCache.hpp"
+
+#endif
@@ -0,0 +1,75 @@
+//
+// Class FFTPlanCache
+//   Process-wide cache of heffte plans and their workspaces.
+//
+#include <Kokkos_Core.hpp>
+#include <algorithm>
+#include <tuple>
+
+namespace ippl {
+
+    template <typename Plan, typename Workspace>
+    bool FFTPlanCache<Plan, Workspace>::Key::operator<(const Key& other) const {
+        auto tie = [](const Key& key) {
+            return std::tie(key.boxes, key.inOrder, key.outOrder, key.algorithm, key.pencils,
+                            key.reorder, key.gpuAware, key.r2cDirection);
+        };
+        return tie(*this) < tie(other);
+    }
+
+    template <typename Plan, typename Workspace>
+    bool FFTPlanCache<Plan, Workspace>::lookup(const Key& key, std::shared_ptr<Plan>& plan,
+                                               std::shared_ptr<Workspace>& workspace) {
+        auto& cache = entries();
+        auto it     = cache.find(key);
+        if (it == cache.end()) {
+            return false;
+        }
+        it->second.lastUse = ++clock_m;
+        plan               = it->second.plan;
+        workspace          = it->second.workspace;
+        return true;
+    }
+
+    template <typename Plan, typename Workspace>
+    void FFTPlanCache<Plan, Workspace>::insert(const Key& key, const std::shared_ptr<Plan>& plan,
+                                               const std::shared_ptr<Workspace>& workspace) {
+        if (capacity_m == 0) {
+            return;
+        }
+        entries()[key] = Entry{plan, workspace, ++clock_m};
+        evict();
+    }
+
+    template <typename Plan, typename Workspace>
+    void FFTPlanCache<Plan, Workspace>::setCapacity(size_t capacity) {
+        capacity_m = capacity;
+        evict();
+    }
+
+    template <typename Plan, typename Workspace>
+    void FFTPlanCache<Plan, Workspace>::evict() {
+        auto& cache = entries();
+        while (cache.size() > capacity_m) {
+            auto oldest = std::min_element(cache.begin(), cache.end(), [](auto& a, auto& b) {
+                return a.second.lastUse < b.second.lastUse;
+            });
+            cache.erase(oldest);
+        }
+    }
+
+    template <typename Plan, typename Workspace>
+    std::map<typename FFTPlanCache<Plan, Workspace>::Key,
+             typename FFTPlanCache<Plan, Workspace>::Entry>&
+    FFTPlanCache<Plan, Workspace>::entries() {
+        static std::map<Key, Entry> cache;
+        // plans and workspaces may hold device memory, which must be freed
+        // before Kokkos is finalized
+        static bool hooked = [] {
+            Kokkos::push_finalize_hook([] { cache.clear(); });
+            return true;
+        }();
+        (void)hooked;
+        return cache;
+    }
+}  // namespace ippl
@@ -27,11 +27,17 @@ namespace ippl {
 
     template <typename Field, unsigned Dim>
     void BConds<Field, Dim>::apply(Field& field) {
+        // The boundary conditions write to the field through its view, which
+        // invalidates the halo. Unless they modify physical cells, the halo
+        // is as valid afterwards as it was before.
+        const int validGhost = field.getValidGhostDepth();
         for (auto& bc : bc_m) {
             bc->apply(field);
         }
         Kokkos::fence();
         Comm->barrier();
+        field.setValidGhostDepth(changesPhysicalCells() ? 0 : validGhost);
+        field.setBoundaryValid(true);
     }
 
     template <typename Field, unsigned Dim>
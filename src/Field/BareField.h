@@ -9,6 +9,7 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <memory>
 
 #include "Types/IpplTypes.h"
 
@@ -124,8 +125,71 @@ namespace ippl {
 
         int getNghost() const { return nghost_m; }
 
+        /*!
+         * Number of ghost layers that currently hold data consistent with
+         * the neighboring ranks.
+         * @returns the valid ghost depth
+         */
+        int getValidGhostDepth() const { return haloState_m->validGhost; }
+
+        /*!
+         * Mark the given number of ghost layers as valid, e.g. after
+         * filling them by other means than the halo exchange.
+         * @param depth the valid ghost depth
+         */
+        void setValidGhostDepth(int depth) {
+            PAssert_LE(depth, nghost_m);
+            haloState_m->validGhost = depth;
+        }
+
+        /*!
+         * Whether the ghost cells at the physical boundary are up to date, i.e.
+         * the boundary conditions were applied after the last write
+         */
+        bool isBoundaryValid() const { return haloState_m->boundaryValid; }
+
+        void setBoundaryValid(bool valid) { haloState_m->boundaryValid = valid; }
+
+        /*!
+         * Mark the halo as out of date. This is needed after writing to the
+         * field data through a view that was obtained before the last halo
+         * exchange, since such writes cannot be tracked.
+         */
+        void invalidateHalo() { *haloState_m = HaloState(); }
+
+        /*!
+         * Enable or disable the deep-halo mode. In deep-halo mode, the ghost layers
+         * computed by assign also count as valid at the physical boundary, so that
+         * successive stencil applications can run on shrinking regions without
+         * applying the boundary conditions in between; the halo is only exchanged
+         * once the valid depth has been exhausted. This mode is meant for fields
+         * whose ghost values at the physical boundary are reproduced by the stencil
+         * (e.g. periodic fields).
+         * @param enable whether assign validates the boundary (default true)
+         */
+        void setDeepHalo(bool enable = true) { deepHalo_m = enable; }
+
+        bool isDeepHalo() const { return deepHalo_m; }
+
+        /*!
+         * Send the internal data to the halo cells of the neighboring ranks.
+         */
         void fillHalo();
 
+        /*!
+         * Make sure that at least depth ghost layers are valid, skipping the
+         * exchange if they already are. The differential operators and gather
+         * use this instead of fillHalo. The valid depth is shared by all copies
+         * of the field and only changes in operations that all ranks take part
+         * in, i.e. assignments, exchanges and mutable access to the view, so
+         * the ranks agree on whether to exchange without communicating. Writes
+         * through a view obtained before the last exchange cannot be tracked and
+         * must be followed by invalidateHalo.
+         * @param depth number of ghost layers the caller needs (default 1)
+         * @returns true if fillHalo was called
+         */
+        bool refreshHalo(int depth = 1);
+
         void accumulateHalo();
 
         // Access to the layout.
@@ -152,6 +216,20 @@ namespace ippl {
         template <typename E, size_t N>
         BareField& operator=(const detail::Expression<E, N>& expr);
 
+        /*!
+         * Assign an arbitrary BareField expression on the local domain grown
+         * by nghost ghost layers. This is the building block of the deep-halo
+         * mode: if the operands of a stencil expression of radius r hold k valid
+         * ghost layers, the result can be computed on k - r ghost layers without
+         * exchanging the halo. Afterwards, the field holds nghost valid ghost layers.
+         * @tparam E expression type
+         * @tparam N size of the expression
+         * @param expr is the expression
+         * @param nghost number of ghost layers to include
+         */
+        template <typename E, size_t N>
+        BareField& assign(const detail::Expression<E, N>& expr, int nghost);
+
         /*!
          * Assign another field.
          * @tparam Args... variadic template to specify an access index for
@@ -164,7 +242,15 @@ namespace ippl {
             return dview_m(args...);
         }
 
-        view_type& getView() { return dview_m; }
+        /*!
+         * Mutable access to the field data. Since writes through the
+         * returned view cannot be tracked, this invalidates the halo.
+         * @returns the view storing the field data
+         */
+        view_type& getView() {
+            *haloState_m = HaloState();
+            return dview_m;
+        }
 
         const view_type& getView() const { return dview_m; }
 
@@ -206,6 +292,20 @@ namespace ippl {
         //! Number of ghost layers on each field boundary
         int nghost_m;
 
+        struct HaloState {
+            //! Number of ghost layers that currently hold valid data
+            int validGhost = 0;
+            //! Whether the boundary conditions were applied after the last write
+            bool boundaryValid = false;
+        };
+
+        //! The state of the ghost layers, shared by the copies of the field
+        //! since they share the view
+        std::shared_ptr<HaloState> haloState_m = std::make_shared<HaloState>();
+
+        //! Whether the valid ghost depth is used to skip halo exchanges
+        bool deepHalo_m = false;
+
         //! Actual field data
         view_type dview_m;
 
@@ -227,5 +327,6 @@ namespace ippl {
 
 #include "Field/BareField.hpp"
 #include "Field/BareFieldOperations.hpp"
+#include "Field/FusedOperations.hpp"
 
 #endif
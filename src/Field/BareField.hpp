@@ -12,6 +12,7 @@
 
 #include "Utility/Inform.h"
 #include "Utility/IpplInfo.h"
+#include "Utility/IpplTimings.h"
 
 namespace ippl {
     namespace detail {
@@ -28,6 +29,8 @@ namespace ippl {
     BareField<T, Dim, ViewArgs...> BareField<T, Dim, ViewArgs...>::deepCopy() const {
         BareField<T, Dim, ViewArgs...> copy(*layout_m, nghost_m);
         Kokkos::deep_copy(copy.dview_m, dview_m);
+        *copy.haloState_m = *haloState_m;
+        copy.deepHalo_m   = deepHalo_m;
         return copy;
     }
 
@@ -61,6 +64,12 @@ namespace ippl {
     void BareField<T, Dim, ViewArgs...>::setup() {
         owned_m = layout_m->getLocalNDIndex();
 
+        // the exchange ranges depend on the number of ghost layers
+        layout_m->addGhostDepth(nghost_m);
+
+        // copies made before this point keep the old view and thus their own state
+        haloState_m = std::make_shared<HaloState>();
+
         auto resize = [&]<size_t... Idx>(const std::index_sequence<Idx...>&) {
             this->resize((owned_m[Idx].length() + 2 * nghost_m)...);
         };
@@ -75,24 +84,45 @@ namespace ippl {
 
     template <typename T, unsigned Dim, class... ViewArgs>
     void BareField<T, Dim, ViewArgs...>::fillHalo() {
+        static IpplTimings::CounterRef performedCounter =
+            IpplTimings::getCounter("fillHalo performed");
+        IpplTimings::incrementCounter(performedCounter);
+
         if (Comm->size() > 1) {
-            halo_m.fillHalo(dview_m, layout_m);
+            halo_m.fillHalo(dview_m, layout_m, nghost_m);
         }
         if (layout_m->isAllPeriodic_m) {
             using Op = typename detail::HaloCells<T, Dim, ViewArgs...>::assign;
             halo_m.template applyPeriodicSerialDim<Op>(dview_m, layout_m, nghost_m);
         }
+        haloState_m->validGhost = nghost_m;
+    }
+
+    template <typename T, unsigned Dim, class... ViewArgs>
+    bool BareField<T, Dim, ViewArgs...>::refreshHalo(int depth) {
+        static IpplTimings::CounterRef skippedCounter = IpplTimings::getCounter("fillHalo skipped");
+
+        PAssert_LE(depth, nghost_m);
+
+        if (haloState_m->validGhost >= depth) {
+            IpplTimings::incrementCounter(skippedCounter);
+            return false;
+        }
+        fillHalo();
+        return true;
     }
 
     template <typename T, unsigned Dim, class... ViewArgs>
     void BareField<T, Dim, ViewArgs...>::accumulateHalo() {
         if (Comm->size() > 1) {
-            halo_m.accumulateHalo(dview_m, layout_m);
+            halo_m.accumulateHalo(dview_m, layout_m, nghost_m);
         }
         if (layout_m->isAllPeriodic_m) {
             using Op = typename detail::HaloCells<T, Dim, ViewArgs...>::rhs_plus_assign;
             halo_m.template applyPeriodicSerialDim<Op>(dview_m, layout_m, nghost_m);
         }
+        // the ghost layers still contain the contributions that were sent away
+        *haloState_m = HaloState();
     }
 
     template <typename T, unsigned Dim, class... ViewArgs>
@@ -101,6 +131,8 @@ namespace ippl {
         ippl::parallel_for(
             "BareField::operator=(T)", getRangePolicy(dview_m),
             KOKKOS_CLASS_LAMBDA(const index_array_type& args) { apply(dview_m, args) = x; });
+        // the value may differ between ranks
+        *haloState_m = HaloState();
         return *this;
     }
 
@@ -116,6 +148,26 @@ namespace ippl {
             KOKKOS_CLASS_LAMBDA(const index_array_type& args) {
                 apply(dview_m, args) = apply(expr_, args);
             });
+        *haloState_m = HaloState();
+        return *this;
+    }
+
+    template <typename T, unsigned Dim, class... ViewArgs>
+    template <typename E, size_t N>
+    BareField<T, Dim, ViewArgs...>& BareField<T, Dim, ViewArgs...>::assign(
+        const detail::Expression<E, N>& expr, int nghost) {
+        PAssert_GE(nghost, 0);
+        PAssert_LE(nghost, nghost_m);
+        using capture_type     = detail::CapturedExpression<E, N>;
+        capture_type expr_     = reinterpret_cast<const capture_type&>(expr);
+        using index_array_type = typename RangePolicy<Dim, execution_space>::index_array_type;
+        ippl::parallel_for(
+            "BareField::assign(const Expression&, int)", getFieldRangePolicy(nghost),
+            KOKKOS_CLASS_LAMBDA(const index_array_type& args) {
+                apply(dview_m, args) = apply(expr_, args);
+            });
+        haloState_m->validGhost    = nghost;
+        haloState_m->boundaryValid = deepHalo_m;
         return *this;
     }
 
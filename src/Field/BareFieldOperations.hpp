@@ -1,9 +1,26 @@
 //
 // File BareFieldOperations
-//   Norms and a scalar product for fields
+//   Norms and a scalar product for fields, as well as reductions
+//   over field expressions
 //
 
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
 namespace ippl {
+    namespace detail {
+        /*!
+         * The type obtained by evaluating an expression at a single index
+         * @tparam E expression type
+         * @tparam N size of the expression
+         */
+        template <typename E, size_t N>
+        using expression_value_type = std::remove_cvref_t<decltype(apply(
+            std::declval<const CapturedExpression<E, N>&>(),
+            std::declval<const typename RangePolicy<E::dim>::index_array_type&>()))>;
+    }  // namespace detail
+
     /*!
      * Computes the inner product of two fields
      * @param f1 first field
@@ -76,4 +93,70 @@ namespace ippl {
             }
         }
     }
+
+    /*!
+     * Reductions over arbitrary field expressions. The expression is evaluated
+     * inside the reduction kernel, so no temporary field is needed.
+     * @param expr the expression to reduce
+     * @param field a field that defines the iteration domain (its owned cells)
+     * @return The global result of the reduction
+     */
+#define DefineExpressionReduction(fun, name, op, MPI_Op)                                        \
+    template <typename E, size_t N, typename BareField>                                         \
+    detail::expression_value_type<E, N> name(const detail::Expression<E, N>& expr,              \
+                                             const BareField& field) {                          \
+        using T                = detail::expression_value_type<E, N>;                           \
+        using capture_type     = detail::CapturedExpression<E, N>;                              \
+        capture_type expr_     = reinterpret_cast<const capture_type&>(expr);                   \
+        using exec_space       = typename BareField::execution_space;                           \
+        using index_array_type = typename RangePolicy<E::dim, exec_space>::index_array_type;    \
+        T temp                 = 0.0;                                                           \
+        ippl::parallel_reduce(                                                                  \
+            #name "(const Expression&)", field.getFieldRangePolicy(),                           \
+            KOKKOS_LAMBDA(const index_array_type& args, T& valL) {                              \
+                T myVal = apply(expr_, args);                                                   \
+                op;                                                                             \
+            },                                                                                  \
+            Kokkos::fun<T>(temp));                                                              \
+        T globaltemp      = 0.0;                                                                \
+        MPI_Datatype type = get_mpi_datatype<T>(temp);                                          \
+        MPI_Allreduce(&temp, &globaltemp, 1, type, MPI_Op, Comm->getCommunicator());            \
+        return globaltemp;                                                                      \
+    }
+
+    DefineExpressionReduction(Sum, sum, valL += myVal, MPI_SUM)
+    DefineExpressionReduction(Max, max, if (myVal > valL) valL = myVal, MPI_MAX)
+    DefineExpressionReduction(Min, min, if (myVal < valL) valL = myVal, MPI_MIN)
+    DefineExpressionReduction(Prod, prod, valL *= myVal, MPI_PROD)
+
+    /*!
+     * Computes the inner product of two field expressions without
+     * storing them in temporary fields
+     * @param u first expression
+     * @param v second expression
+     * @param field a field that defines the iteration domain
+     * @return Result of u^T v
+     */
+    template <typename E1, size_t N1, typename E2, size_t N2, typename BareField>
+    auto innerProduct(const detail::Expression<E1, N1>& u, const detail::Expression<E2, N2>& v,
+                      const BareField& field) {
+        return sum(u * v, field);
+    }
+
+    /*!
+     * Computes the Lp-norm of a field expression without storing
+     * it in a temporary field
+     * @param expr the expression
+     * @param field a field that defines the iteration domain
+     * @param p desired norm (default 2)
+     * @return The desired norm of the expression
+     */
+    template <typename E, size_t N, typename BareField>
+    detail::expression_value_type<E, N> norm(const detail::Expression<E, N>& expr,
+                                             const BareField& field, int p = 2) {
+        if (p == 0) {
+            return max(fabs(expr), field);
+        }
+        return std::pow(sum(pow(fabs(expr), p), field), 1.0 / p);
+    }
 }  // namespace ippl
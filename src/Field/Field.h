@@ -21,7 +21,7 @@ namespace ippl {
 
     public:
         using Mesh_t      = Mesh;
-        using Centering_t = Cell;
+        using Centering_t = Centering;
         using Layout_t    = FieldLayout<Dim>;
         using BareField_t = BareField<T, Dim, ViewArgs...>;
         using view_type   = typename BareField_t::view_type;
@@ -86,6 +86,21 @@ namespace ippl {
         // The boundary conditions.
         BConds_t bc_m;
     };
+
+    namespace detail {
+        /*!
+         * Field type with the same dimension, mesh and centering
+         * as another field but a different value type
+         */
+        template <typename F, typename T>
+        struct ChangeValueType;
+
+        template <typename T, typename T1, unsigned Dim, class Mesh, class Centering,
+                  class... ViewArgs>
+        struct ChangeValueType<Field<T1, Dim, Mesh, Centering, ViewArgs...>, T> {
+            using type = Field<T, Dim, Mesh, Centering, ViewArgs...>;
+        };
+    }  // namespace detail
 }  // namespace ippl
 
 #include "Field/Field.hpp"
@@ -4,6 +4,22 @@
 //
 
 namespace ippl {
+    namespace detail {
+        /*!
+         * Exchanges the halo of an operand and applies its boundary conditions,
+         * unless the ghost cells are still valid from a previous operator
+         * @param u field
+         */
+        template <typename Field>
+        void prepareHalo(Field& u) {
+            const bool exchanged = u.refreshHalo();
+            if (exchanged || !u.isBoundaryValid()) {
+                BConds<Field, Field::dim>& bcField = u.getFieldBC();
+                bcField.apply(u);
+            }
+        }
+    }  // namespace detail
+
     /*!
      * User interface of gradient
      * @param u field
@@ -12,9 +28,7 @@ namespace ippl {
     detail::meta_grad<Field> grad(Field& u) {
         constexpr unsigned Dim = Field::dim;
 
-        u.fillHalo();
-        BConds<Field, Dim>& bcField = u.getFieldBC();
-        bcField.apply(u);
+        detail::prepareHalo(u);
 
         using mesh_type   = typename Field::Mesh_t;
         using vector_type = typename mesh_type::vector_type;
@@ -36,9 +50,7 @@ namespace ippl {
     detail::meta_div<Field> div(Field& u) {
         constexpr unsigned Dim = Field::dim;
 
-        u.fillHalo();
-        BConds<Field, Dim>& bcField = u.getFieldBC();
-        bcField.apply(u);
+        detail::prepareHalo(u);
 
         using mesh_type   = typename Field::Mesh_t;
         using vector_type = typename mesh_type::vector_type;
@@ -60,9 +72,7 @@ namespace ippl {
     detail::meta_laplace<Field> laplace(Field& u) {
         constexpr unsigned Dim = Field::dim;
 
-        u.fillHalo();
-        BConds<Field, Dim>& bcField = u.getFieldBC();
-        bcField.apply(u);
+        detail::prepareHalo(u);
 
         using mesh_type = typename Field::Mesh_t;
         mesh_type& mesh = u.get_mesh();
@@ -79,11 +89,7 @@ namespace ippl {
      */
     template <typename Field>
     detail::meta_curl<Field> curl(Field& u) {
-        constexpr unsigned Dim = Field::dim;
-
-        u.fillHalo();
-        BConds<Field, Dim>& bcField = u.getFieldBC();
-        bcField.apply(u);
+        detail::prepareHalo(u);
 
         using mesh_type = typename Field::Mesh_t;
         mesh_type& mesh = u.get_mesh();
@@ -106,9 +112,7 @@ namespace ippl {
     detail::meta_hess<Field> hess(Field& u) {
         constexpr unsigned Dim = Field::dim;
 
-        u.fillHalo();
-        BConds<Field, Dim>& bcField = u.getFieldBC();
-        bcField.apply(u);
+        detail::prepareHalo(u);
 
         using mesh_type   = typename Field::Mesh_t;
         using vector_type = typename mesh_type::vector_type;
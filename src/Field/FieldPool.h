@@ -0,0 +1,136 @@
+//
+// Class FieldPool
+//   Pool of scratch fields that are reused between calls instead of being
+//   reallocated every time. Fields are pooled by their type, mesh, layout and
+//   number of ghost layers and are handed out as RAII handles, e.g.
+//
+//       auto handle = ippl::FieldPool<field_type>::acquire(mesh, layout);
+//       field_type& r = *handle;
+//       ...
+//       // the field is returned to the pool when the handle goes out of scope
+//
+//   Pooled fields keep their previous contents and have their boundary
+//   conditions reset to NoBcFace. Fields are also keyed by the generation of
+//   their layout, so idle fields of a layout that has since been repartitioned
+//   or destroyed are never handed out again and are freed on the next acquire.
+//
+#ifndef IPPL_FIELD_POOL_H
+#define IPPL_FIELD_POOL_H
+
+#include <functional>
+#include <map>
+#include <optional>
+
+namespace ippl {
+
+    template <typename Field>
+    class FieldPool {
+    public:
+        using Mesh_t   = typename Field::Mesh_t;
+        using Layout_t = typename Field::Layout_t;
+
+    private:
+        struct Key {
+            const Mesh_t* mesh;
+            const Layout_t* layout;
+            size_t generation;
+            int nghost;
+
+            bool operator<(const Key& other) const {
+                // unrelated pointers are only totally ordered by std::less
+                if (mesh != other.mesh) {
+                    return std::less<const Mesh_t*>{}(mesh, other.mesh);
+                }
+                if (layout != other.layout) {
+                    return std::less<const Layout_t*>{}(layout, other.layout);
+                }
+                if (generation != other.generation) {
+                    return generation < other.generation;
+                }
+                return nghost < other.nghost;
+            }
+        };
+
+    public:
+        /*!
+         * A scratch field borrowed from the pool. The field is returned
+         * to the pool when the handle is destroyed or released.
+         */
+        class Handle {
+        public:
+            Handle() = default;
+
+            Handle(const Handle&)            = delete;
+            Handle& operator=(const Handle&) = delete;
+
+            Handle(Handle&& other);
+            Handle& operator=(Handle&& other);
+
+            ~Handle() { release(); }
+
+            Field& operator*() { return *field_m; }
+            Field* operator->() { return &*field_m; }
+
+            bool isActive() const { return field_m.has_value(); }
+
+            /*!
+             * Returns the field to the pool. Shallow copies of the field
+             * must not be used afterwards.
+             */
+            void release();
+
+        private:
+            friend class FieldPool;
+
+            Handle(const Key& key, const Field& field)
+                : key_m(key)
+                , field_m(field) {}
+
+            Key key_m{};
+            std::optional<Field> field_m;
+        };
+
+        /*!
+         * Borrows a field from the pool, allocating a new one if
+         * no idle field with the same properties is available
+         * @param mesh the mesh of the field
+         * @param layout the layout of the field
+         * @param nghost the number of ghost layers
+         * @return A handle to the field
+         */
+        static Handle acquire(Mesh_t& mesh, Layout_t& layout, int nghost = 1);
+
+        /*!
+         * Borrows a field with the same mesh, layout and number of
+         * ghost layers as an existing field
+         * @param other the field whose properties to use
+         * @return A handle to the field
+         */
+        static Handle acquire(const Field& other) {
+            return acquire(other.get_mesh(), other.getLayout(), other.getNghost());
+        }
+
+        /*!
+         * Frees all idle fields
+         */
+        static void clear() { idle().clear(); }
+
+        /*!
+         * @return The number of idle fields in the pool
+         */
+        static size_t size() { return idle().size(); }
+
+    private:
+        static std::multimap<Key, Field>& idle();
+
+        /*!
+         * Frees the idle fields of layouts that have been repartitioned
+         * or destroyed since the fields were released
+         */
+        static void purge();
+    };
+}  // namespace ippl
+
+#include "Field/FieldPool.hpp"
+
+#endif
@@ -0,0 +1,100 @@
+//
+// Class FieldPool
+//   Pool of scratch fields that are reused between calls instead of being
+//   reallocated every time.
+//
+#include <memory>
+
+#include "Utility/IpplTimings.h"
+
+#include "Field/BcTypes.h"
+
+namespace ippl {
+
+    template <typename Field>
+    FieldPool<Field>::Handle::Handle(Handle&& other)
+        : key_m(other.key_m)
+        , field_m(std::move(other.field_m)) {
+        other.field_m.reset();
+    }
+
+    template <typename Field>
+    typename FieldPool<Field>::Handle& FieldPool<Field>::Handle::operator=(Handle&& other) {
+        if (this != &other) {
+            release();
+            key_m = other.key_m;
+            if (other.field_m) {
+                field_m.emplace(*other.field_m);
+                other.field_m.reset();
+            }
+        }
+        return *this;
+    }
+
+    template <typename Field>
+    void FieldPool<Field>::Handle::release() {
+        if (field_m) {
+            idle().emplace(key_m, *field_m);
+            field_m.reset();
+        }
+    }
+
+    template <typename Field>
+    typename FieldPool<Field>::Handle FieldPool<Field>::acquire(Mesh_t& mesh, Layout_t& layout,
+                                                                int nghost) {
+        static IpplTimings::CounterRef allocCounter =
+            IpplTimings::getCounter("FieldPool allocations");
+        static IpplTimings::CounterRef reuseCounter = IpplTimings::getCounter("FieldPool reuses");
+
+        purge();
+
+        Key key{&mesh, &layout, layout.getGeneration(), nghost};
+
+        auto& pool = idle();
+        auto it    = pool.find(key);
+        if (it == pool.end()) {
+            IpplTimings::incrementCounter(allocCounter);
+            return Handle(key, Field(mesh, layout, nghost));
+        }
+
+        IpplTimings::incrementCounter(reuseCounter);
+        Handle handle(key, it->second);
+        pool.erase(it);
+
+        Field& field = *handle;
+
+        // scratch fields are handed out without boundary conditions
+        typename Field::BConds_t bc;
+        for (unsigned face = 0; face < 2 * Field::dim; ++face) {
+            bc[face] = std::make_shared<NoBcFace<Field>>(face);
+        }
+        field.setFieldBC(bc);
+        field.invalidateHalo();
+
+        return handle;
+    }
+
+    template <typename Field>
+    void FieldPool<Field>::purge() {
+        auto& pool = idle();
+        for (auto it = pool.begin(); it != pool.end();) {
+            if (!detail::LayoutGeneration::isLive(it->first.generation)) {
+                it = pool.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    template <typename Field>
+    std::multimap<typename FieldPool<Field>::Key, Field>& FieldPool<Field>::idle() {
+        static std::multimap<Key, Field> pool;
+        // the pooled views must be freed before Kokkos is finalized
+        static bool hooked = [] {
+            Kokkos::push_finalize_hook([] { pool.clear(); });
+            return true;
+        }();
+        (void)hooked;
+        return pool;
+    }
+}  // namespace ippl
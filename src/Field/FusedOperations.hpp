@@ -0,0 +1,268 @@
+//
+// File FusedOperations
+//   Kernel fusion for field assignments and reductions.
+//
+//   Every expression assignment and every reduction on fields is a full pass
+//   over memory. ippl::fused evaluates a sequence of assignments and sum
+//   reductions in a single kernel, cell by cell and in the given order, e.g.
+//
+//       auto [rr] = ippl::fused(ippl::assign(x, x + alpha * d),
+//                               ippl::assign(r, r - alpha * q),
+//                               ippl::reduce(r * r));
+//
+//   Since the operations are applied per cell, an expression must not apply
+//   a stencil (e.g. laplace) to a field that is assigned in the same fused kernel.
+//
+
+#include <array>
+#include <type_traits>
+#include <utility>
+
+namespace ippl {
+    namespace detail {
+        /*!
+         * A deferred assignment of an expression to a field
+         * @tparam View the field's view type
+         * @tparam E expression type
+         * @tparam N size of the expression
+         */
+        template <typename View, typename E, size_t N>
+        struct FusedAssignment {
+            constexpr static bool is_reduction = false;
+
+            View view;
+            CapturedExpression<E, N> expr;
+
+            //! Number of ghost layers of the assigned field
+            int nghost;
+
+            template <typename Idx>
+            KOKKOS_INLINE_FUNCTION void operator()(const Idx& args) const {
+                apply(view, args) = apply(expr, args);
+            }
+        };
+
+        /*!
+         * A deferred sum reduction of an expression
+         * @tparam T the result type
+         * @tparam E expression type
+         * @tparam N size of the expression
+         */
+        template <typename T, typename E, size_t N>
+        struct FusedSum {
+            constexpr static bool is_reduction = true;
+            using value_type                   = T;
+
+            CapturedExpression<E, N> expr;
+
+            template <typename Idx>
+            KOKKOS_INLINE_FUNCTION void operator()(const Idx& args, T& val) const {
+                val += apply(expr, args);
+            }
+        };
+
+        /*!
+         * Selects the I-th accumulator of a reduction kernel
+         */
+        template <size_t I, typename Acc, typename... Rest>
+        KOKKOS_INLINE_FUNCTION Acc& nthAccumulator(Acc& acc, Rest&... rest) {
+            if constexpr (I == 0) {
+                return acc;
+            } else {
+                return nthAccumulator<I - 1>(rest...);
+            }
+        }
+
+        /*!
+         * Recursive storage for the fused operations, since std::tuple
+         * cannot be used in device code.
+         */
+        template <typename... Ops>
+        struct FusedOperations;
+
+        template <>
+        struct FusedOperations<> {
+            template <size_t R, typename Idx, typename... Acc>
+            KOKKOS_INLINE_FUNCTION void evaluate(const Idx&, Acc&...) const {}
+        };
+
+        template <typename Op, typename... Rest>
+        struct FusedOperations<Op, Rest...> {
+            Op op;
+            FusedOperations<Rest...> rest;
+
+            /*!
+             * Evaluates the operations at a given cell in order
+             * @tparam R index of the accumulator of the next reduction
+             * @param args the cell index
+             * @param acc... the accumulators of all reductions
+             */
+            template <size_t R, typename Idx, typename... Acc>
+            KOKKOS_INLINE_FUNCTION void evaluate(const Idx& args, Acc&... acc) const {
+                if constexpr (Op::is_reduction) {
+                    op(args, nthAccumulator<R>(acc...));
+                    rest.template evaluate<R + 1>(args, acc...);
+                } else {
+                    op(args);
+                    rest.template evaluate<R>(args, acc...);
+                }
+            }
+        };
+
+        template <typename Op, typename... Rest>
+        FusedOperations<Op, Rest...> makeFusedOperations(const Op& op, const Rest&... rest) {
+            if constexpr (sizeof...(Rest) == 0) {
+                return {op, {}};
+            } else {
+                return {op, makeFusedOperations(rest...)};
+            }
+        }
+
+        /*!
+         * Kernel functor for fused operations containing K reductions
+         * @tparam Operations the fused operations
+         * @tparam Idx the index array type
+         * @tparam T the reduction type
+         * @tparam I... the accumulator indices
+         */
+        template <typename Operations, typename Idx, typename T, typename Seq>
+        struct FusedReductionKernel;
+
+        template <typename Operations, typename Idx, typename T, size_t... I>
+        struct FusedReductionKernel<Operations, Idx, T, std::index_sequence<I...>> {
+            template <size_t>
+            using accumulator_type = T;
+
+            Operations operations;
+
+            KOKKOS_INLINE_FUNCTION void operator()(const Idx& args,
+                                                   accumulator_type<I>&... acc) const {
+                operations.template evaluate<0>(args, acc...);
+            }
+        };
+
+        /*!
+         * Determines the type of the first reduction in a list of operations
+         */
+        template <bool IsReduction, typename Op, typename... Ops>
+        struct FusedResultSelect;
+
+        template <typename... Ops>
+        struct FusedResult;
+
+        template <typename Op, typename... Ops>
+        struct FusedResult<Op, Ops...> : FusedResultSelect<Op::is_reduction, Op, Ops...> {};
+
+        template <typename Op, typename... Ops>
+        struct FusedResultSelect<true, Op, Ops...> {
+            using type = typename Op::value_type;
+        };
+
+        template <typename Op, typename... Ops>
+        struct FusedResultSelect<false, Op, Ops...> : FusedResult<Ops...> {};
+
+        template <typename Op, typename T, bool IsReduction = Op::is_reduction>
+        struct hasReductionType : std::true_type {};
+
+        template <typename Op, typename T>
+        struct hasReductionType<Op, T, true> : std::is_same<typename Op::value_type, T> {};
+
+        template <size_t... Idx, typename Functor, typename Policy, typename T, size_t K>
+        void fusedReduce(const std::index_sequence<Idx...>&, const Functor& functor,
+                         const Policy& policy, std::array<T, K>& local) {
+            ippl::parallel_reduce("fused", policy, functor, Kokkos::Sum<T>(local[Idx])...);
+        }
+    }  // namespace detail
+
+    /*!
+     * Creates a deferred assignment for use with ippl::fused
+     * @param field the field to assign to
+     * @param expr the expression to evaluate
+     * @return The assignment operation
+     */
+    template <typename Field, typename E, size_t N>
+    detail::FusedAssignment<typename Field::view_type, E, N> assign(
+        Field& field, const detail::Expression<E, N>& expr) {
+        using capture_type = detail::CapturedExpression<E, N>;
+        // mutable access marks the halo of the field as out of date
+        return {field.getView(), reinterpret_cast<const capture_type&>(expr), field.getNghost()};
+    }
+
+    /*!
+     * Creates a deferred sum reduction for use with ippl::fused
+     * @param expr the expression to sum over all cells
+     * @return The reduction operation
+     */
+    template <typename E, size_t N>
+    auto reduce(const detail::Expression<E, N>& expr) {
+        using capture_type = detail::CapturedExpression<E, N>;
+        using T            = detail::expression_value_type<E, N>;
+        return detail::FusedSum<T, E, N>{reinterpret_cast<const capture_type&>(expr)};
+    }
+
+    /*!
+     * Evaluates several field assignments and sum reductions in a single
+     * kernel over the owned domain of the first assigned field, without
+     * combining the reduction results across ranks. This allows the global
+     * reduction to be overlapped with other work, e.g. with MPI_Iallreduce.
+     * @param assignment the first operation, which determines the iteration domain
+     * @param ops... further assignments or reductions
+     * @return An array containing the rank-local results of the reductions in order
+     * (nothing if there are no reductions)
+     */
+    template <typename View, typename E, size_t N, typename... Ops>
+    auto fusedLocal(const detail::FusedAssignment<View, E, N>& assignment, const Ops&... ops) {
+        constexpr size_t K = (0 + ... + static_cast<size_t>(Ops::is_reduction));
+
+        auto operations = detail::makeFusedOperations(assignment, ops...);
+        auto policy     = getRangePolicy(assignment.view, assignment.nghost);
+
+        using index_array_type =
+            typename RangePolicy<View::rank, typename View::execution_space>::index_array_type;
+
+        if constexpr (K == 0) {
+            ippl::parallel_for(
+                "fused", policy, KOKKOS_LAMBDA(const index_array_type& args) {
+                    operations.template evaluate<0>(args);
+                });
+        } else {
+            using T = typename detail::FusedResult<Ops...>::type;
+            static_assert((detail::hasReductionType<Ops, T>::value && ...),
+                          "All reductions in a fused kernel must have the same type");
+
+            using kernel_type = detail::FusedReductionKernel<decltype(operations), index_array_type,
+                                                             T, std::make_index_sequence<K>>;
+
+            std::array<T, K> local;
+            detail::fusedReduce(std::make_index_sequence<K>{}, kernel_type{operations}, policy,
+                                local);
+            return local;
+        }
+    }
+
+    /*!
+     * Evaluates several field assignments and sum reductions in a single
+     * kernel over the owned domain of the first assigned field. The operations
+     * are applied cell by cell in the order in which they are given, and
+     * all reduction results are combined in a single MPI_Allreduce.
+     * @param assignment the first operation, which determines the iteration domain
+     * @param ops... further assignments or reductions
+     * @return An array containing the global results of the reductions in order
+     * (nothing if there are no reductions)
+     */
+    template <typename View, typename E, size_t N, typename... Ops>
+    auto fused(const detail::FusedAssignment<View, E, N>& assignment, const Ops&... ops) {
+        constexpr size_t K = (0 + ... + static_cast<size_t>(Ops::is_reduction));
+
+        if constexpr (K == 0) {
+            fusedLocal(assignment, ops...);
+        } else {
+            auto local = fusedLocal(assignment, ops...);
+            decltype(local) global;
+
+            MPI_Datatype type = get_mpi_datatype(local[0]);
+            MPI_Allreduce(local.data(), global.data(), K, type, MPI_SUM, Comm->getCommunicator());
+            return global;
+        }
+    }
+}  // namespace ippl
@@ -55,16 +55,18 @@ namespace ippl {
              * assign_plus functor to assign the data.
              * @param view the original field data
              * @param layout the field layout storing the domain decomposition
+             * @param nghost the number of ghost layers of the field (default 1)
              */
-            void accumulateHalo(view_type& view, const Layout_t* layout);
+            void accumulateHalo(view_type& view, const Layout_t* layout, int nghost = 1);
 
             /*!
              * Send interal data to halo cells. This operation uses
              * assign functor to assign the data.
              * @param view the original field data
              * @param layout the field layout storing the domain decomposition
+             * @param nghost the number of ghost layers of the field (default 1)
              */
-            void fillHalo(view_type&, const Layout_t* layout);
+            void fillHalo(view_type&, const Layout_t* layout, int nghost = 1);
 
             /*!
              * Pack the field data to be sent into a contiguous array.
@@ -124,11 +126,13 @@ namespace ippl {
              * @param view is the original field data
              * @param layout the field layout storing the domain decomposition
              * @param order the data send orientation
+             * @param nghost the number of ghost layers to exchange
              * @tparam Op the data assigment operator of the
              * unpack function call
              */
             template <class Op>
-            void exchangeBoundaries(view_type& view, const Layout_t* layout, SendOrder order);
+            void exchangeBoundaries(view_type& view, const Layout_t* layout, SendOrder order,
+                                    int nghost);
 
             /*!
              * Extract the subview of the original data. This does not copy.
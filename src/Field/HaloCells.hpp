@@ -17,26 +17,27 @@ namespace ippl {
 
         template <typename T, unsigned Dim, class... ViewArgs>
         void HaloCells<T, Dim, ViewArgs...>::accumulateHalo(view_type& view,
-                                                            const Layout_t* layout) {
-            exchangeBoundaries<lhs_plus_assign>(view, layout, HALO_TO_INTERNAL);
+                                                            const Layout_t* layout, int nghost) {
+            exchangeBoundaries<lhs_plus_assign>(view, layout, HALO_TO_INTERNAL, nghost);
         }
 
         template <typename T, unsigned Dim, class... ViewArgs>
-        void HaloCells<T, Dim, ViewArgs...>::fillHalo(view_type& view, const Layout_t* layout) {
-            exchangeBoundaries<assign>(view, layout, INTERNAL_TO_HALO);
+        void HaloCells<T, Dim, ViewArgs...>::fillHalo(view_type& view, const Layout_t* layout,
+                                                      int nghost) {
+            exchangeBoundaries<assign>(view, layout, INTERNAL_TO_HALO, nghost);
         }
 
         template <typename T, unsigned Dim, class... ViewArgs>
         template <class Op>
         void HaloCells<T, Dim, ViewArgs...>::exchangeBoundaries(view_type& view,
                                                                 const Layout_t* layout,
-                                                                SendOrder order) {
+                                                                SendOrder order, int nghost) {
             using neighbor_list = typename Layout_t::neighbor_list;
             using range_list    = typename Layout_t::neighbor_range_list;
 
-            const neighbor_list& neighbors = layout->getNeighbors();
-            const range_list &sendRanges   = layout->getNeighborsSendRange(),
-                             &recvRanges   = layout->getNeighborsRecvRange();
+            const neighbor_list& neighbors = layout->getNeighbors(nghost);
+            const range_list &sendRanges   = layout->getNeighborsSendRange(nghost),
+                             &recvRanges   = layout->getNeighborsRecvRange(nghost);
 
             size_t totalRequests = 0;
             for (const auto& componentNeighbors : neighbors) {
@@ -0,0 +1,192 @@
+//
+// File Redistribution
+//   Redistribution of field data between two layouts, e.g. between the physical
+//   and the zero-padded grid of the FFT-based solvers. A CommPlan lists the blocks
+//   of the field that this rank sends to and receives from each rank. It only
+//   depends on the layouts, so it is found once instead of intersecting the
+//   domains of all ranks in every redistribution.
+//
+#ifndef IPPL_REDISTRIBUTION_H
+#define IPPL_REDISTRIBUTION_H
+
+#include <Kokkos_Complex.hpp>
+#include <type_traits>
+#include <vector>
+
+#include "Types/Vector.h"
+
+#include "Communicate/Archive.h"
+#include "Field/HaloCells.h"
+#include "FieldLayout/FieldLayout.h"
+#include "Index/NDIndex.h"
+
+namespace ippl {
+    namespace detail {
+        /*!
+         * Access a view that either contains a vector field or a scalar field
+         * in such a way that the correct element access is determined at compile
+         * time, reducing the number of functions needed to achieve the same
+         * behavior for both kinds of fields
+         * @tparam tensorRank indicates whether scalar, vector, or matrix field
+         * @tparam - the view type
+         */
+        template <int tensorRank, typename>
+        struct ViewAccess;
+
+        template <typename View>
+        struct ViewAccess<2, View> {
+            template <typename Idx>
+            KOKKOS_INLINE_FUNCTION constexpr static auto& get(const View& view, unsigned dim1,
+                                                              unsigned dim2, const Idx& args) {
+                return apply(view, args)[dim1][dim2];
+            }
+        };
+
+        template <typename View>
+        struct ViewAccess<1, View> {
+            template <typename Idx>
+            KOKKOS_INLINE_FUNCTION constexpr static auto& get(const View& view, unsigned dim1,
+                                                              [[maybe_unused]] unsigned dim2,
+                                                              const Idx& args) {
+                return apply(view, args)[dim1];
+            }
+        };
+
+        template <typename View>
+        struct ViewAccess<0, View> {
+            template <typename Idx>
+            KOKKOS_INLINE_FUNCTION constexpr static auto& get(const View& view,
+                                                              [[maybe_unused]] unsigned dim1,
+                                                              [[maybe_unused]] unsigned dim2,
+                                                              const Idx& args) {
+                return apply(view, args);
+            }
+        };
+
+        template <typename T>
+        struct isComplex : std::false_type {};
+
+        template <typename T>
+        struct isComplex<Kokkos::complex<T>> : std::true_type {};
+
+        /*!
+         * The rank of a tensor type, i.e. 0 for scalars (including complex
+         * numbers), 1 for vectors and 2 for matrices
+         * @tparam T the type
+         */
+        template <typename T>
+        constexpr int tensorRank() {
+            if constexpr (std::is_arithmetic_v<T> || isComplex<T>::value) {
+                return 0;
+            } else {
+                return 1 + tensorRank<typename T::value_type>();
+            }
+        }
+
+        /*!
+         * A block of a field exchanged with another rank. Blocks with different
+         * tags are sent in separate messages; received blocks are reversed in the
+         * dimensions in which mirror is set.
+         */
+        template <unsigned Dim>
+        struct CommBlock {
+            int rank;
+            int tag;
+            NDIndex<Dim> domain;
+            Vector<bool, Dim> mirror;
+        };
+
+        /*!
+         * The blocks this rank sends and receives to redistribute a field
+         * between two layouts
+         */
+        template <unsigned Dim>
+        struct CommPlan {
+            std::vector<CommBlock<Dim>> sends;
+            std::vector<CommBlock<Dim>> recvs;
+
+            /*!
+             * @return The plan for the way back
+             */
+            CommPlan reversed() const { return {recvs, sends}; }
+        };
+
+        /*!
+         * Finds the blocks to redistribute a field from one layout to another
+         * @param src the layout of the field to copy from
+         * @param dst the layout of the field to copy to
+         * @return The plan
+         */
+        template <unsigned Dim>
+        CommPlan<Dim> makeCommPlan(const FieldLayout<Dim>& src, const FieldLayout<Dim>& dst);
+
+        /*!
+         * Finds the blocks to redistribute the part of a field inside of a region
+         * from one partitioning of the domain to another
+         * @param src the local domains of all ranks to copy from
+         * @param dst the local domains of all ranks to copy to
+         * @param region the global index region to copy
+         * @return The plan
+         */
+        template <unsigned Dim, typename SrcDomains, typename DstDomains>
+        CommPlan<Dim> makeCommPlan(const SrcDomains& src, const DstDomains& dst,
+                                   const NDIndex<Dim>& region);
+
+        /*!
+         * Copies an index region of a view into the buffer; of complex views,
+         * only the real part is copied into real buffers
+         * @param intersect the global index region
+         * @param view the view
+         * @param fd the buffer
+         * @param nghost the number of ghost cells of the view
+         * @param ldom the local domain of the view
+         * @param nsends the number of elements that were copied
+         */
+        template <typename Tb, typename View>
+        void pack(const NDIndex<View::rank>& intersect, const View& view, FieldBufferData<Tb>& fd,
+                  int nghost, const NDIndex<View::rank>& ldom, Communicate::size_type& nsends);
+
+        /*!
+         * Copies the buffer into an index region of a scalar field, a component
+         * of a vector field, or an element of a matrix field
+         * @param intersect the global index region
+         * @param view the view
+         * @param fd the buffer
+         * @param nghost the number of ghost cells of the view
+         * @param ldom the local domain of the view
+         * @param dim1 the vector component or matrix row
+         * @param dim2 the matrix column
+         * @param mirror the dimensions in which the block is reversed
+         */
+        template <typename Tb, typename View>
+        void unpack(const NDIndex<View::rank>& intersect, const View& view,
+                    FieldBufferData<Tb>& fd, int nghost, const NDIndex<View::rank>& ldom,
+                    size_t dim1 = 0, size_t dim2 = 0,
+                    const Vector<bool, View::rank>& mirror = Vector<bool, View::rank>(false));
+
+        /*!
+         * Sends the blocks of a view to the other ranks, then receives the blocks
+         * of the other ranks, each of which is unpacked from the buffer by
+         * unpackBlock. The block that stays on this rank is copied without a message.
+         * @param sends the blocks to send
+         * @param recvs the blocks to receive
+         * @param view the view to send from
+         * @param nghost the number of ghost cells of the view
+         * @param ldom the local domain of the view
+         * @param fd the buffer
+         * @param tag the message tag, to which the tags of the blocks are added
+         * @param sendId the id of the first send buffer
+         * @param recvId the id of the receive buffer
+         * @param unpackBlock callable taking a received CommBlock
+         */
+        template <unsigned Dim, typename View, typename Tb, typename UnpackBlock>
+        void exchange(const std::vector<CommBlock<Dim>>& sends,
+                      const std::vector<CommBlock<Dim>>& recvs, const View& view, int nghost,
+                      const NDIndex<Dim>& ldom, FieldBufferData<Tb>& fd, int tag, int sendId,
+                      int recvId, UnpackBlock&& unpackBlock);
+    }  // namespace detail
+}  // namespace ippl
+
+#include "Field/Redistribution.hpp"
+
+#endif
@@ -0,0 +1,179 @@
+//
+// File Redistribution
+//   Redistribution of field data between two layouts.
+//
+#include <algorithm>
+
+#include "Communicate/Communicate.h"
+
+namespace ippl {
+    namespace detail {
+        template <unsigned Dim>
+        CommPlan<Dim> makeCommPlan(const FieldLayout<Dim>& src, const FieldLayout<Dim>& dst) {
+            return makeCommPlan(src.getHostLocalDomains(), dst.getHostLocalDomains(),
+                                src.getDomain());
+        }
+
+        template <unsigned Dim, typename SrcDomains, typename DstDomains>
+        CommPlan<Dim> makeCommPlan(const SrcDomains& src, const DstDomains& dst,
+                                   const NDIndex<Dim>& region) {
+            const int myRank = Comm->rank();
+
+            CommPlan<Dim> plan;
+            if (src[myRank].touches(region)) {
+                const NDIndex<Dim> srcLocal = src[myRank].intersect(region);
+                for (int i = 0; i < Comm->size(); ++i) {
+                    if (dst[i].touches(srcLocal)) {
+                        plan.sends.push_back({i, 0, dst[i].intersect(srcLocal), {}});
+                    }
+                }
+            }
+            if (dst[myRank].touches(region)) {
+                const NDIndex<Dim> dstLocal = dst[myRank].intersect(region);
+                for (int i = 0; i < Comm->size(); ++i) {
+                    if (src[i].touches(dstLocal)) {
+                        plan.recvs.push_back({i, 0, src[i].intersect(dstLocal), {}});
+                    }
+                }
+            }
+            return plan;
+        }
+
+        template <typename Tb, typename View>
+        void pack(const NDIndex<View::rank>& intersect, const View& view, FieldBufferData<Tb>& fd,
+                  int nghost, const NDIndex<View::rank>& ldom, Communicate::size_type& nsends) {
+            constexpr unsigned Dim = View::rank;
+            using exec_space       = typename View::execution_space;
+            using index_type       = typename RangePolicy<Dim, exec_space>::index_type;
+            using value_type       = typename View::non_const_value_type;
+
+            auto& buffer = fd.buffer;
+
+            size_t size = intersect.size();
+            nsends      = size;
+            if (buffer.size() < size) {
+                const int overalloc = Comm->getDefaultOverallocation();
+                Kokkos::realloc(buffer, size * overalloc);
+            }
+
+            Kokkos::Array<index_type, Dim> first, last;
+            Vector<int, Dim> length;
+            for (unsigned d = 0; d < Dim; ++d) {
+                first[d]  = intersect[d].first() + nghost - ldom[d].first();
+                last[d]   = intersect[d].last() + nghost - ldom[d].first() + 1;
+                length[d] = intersect[d].length();
+            }
+
+            using index_array_type = typename RangePolicy<Dim, exec_space>::index_array_type;
+            ippl::parallel_for(
+                "pack()", createRangePolicy<Dim, exec_space>(first, last),
+                KOKKOS_LAMBDA(const index_array_type& args) {
+                    int l = 0;
+                    for (int d = Dim - 1; d >= 0; --d) {
+                        l = l * length[d] + (args[d] - first[d]);
+                    }
+
+                    if constexpr (isComplex<value_type>::value && !isComplex<Tb>::value) {
+                        buffer(l) = Kokkos::real(apply(view, args));
+                    } else {
+                        buffer(l) = apply(view, args);
+                    }
+                });
+            Kokkos::fence();
+        }
+
+        template <typename Tb, typename View>
+        void unpack(const NDIndex<View::rank>& intersect, const View& view,
+                    FieldBufferData<Tb>& fd, int nghost, const NDIndex<View::rank>& ldom,
+                    size_t dim1, size_t dim2, const Vector<bool, View::rank>& mirror) {
+            constexpr unsigned Dim = View::rank;
+            constexpr int rank     = tensorRank<typename View::value_type>();
+            using exec_space       = typename View::execution_space;
+            using index_type       = typename RangePolicy<Dim, exec_space>::index_type;
+            using access_type      = ViewAccess<rank, View>;
+
+            auto& buffer = fd.buffer;
+
+            Kokkos::Array<index_type, Dim> first, last;
+            Vector<int, Dim> length;
+            for (unsigned d = 0; d < Dim; ++d) {
+                first[d]  = intersect[d].first() + nghost - ldom[d].first();
+                last[d]   = intersect[d].last() + nghost - ldom[d].first() + 1;
+                length[d] = intersect[d].length();
+            }
+
+            using index_array_type = typename RangePolicy<Dim, exec_space>::index_array_type;
+            ippl::parallel_for(
+                "unpack()", createRangePolicy<Dim, exec_space>(first, last),
+                KOKKOS_LAMBDA(const index_array_type& args) {
+                    int l = 0;
+                    for (int d = Dim - 1; d >= 0; --d) {
+                        int ig = args[d] - first[d];
+                        ig     = mirror[d] * (length[d] - 2 * ig - 1) + ig;
+                        l      = l * length[d] + ig;
+                    }
+
+                    access_type::get(view, dim1, dim2, args) = buffer(l);
+                });
+            Kokkos::fence();
+        }
+
+        template <unsigned Dim, typename View, typename Tb, typename UnpackBlock>
+        void exchange(const std::vector<CommBlock<Dim>>& sends,
+                      const std::vector<CommBlock<Dim>>& recvs, const View& view, int nghost,
+                      const NDIndex<Dim>& ldom, FieldBufferData<Tb>& fd, int tag, int sendId,
+                      int recvId, UnpackBlock&& unpackBlock) {
+            using memory_space = typename FieldBufferData<Tb>::view_type::memory_space;
+            using buffer_type  = Communicate::buffer_type<memory_space>;
+
+            const int myRank = Comm->rank();
+
+            // send; isend copies the buffer into the message, so fd can be reused
+            std::vector<MPI_Request> requests;
+            requests.reserve(sends.size());
+            for (size_t i = 0; i < sends.size(); ++i) {
+                const CommBlock<Dim>& block = sends[i];
+                if (block.rank == myRank) {
+                    continue;
+                }
+
+                Communicate::size_type nsends;
+                pack(block.domain, view, fd, nghost, ldom, nsends);
+
+                buffer_type buf = Comm->getBuffer<memory_space, Tb>(sendId + i, nsends);
+
+                requests.emplace_back();
+                Comm->isend(block.rank, tag + block.tag, fd, *buf, requests.back(), nsends);
+                buf->resetWritePos();
+            }
+
+            // receive
+            for (const CommBlock<Dim>& block : recvs) {
+                if (block.rank == myRank) {
+                    auto self = std::find_if(sends.begin(), sends.end(), [&](const auto& send) {
+                        return send.rank == myRank && send.tag == block.tag;
+                    });
+
+                    Communicate::size_type nsends;
+                    pack(self->domain, view, fd, nghost, ldom, nsends);
+                } else {
+                    Communicate::size_type nrecvs = block.domain.size();
+
+                    buffer_type buf = Comm->getBuffer<memory_space, Tb>(recvId, nrecvs);
+
+                    Comm->recv(block.rank, tag + block.tag, fd, *buf, nrecvs * sizeof(Tb),
+                               nrecvs);
+                    buf->resetReadPos();
+                }
+
+                unpackBlock(block);
+            }
+
+            // messages between two ranks with the same tag arrive in the order in
+            // which they were sent, so no barrier is needed before the next exchange
+            if (requests.size() > 0) {
+                MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+            }
+        }
+    }  // namespace detail
+}  // namespace ippl
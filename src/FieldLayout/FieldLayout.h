@@ -11,6 +11,7 @@
 #include <array>
 #include <iostream>
 #include <map>
+#include <set>
 #include <vector>
 
 #include "Types/ViewTypes.h"
@@ -40,6 +41,53 @@ namespace ippl {
     };
 
     namespace detail {
+        /*!
+         * Identifies one partitioning of a layout. A new generation is started
+         * whenever the local domains are (re)computed or the layout is copied,
+         * and a generation retires when it is replaced or its layout is destroyed.
+         */
+        class LayoutGeneration {
+        public:
+            LayoutGeneration() { renew(); }
+
+            LayoutGeneration(const LayoutGeneration&) { renew(); }
+
+            LayoutGeneration& operator=(const LayoutGeneration&) {
+                renew();
+                return *this;
+            }
+
+            ~LayoutGeneration() { live().erase(id_m); }
+
+            void renew() {
+                live().erase(id_m);
+                id_m = ++counter();
+                live().insert(id_m);
+            }
+
+            size_t id() const { return id_m; }
+
+            /*!
+             * @param id a generation
+             * @return Whether the generation belongs to the current partitioning
+             *         of an existing layout
+             */
+            static bool isLive(size_t id) { return live().count(id) > 0; }
+
+        private:
+            static size_t& counter() {
+                static size_t count = 0;
+                return count;
+            }
+
+            static std::set<size_t>& live() {
+                static std::set<size_t> ids;
+                return ids;
+            }
+
+            size_t id_m = 0;
+        };
+
         /*!
          * Counts the hypercubes in a given dimension
          * @param dim the dimension
@@ -220,6 +268,12 @@ namespace ippl {
         // Return the domain.
         const NDIndex<Dim>& getDomain() const { return gDomain_m; }
 
+        /*!
+         * @return The generation of the current partitioning, which changes
+         *         whenever the local domains change
+         */
+        size_t getGeneration() const { return generation_m.id(); }
+
         // Compare FieldLayouts to see if they represent the same domain; if
         // dimensionalities are different, the NDIndex operator==() will return
         // false:
@@ -259,23 +313,34 @@ namespace ippl {
         /*!
          * Get a list of all the neighbors, arranged by ternary encoding
          * of the hypercubes
+         * @param nghost the halo depth for which the neighbors are requested (default 1)
          * @return List of list of neighbor ranks touching each boundary component
          */
-        const neighbor_list& getNeighbors() const;
+        const neighbor_list& getNeighbors(int nghost = 1) const;
 
         /*!
          * Get the domain ranges corresponding to regions that should be sent
          * to neighbor ranks
+         * @param nghost the halo depth for which the ranges are requested (default 1)
          * @return Ranges to send
          */
-        const neighbor_range_list& getNeighborsSendRange() const;
+        const neighbor_range_list& getNeighborsSendRange(int nghost = 1) const;
 
         /*!
          * Get the domain ranges corresponding to regions that should be received
          * from neighbor ranks
+         * @param nghost the halo depth for which the ranges are requested (default 1)
          * @return Ranges to receive
          */
-        const neighbor_range_list& getNeighborsRecvRange() const;
+        const neighbor_range_list& getNeighborsRecvRange(int nghost = 1) const;
+
+        /*!
+         * Register a halo depth with the layout. The neighbors and exchange ranges
+         * for this depth are computed once and kept up to date on repartitioning.
+         * Fields with more than one ghost layer register their depth on setup.
+         * @param nghost number of ghost cells
+         */
+        void addGhostDepth(int nghost);
 
         /*!
          * Given the index of a hypercube, find the index of the opposite hypercube,
@@ -321,6 +386,11 @@ namespace ippl {
          */
         void findNeighbors(int nghost = 1);
 
+        /*!
+         * Recomputes the neighbors for all registered halo depths
+         */
+        void findAllNeighbors();
+
         /*!
          * Adds a neighbor to the neighbor list
          * @param gnd the local domain, including ghost cells
@@ -368,8 +438,11 @@ namespace ippl {
 
         unsigned int minWidth_m[Dim];
 
-        neighbor_list neighbors_m;
-        neighbor_range_list neighborsSendRange_m, neighborsRecvRange_m;
+        detail::LayoutGeneration generation_m;
+
+        //! Neighbors and exchange ranges, one entry per registered halo depth
+        std::map<int, neighbor_list> neighbors_m;
+        std::map<int, neighbor_range_list> neighborsSendRange_m, neighborsRecvRange_m;
 
         void calcWidths();
     };
@@ -9,6 +9,7 @@
 
 #include <cstdlib>
 #include <limits>
+#include <string>
 
 #include "Utility/IpplException.h"
 #include "Utility/IpplTimings.h"
@@ -42,6 +43,11 @@ namespace ippl {
             requestedLayout_m[d] = PARALLEL;
             minWidth_m[d]        = 0;
         }
+
+        // the single layer halo is always available
+        neighbors_m[1];
+        neighborsSendRange_m[1];
+        neighborsRecvRange_m[1];
     }
 
     template <unsigned Dim>
@@ -63,11 +69,13 @@ namespace ippl {
             hLocalDomains_m(i) = domains[i];
         }
 
-        findNeighbors();
+        findAllNeighbors();
 
         Kokkos::deep_copy(dLocalDomains_m, hLocalDomains_m);
 
         calcWidths();
+
+        generation_m.renew();
     }
 
     template <unsigned Dim>
@@ -84,6 +92,7 @@ namespace ippl {
             Kokkos::resize(hLocalDomains_m, nRanks);
             hLocalDomains_m(0) = domain;
             Kokkos::deep_copy(dLocalDomains_m, hLocalDomains_m);
+            generation_m.renew();
             return;
         }
 
@@ -116,11 +125,13 @@ namespace ippl {
 
         partition.split(domain, hLocalDomains_m, requestedLayout_m, nRanks);
 
-        findNeighbors();
+        findAllNeighbors();
 
         Kokkos::deep_copy(dLocalDomains_m, hLocalDomains_m);
 
         calcWidths();
+
+        generation_m.renew();
     }
 
     template <unsigned Dim>
@@ -140,20 +151,52 @@ namespace ippl {
     }
 
     template <unsigned Dim>
-    const typename FieldLayout<Dim>::neighbor_list& FieldLayout<Dim>::getNeighbors() const {
-        return neighbors_m;
+    const typename FieldLayout<Dim>::neighbor_list& FieldLayout<Dim>::getNeighbors(
+        int nghost) const {
+        auto it = neighbors_m.find(nghost);
+        if (it == neighbors_m.end()) {
+            throw IpplException("FieldLayout::getNeighbors",
+                                "Halo depth " + std::to_string(nghost) + " not registered");
+        }
+        return it->second;
     }
 
     template <unsigned Dim>
-    const typename FieldLayout<Dim>::neighbor_range_list& FieldLayout<Dim>::getNeighborsSendRange()
-        const {
-        return neighborsSendRange_m;
+    const typename FieldLayout<Dim>::neighbor_range_list& FieldLayout<Dim>::getNeighborsSendRange(
+        int nghost) const {
+        auto it = neighborsSendRange_m.find(nghost);
+        if (it == neighborsSendRange_m.end()) {
+            throw IpplException("FieldLayout::getNeighborsSendRange",
+                                "Halo depth " + std::to_string(nghost) + " not registered");
+        }
+        return it->second;
     }
 
     template <unsigned Dim>
-    const typename FieldLayout<Dim>::neighbor_range_list& FieldLayout<Dim>::getNeighborsRecvRange()
-        const {
-        return neighborsRecvRange_m;
+    const typename FieldLayout<Dim>::neighbor_range_list& FieldLayout<Dim>::getNeighborsRecvRange(
+        int nghost) const {
+        auto it = neighborsRecvRange_m.find(nghost);
+        if (it == neighborsRecvRange_m.end()) {
+            throw IpplException("FieldLayout::getNeighborsRecvRange",
+                                "Halo depth " + std::to_string(nghost) + " not registered");
+        }
+        return it->second;
+    }
+
+    template <unsigned Dim>
+    void FieldLayout<Dim>::addGhostDepth(int nghost) {
+        if (neighbors_m.contains(nghost)) {
+            return;
+        }
+
+        neighbors_m[nghost];
+        neighborsSendRange_m[nghost];
+        neighborsRecvRange_m[nghost];
+
+        // serial layouts have no neighbors
+        if (hLocalDomains_m.size() > 1) {
+            findNeighbors(nghost);
+        }
     }
 
     template <unsigned Dim>
@@ -232,10 +275,13 @@ namespace ippl {
         /* We need to reset the neighbor list
          * and its ranges because of the repartitioner.
          */
+        auto& neighbors  = neighbors_m[nghost];
+        auto& sendRanges = neighborsSendRange_m[nghost];
+        auto& recvRanges = neighborsRecvRange_m[nghost];
         for (size_t i = 0; i < detail::countHypercubes(Dim) - 1; i++) {
-            neighbors_m[i].clear();
-            neighborsSendRange_m[i].clear();
-            neighborsRecvRange_m[i].clear();
+            neighbors[i].clear();
+            sendRanges[i].clear();
+            recvRanges[i].clear();
         }
 
         int myRank = Comm->rank();
@@ -274,6 +320,13 @@ namespace ippl {
         }
     }
 
+    template <unsigned Dim>
+    void FieldLayout<Dim>::findAllNeighbors() {
+        for (const auto& entry : neighbors_m) {
+            findNeighbors(entry.first);
+        }
+    }
+
     template <unsigned Dim>
     void FieldLayout<Dim>::addNeighbors(const NDIndex_t& gnd, const NDIndex_t& nd,
                                         const NDIndex_t& ndNeighbor, const NDIndex_t& intersect,
@@ -291,17 +344,18 @@ namespace ippl {
             // 0 - touching the lower axis value
             // 1 - touching the upper axis value
             // 2 - parallel to the axis
-            if (intersect[d].length() == 1) {
-                if (gnd[d].first() != intersect[d].first()) {
-                    index += digit;
-                }
-            } else {
+            // For deep halos the intersection with a touching component is up to
+            // nghost cells wide, so we check whether it lies entirely within the
+            // lower or upper ghost layers of the grown domain.
+            if (intersect[d].first() > gnd[d].last() - nghost) {
+                index += digit;
+            } else if (intersect[d].last() >= gnd[d].first() + nghost) {
                 index += 2 * digit;
             }
         }
-        neighbors_m[index].push_back(rank);
-        neighborsSendRange_m[index].push_back(rangeSend);
-        neighborsRecvRange_m[index].push_back(rangeRecv);
+        neighbors_m[nghost][index].push_back(rank);
+        neighborsSendRange_m[nghost][index].push_back(rangeSend);
+        neighborsRecvRange_m[nghost][index].push_back(rangeRecv);
     }
 
     template <unsigned Dim>
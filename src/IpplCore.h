@@ -8,6 +8,7 @@
 #include "Field/BareField.h"
 #include "Field/Field.h"
 #include "Field/BConds.h"
+#include "Field/FieldPool.h"
 
 // IPPL Utilities
 // #include "Utility/Timer.h"
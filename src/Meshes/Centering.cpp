@@ -31,6 +31,7 @@
 const char* Cell::CenteringName = "Cell";
 const char* Vert::CenteringName = "Vert";
 const char* Edge::CenteringName = "Edge";
+const char* Face::CenteringName = "Face";
 
 const char* Centering::CenteringEnum_Names[] = {"CELL  ", "VERTEX", "EDGE  "};
 
@@ -47,6 +48,10 @@ void Edge::print_Centerings(std::ostream& out) {
     out << Edge::CenteringName << std::endl;
 }
 
+void Face::print_Centerings(std::ostream& out) {
+    out << Face::CenteringName << std::endl;
+}
+
 /***************************************************************************
  * $RCSfile: Centering.cpp,v $   $Author: adelmann $
  * $Revision: 1.1.1.1 $   $Date: 2003/01/23 07:40:28 $
@@ -49,6 +49,12 @@ public:
     static void print_Centerings(std::ostream&);
 };
 
+class Face {
+public:
+    static const char* CenteringName;
+    static void print_Centerings(std::ostream&);
+};
+
 #endif  // CENTERING_H
 
 /***************************************************************************
@@ -15,6 +15,8 @@
 //
 #include "Ippl.h"
 
+#include <utility>
+
 #include "Communicate/DataTypes.h"
 
 #include "Utility/IpplTimings.h"
@@ -157,14 +159,16 @@ namespace ippl {
         Field& f, const ParticleAttrib<Vector<P2, Field::dim>, Properties...>& pp) {
         constexpr unsigned Dim = Field::dim;
 
+        // repeated gathers from an unchanged field exchange the halo only once
         static IpplTimings::TimerRef fillHaloTimer = IpplTimings::getTimer("fillHalo");
         IpplTimings::startTimer(fillHaloTimer);
-        f.fillHalo();
+        f.refreshHalo();
         IpplTimings::stopTimer(fillHaloTimer);
 
         static IpplTimings::TimerRef gatherTimer = IpplTimings::getTimer("gather");
         IpplTimings::startTimer(gatherTimer);
-        const typename Field::view_type view = f.getView();
+        // read-only access keeps the halo valid for subsequent gathers
+        const typename Field::view_type view = std::as_const(f).getView();
 
         using mesh_type       = typename Field::Mesh_t;
         const mesh_type& mesh = f.get_mesh();
@@ -6,8 +6,15 @@
 #ifndef IPPL_ELECTROSTATICS_CG_H
 #define IPPL_ELECTROSTATICS_CG_H
 
+#include <variant>
+
 #include "Electrostatics.h"
+#include "MixedPrecisionCG.h"
+#include "Multigrid.h"
 #include "PCG.h"
+#include "PipelinedCG.h"
+#include "PolynomialPreconditioner.h"
+#include "SolutionHistory.h"
 
 namespace ippl {
 
@@ -19,7 +26,13 @@ namespace ippl {
         return fun(arg);                        \
     }
 
-    template <typename FieldLHS, typename FieldRHS = FieldLHS>
+    /*!
+     * @tparam FieldLHS the field type of the solution
+     * @tparam FieldRHS the field type of the right hand side
+     * @tparam MixedPrecision whether the mixed precision algorithm is available; it is
+     * opt-in because it instantiates the solver and preconditioners for float fields
+     */
+    template <typename FieldLHS, typename FieldRHS = FieldLHS, bool MixedPrecision = false>
     class ElectrostaticsCG : public Electrostatics<FieldLHS, FieldRHS> {
         using Tlhs = typename FieldLHS::value_type;
 
@@ -30,6 +43,49 @@ namespace ippl {
         using OpRet = UnaryMinus<detail::meta_laplace<lhs_type>>;
         using algo  = PCG<OpRet, FieldLHS, FieldRHS>;
 
+        // the field type of the inner solver for mixed precision
+        using low_type = typename detail::ChangeValueType<lhs_type, float>::type;
+        using LowOpRet = UnaryMinus<detail::meta_laplace<low_type>>;
+
+        /*!
+         * Variants of the CG algorithm; the pipelined variant needs a single
+         * non-blocking reduction per iteration, and the mixed precision variant
+         * runs the CG iterations in single precision within an iterative refinement
+         * ("max_refinements" steps, each reducing the residue by "inner_tolerance");
+         * the latter needs MixedPrecision to be enabled
+         */
+        enum Algorithm {
+            CG                 = 0,
+            PIPELINED_CG       = 1,
+            MIXED_PRECISION_CG = 2
+        };
+
+        /*!
+         * Preconditioners for the CG algorithm; the parameters
+         * of the preconditioner are given in the nested parameter
+         * list "preconditioner_params". The Chebyshev preconditioner
+         * needs no coarse grids and no collectives when applied.
+         */
+        enum PreconditionerType {
+            NO_PRECONDITIONER = 0,
+            MULTIGRID         = 1,
+            CHEBYSHEV         = 2
+        };
+
+        /*!
+         * Initial guesses built from the solutions of previous solves, whose
+         * number is given by "warm_start_history". Without warm starting, the
+         * solver starts from the current content of the LHS. Extrapolation
+         * assumes that the solves are equidistant in time; projection needs the
+         * previous right hand sides and never gives a worse initial guess
+         * (in the energy norm) than the last solution.
+         */
+        enum WarmStart {
+            NO_WARM_START = 0,
+            EXTRAPOLATION = 1,
+            PROJECTION    = 2
+        };
+
         ElectrostaticsCG()
             : Base() {
             static_assert(std::is_floating_point<Tlhs>::value, "Not a floating point type");
@@ -43,8 +99,47 @@ namespace ippl {
         }
 
         void solve() override {
-            algo_m.setOperator(IPPL_SOLVER_OPERATOR_WRAPPER(-laplace, lhs_type));
-            algo_m(*(this->lhs_mp), *(this->rhs_mp), this->params_m);
+            algo& cg = getAlgorithm();
+            cg.setOperator(IPPL_SOLVER_OPERATOR_WRAPPER(-laplace, lhs_type));
+            if (algorithm_m == MIXED_PRECISION_CG) {
+                // the preconditioner is applied by the inner solver
+                if constexpr (MixedPrecision) {
+                    mixedAlgo_m.setInnerOperator(
+                        IPPL_SOLVER_OPERATOR_WRAPPER(-laplace, low_type));
+                    mixedAlgo_m.setInnerPreconditioner(
+                        getPreconditioner(lowPreconditioner_m, lowPreconditionerType_m));
+                }
+            } else {
+                cg.setPreconditioner(getPreconditioner(preconditioner_m, preconditionerType_m));
+            }
+
+            const int warmStart = this->params_m.template get<int>("warm_start");
+            if (warmStart != warmStart_m) {
+                history_m.clear();
+                warmStart_m = warmStart;
+            }
+            history_m.setCapacity(this->params_m.template get<int>("warm_start_history"));
+
+            switch (warmStart) {
+                case NO_WARM_START:
+                    break;
+                case EXTRAPOLATION:
+                    history_m.extrapolate(*(this->lhs_mp));
+                    break;
+                case PROJECTION:
+                    history_m.project(*(this->lhs_mp), *(this->rhs_mp));
+                    break;
+                default:
+                    throw IpplException("ElectrostaticsCG::solve", "Unrecognized warm start");
+            }
+
+            cg(*(this->lhs_mp), *(this->rhs_mp), this->params_m);
+
+            if (warmStart == EXTRAPOLATION) {
+                history_m.push(*(this->lhs_mp));
+            } else if (warmStart == PROJECTION) {
+                history_m.push(*(this->lhs_mp), *(this->rhs_mp));
+            }
 
             int output = this->params_m.template get<int>("output_type");
             if (output & Base::GRAD) {
@@ -57,20 +152,129 @@ namespace ippl {
          * the last time this solver was used
          * @return Iteration count of last solve
          */
-        int getIterationCount() { return algo_m.getIterationCount(); }
+        int getIterationCount() { return getActiveAlgorithm().getIterationCount(); }
 
         /*!
          * Query the residue
          * @return Residue norm from last solve
          */
-        Tlhs getResidue() const { return algo_m.getResidue(); }
+        Tlhs getResidue() const { return getActiveAlgorithm().getResidue(); }
 
     protected:
         algo algo_m = algo();
+        PipelinedCG<OpRet, FieldLHS, FieldRHS> pipelinedAlgo_m;
+
+        // only instantiated for float fields if the mixed precision algorithm is enabled
+        std::conditional_t<MixedPrecision,
+                           MixedPrecisionCG<OpRet, FieldLHS, FieldRHS, LowOpRet, low_type>,
+                           std::monostate>
+            mixedAlgo_m;
+
+        // the variant used in the last solve
+        int algorithm_m = CG;
+
+        /*!
+         * Selects the CG variant given in the parameters
+         * @return The algorithm
+         */
+        algo& getAlgorithm() {
+            algorithm_m = this->params_m.template get<int>("algorithm");
+            if (algorithm_m != CG && algorithm_m != PIPELINED_CG
+                && algorithm_m != MIXED_PRECISION_CG) {
+                throw IpplException("ElectrostaticsCG::getAlgorithm", "Unrecognized CG algorithm");
+            }
+            if (algorithm_m == MIXED_PRECISION_CG && !MixedPrecision) {
+                throw IpplException("ElectrostaticsCG::getAlgorithm",
+                                    "Mixed precision CG is not enabled for this solver");
+            }
+            return getActiveAlgorithm();
+        }
+
+        algo& getActiveAlgorithm() {
+            switch (algorithm_m) {
+                case PIPELINED_CG:
+                    return pipelinedAlgo_m;
+                case MIXED_PRECISION_CG:
+                    if constexpr (MixedPrecision) {
+                        return mixedAlgo_m;
+                    } else {
+                        return algo_m;
+                    }
+                default:
+                    return algo_m;
+            }
+        }
+
+        const algo& getActiveAlgorithm() const {
+            switch (algorithm_m) {
+                case PIPELINED_CG:
+                    return pipelinedAlgo_m;
+                case MIXED_PRECISION_CG:
+                    if constexpr (MixedPrecision) {
+                        return mixedAlgo_m;
+                    } else {
+                        return algo_m;
+                    }
+                default:
+                    return algo_m;
+            }
+        }
+
+        // previous solutions for warm starting
+        SolutionHistory<lhs_type, rhs_type> history_m;
+        int warmStart_m = NO_WARM_START;
+
+        std::shared_ptr<Preconditioner<lhs_type>> preconditioner_m;
+        std::shared_ptr<Preconditioner<low_type>> lowPreconditioner_m;
+
+        // the types of the preconditioners that were last created
+        int preconditionerType_m    = NO_PRECONDITIONER;
+        int lowPreconditionerType_m = NO_PRECONDITIONER;
+
+        /*!
+         * Creates or updates the preconditioner selected in the parameters
+         * @param precond the preconditioner from previous solves
+         * @param precondType the type of the preconditioner from previous solves
+         * @return The preconditioner, or nullptr if none is selected
+         */
+        template <typename Field>
+        std::shared_ptr<Preconditioner<Field>> getPreconditioner(
+            std::shared_ptr<Preconditioner<Field>>& precond, int& precondType) {
+            int type = this->params_m.template get<int>("preconditioner");
+            if (type == NO_PRECONDITIONER) {
+                return nullptr;
+            }
+
+            if (!precond || type != precondType) {
+                switch (type) {
+                    case MULTIGRID:
+                        precond = std::make_shared<MultigridPreconditioner<Field>>();
+                        break;
+                    case CHEBYSHEV:
+                        precond = std::make_shared<ChebyshevPreconditioner<Field>>();
+                        break;
+                    default:
+                        throw IpplException("ElectrostaticsCG::getPreconditioner",
+                                            "Unrecognized preconditioner type");
+                }
+                precondType = type;
+            }
+
+            precond->mergeParameters(
+                this->params_m.template get<ParameterList>("preconditioner_params"));
+            return precond;
+        }
 
         virtual void setDefaultParameters() override {
             this->params_m.add("max_iterations", 1000);
             this->params_m.add("tolerance", (Tlhs)1e-13);
+            this->params_m.add("algorithm", CG);
+            this->params_m.add("preconditioner", NO_PRECONDITIONER);
+            this->params_m.add("preconditioner_params", ParameterList());
+            this->params_m.add("warm_start", NO_WARM_START);
+            this->params_m.add("warm_start_history", 3);
+            this->params_m.add("max_refinements", 50);
+            this->params_m.add("inner_tolerance", (Tlhs)1e-4);
         }
     };
 
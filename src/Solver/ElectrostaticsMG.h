@@ -0,0 +1,88 @@
+//
+// Class ElectrostaticsMG
+//   Solves electrostatics problems with geometric multigrid
+//
+
+#ifndef IPPL_ELECTROSTATICS_MG_H
+#define IPPL_ELECTROSTATICS_MG_H
+
+#include <type_traits>
+
+#include "Electrostatics.h"
+#include "Multigrid.h"
+
+namespace ippl {
+
+    template <typename FieldLHS, typename FieldRHS = FieldLHS>
+    class ElectrostaticsMG : public Electrostatics<FieldLHS, FieldRHS> {
+        using Tlhs = typename FieldLHS::value_type;
+
+    public:
+        using Base = Electrostatics<FieldLHS, FieldRHS>;
+        using typename Base::lhs_type, typename Base::rhs_type;
+
+        using algo = Multigrid<lhs_type>;
+
+        ElectrostaticsMG()
+            : Base() {
+            static_assert(std::is_floating_point<Tlhs>::value, "Not a floating point type");
+            static_assert(std::is_same_v<lhs_type, rhs_type>,
+                          "The LHS and RHS must have the same type");
+            setDefaultParameters();
+        }
+
+        ElectrostaticsMG(lhs_type& lhs, rhs_type& rhs)
+            : Base(lhs, rhs) {
+            static_assert(std::is_floating_point<Tlhs>::value, "Not a floating point type");
+            static_assert(std::is_same_v<lhs_type, rhs_type>,
+                          "The LHS and RHS must have the same type");
+            setDefaultParameters();
+        }
+
+        void solve() override {
+            static IpplTimings::TimerRef solveTimer = IpplTimings::getTimer("Multigrid solve");
+            IpplTimings::startTimer(solveTimer);
+
+            algo_m(*(this->lhs_mp), *(this->rhs_mp), this->params_m);
+
+            int output = this->params_m.template get<int>("output_type");
+            if (output & Base::GRAD) {
+                *(this->grad_mp) = -grad(*(this->lhs_mp));
+            }
+
+            IpplTimings::stopTimer(solveTimer);
+        }
+
+        /*!
+         * Query how many V-cycles were required to obtain the solution
+         * the last time this solver was used
+         * @return Iteration count of last solve
+         */
+        int getIterationCount() { return algo_m.getIterationCount(); }
+
+        /*!
+         * Query the residue
+         * @return Residue norm from last solve
+         */
+        Tlhs getResidue() const { return algo_m.getResidue(); }
+
+        /*!
+         * Query the depth of the grid hierarchy
+         * @return Number of levels used in the last solve
+         */
+        unsigned getLevelCount() const { return algo_m.getLevelCount(); }
+
+    protected:
+        algo algo_m = algo();
+
+        virtual void setDefaultParameters() override {
+            this->params_m.merge(algo::getDefaultParameters());
+            this->params_m.add("max_iterations", 100);
+            this->params_m.add("tolerance", (Tlhs)1e-10);
+            this->params_m.add("fmg", true);
+        }
+    };
+
+}  // namespace ippl
+
+#endif
@@ -0,0 +1,157 @@
+//
+// Class FDTDSolver
+//   Explicit finite-difference time-domain solver for Maxwell's equations,
+//     dB/dt = -curl(E),  dE/dt = c^2 curl(B) - J / epsilon0,
+//   on a Yee lattice. The lattice points are the cell centers, at which the
+//   charge is deposited by ParticleAttrib::scatter. The components E_a and J_a
+//   are located on the faces between the cells i and i + e_a (Face centering)
+//   and B_a on the edges along the dimension a (Edge centering), so the curls
+//   are centered differences of neighboring values.
+//
+//   The update of a cell only depends on its nearest neighbors, so the only
+//   communication of a step is the exchange of one ghost layer of B and one of
+//   E, whose halo the solver keeps from the end of the previous step.
+//   Boundaries are either periodic, which requires periodic field layouts, or
+//   absorbing: the fields are damped in a layer of cells with a graded
+//   conductivity along the boundaries, behind which they vanish.
+//
+//   The current is deposited with the zigzag scheme of Umeda et al. (2003),
+//   which satisfies the discrete continuity equation for the linear (CIC)
+//   charge assignment of ParticleAttrib::scatter, so Gauss's law is kept
+//   if it holds initially.
+//
+
+#ifndef IPPL_FDTD_SOLVER_H
+#define IPPL_FDTD_SOLVER_H
+
+#include <type_traits>
+
+#include "Types/Vector.h"
+
+#include "Utility/IpplException.h"
+#include "Utility/IpplTimings.h"
+
+#include "Meshes/Centering.h"
+#include "Particle/ParticleAttrib.h"
+#include "Solver/Solver.h"
+
+namespace ippl {
+
+    template <typename EField, typename BField>
+    class FDTDSolver : public Solver<EField, EField> {
+        constexpr static unsigned Dim = EField::dim;
+        using T                       = typename EField::value_type::value_type;
+        using mesh_type               = typename EField::Mesh_t;
+        using vector_type             = typename mesh_type::vector_type;
+
+    public:
+        using Base = Solver<EField, EField>;
+        using typename Base::lhs_type, typename Base::rhs_type;
+        using b_type = BField;
+
+        enum Boundary {
+            PERIODIC  = 0,
+            ABSORBING = 1
+        };
+
+        FDTDSolver();
+
+        /*!
+         * Sets up a solver on the given fields
+         * @param E the electric field, which is advanced in time
+         * @param B the magnetic field, which is advanced in time
+         * @param J the current density, which must have two ghost layers for
+         * the current deposition
+         * @param params the solver parameters
+         */
+        FDTDSolver(lhs_type& E, b_type& B, rhs_type& J, ParameterList& params);
+
+        ~FDTDSolver() = default;
+
+        /*!
+         * Set the magnetic field
+         * @param B the magnetic field
+         */
+        void setMagneticField(b_type& B) { B_mp = &B; }
+
+        /*!
+         * Advances E and B by one time step with the current density of the
+         * step. B is advanced in two half steps around the update of E, so that
+         * both fields are known at the same time for the particle push. The halo
+         * of E is reused from the previous step if E has not been written since,
+         * so E must not be written through views obtained before that step.
+         */
+        void solve();
+
+        /*!
+         * The time step, which is given by the parameter "dt" or, if it is zero,
+         * by the "courant" number times the stability limit of the scheme
+         * @return The time step
+         */
+        T getTimeStep() const;
+
+        /*!
+         * Adds the current density of particles moving from R0 to R1 during a
+         * time step to J. The particles must not move by more than one cell in
+         * each dimension, and R0 must be the positions of the particles on this
+         * rank, so this has to be done before the particles are redistributed.
+         * @param q the particle charges
+         * @param R0 the positions at the beginning of the time step
+         * @param R1 the positions at the end of the time step
+         */
+        template <typename Q, typename P, class... Properties>
+        void depositCurrent(const ParticleAttrib<Q, Properties...>& q,
+                            const ParticleAttrib<Vector<P, Dim>, Properties...>& R0,
+                            const ParticleAttrib<Vector<P, Dim>, Properties...>& R1);
+
+        /*!
+         * The total energy of the electromagnetic field,
+         * epsilon0 / 2 (E^2 + c^2 B^2) integrated over the domain
+         * @return The field energy
+         */
+        T getFieldEnergy();
+
+    private:
+        // checks that the fields and the boundaries are consistent
+        void checkFields() const;
+
+        /*!
+         * Factor by which the fields of a cell are damped in an absorbing layer
+         * @param ig global index of the cell
+         * @param n number of cells of the domain
+         * @param layers number of cells of the absorbing layer
+         * @param sigmaDt the conductivity at the boundary times the time step
+         * @return The damping factor
+         */
+        KOKKOS_INLINE_FUNCTION static T damping(const Vector<int, Dim>& ig,
+                                                const Vector<int, Dim>& n, int layers,
+                                                const Vector<T, Dim>& sigmaDt);
+
+        // advances B by a fraction of a time step, requires the halo of E
+        void advanceB(T dt);
+
+        // advances E by a time step, requires the halo of B
+        void advanceE(T dt);
+
+        b_type* B_mp = nullptr;
+
+        // the field E whose halo was filled at the end of the last step
+        const lhs_type* filledE_mp = nullptr;
+
+    protected:
+        virtual void setDefaultParameters() override {
+            this->params_m.add("c", 1.0);
+            this->params_m.add("epsilon0", 1.0);
+            this->params_m.add("dt", 0.0);
+            this->params_m.add("courant", 0.95);
+            this->params_m.add("boundary", PERIODIC);
+            this->params_m.add("absorbing_layers", 8);
+            // reflection coefficient of the absorbing layer at normal incidence
+            this->params_m.add("absorbing_reflection", 1e-6);
+        }
+    };
+}  // namespace ippl
+
+#include "Solver/FDTDSolver.hpp"
+
+#endif
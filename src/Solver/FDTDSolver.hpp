@@ -0,0 +1,403 @@
+//
+// Class FDTDSolver
+//   Explicit finite-difference time-domain solver for Maxwell's equations
+//   on a Yee lattice.
+//
+
+namespace ippl {
+
+    template <typename EField, typename BField>
+    FDTDSolver<EField, BField>::FDTDSolver()
+        : Base() {
+        static_assert(Dim == 3, "FDTDSolver only supports 3D");
+        static_assert(std::is_same_v<typename EField::Centering_t, Face>,
+                      "E and J must be face centered");
+        static_assert(std::is_same_v<typename BField::Centering_t, Edge>,
+                      "B must be edge centered");
+        setDefaultParameters();
+    }
+
+    template <typename EField, typename BField>
+    FDTDSolver<EField, BField>::FDTDSolver(lhs_type& E, b_type& B, rhs_type& J,
+                                           ParameterList& params)
+        : Base(E, J)
+        , B_mp(&B) {
+        static_assert(Dim == 3, "FDTDSolver only supports 3D");
+        static_assert(std::is_same_v<typename EField::Centering_t, Face>,
+                      "E and J must be face centered");
+        static_assert(std::is_same_v<typename BField::Centering_t, Edge>,
+                      "B must be edge centered");
+        setDefaultParameters();
+        this->params_m.merge(params);
+    }
+
+    template <typename EField, typename BField>
+    typename FDTDSolver<EField, BField>::T FDTDSolver<EField, BField>::getTimeStep() const {
+        const vector_type& hr = this->lhs_mp->get_mesh().getMeshSpacing();
+        const T c             = this->params_m.template get<double>("c");
+
+        T sum = 0;
+        for (unsigned d = 0; d < Dim; ++d) {
+            sum += 1 / (hr[d] * hr[d]);
+        }
+        const T limit = 1 / (c * Kokkos::sqrt(sum));
+
+        const T dt = this->params_m.template get<double>("dt");
+        if (dt == 0) {
+            return this->params_m.template get<double>("courant") * limit;
+        }
+        if (dt > limit) {
+            throw IpplException("FDTDSolver::getTimeStep",
+                                "The time step violates the Courant condition");
+        }
+        return dt;
+    }
+
+    template <typename EField, typename BField>
+    void FDTDSolver<EField, BField>::checkFields() const {
+        if (this->lhs_mp == nullptr || B_mp == nullptr || this->rhs_mp == nullptr) {
+            throw IpplException("FDTDSolver::checkFields", "E, B and J must be set");
+        }
+        if (this->lhs_mp->getNghost() != B_mp->getNghost()) {
+            throw IpplException("FDTDSolver::checkFields",
+                                "E and B must have the same number of ghost layers");
+        }
+
+        const int boundary  = this->params_m.template get<int>("boundary");
+        const bool periodic = this->lhs_mp->getLayout().isAllPeriodic_m;
+        if (boundary != PERIODIC && boundary != ABSORBING) {
+            throw IpplException("FDTDSolver::checkFields", "Unrecognized boundary type");
+        }
+        if ((boundary == PERIODIC) != periodic) {
+            throw IpplException("FDTDSolver::checkFields",
+                                "Periodic boundaries require a periodic layout and vice versa");
+        }
+    }
+
+    template <typename EField, typename BField>
+    KOKKOS_INLINE_FUNCTION typename FDTDSolver<EField, BField>::T
+    FDTDSolver<EField, BField>::damping(const Vector<int, Dim>& ig, const Vector<int, Dim>& n,
+                                        int layers, const Vector<T, Dim>& sigmaDt) {
+        // the conductivity grows with the third power of the depth into the layer
+        T sigma = 0;
+        for (unsigned d = 0; d < Dim; ++d) {
+            const int depth = Kokkos::max(layers - ig[d], ig[d] - (n[d] - 1 - layers));
+            if (depth > 0) {
+                const T x = T(depth) / layers;
+                sigma += sigmaDt[d] * x * x * x;
+            }
+        }
+        return Kokkos::exp(-sigma);
+    }
+
+    template <typename EField, typename BField>
+    void FDTDSolver<EField, BField>::solve() {
+        static IpplTimings::TimerRef solveTimer = IpplTimings::getTimer("FDTD: Solve");
+        IpplTimings::startTimer(solveTimer);
+
+        checkFields();
+
+        const T dt = getTimeStep();
+
+        // The curl of E takes the values of the upper neighbors and the curl of B
+        // those of the lower neighbors. E was exchanged at the end of the previous
+        // step, so it is only exchanged again if it is a new field or has been
+        // written since, which resets its valid ghost depth on all ranks
+        lhs_type& E = *this->lhs_mp;
+
+        static IpplTimings::TimerRef haloTimer = IpplTimings::getTimer("FDTD: Halo");
+        IpplTimings::startTimer(haloTimer);
+        if (filledE_mp != &E || E.getValidGhostDepth() == 0) {
+            E.fillHalo();
+        }
+        IpplTimings::stopTimer(haloTimer);
+
+        advanceB(0.5 * dt);
+
+        IpplTimings::startTimer(haloTimer);
+        B_mp->fillHalo();
+        IpplTimings::stopTimer(haloTimer);
+
+        advanceE(dt);
+
+        IpplTimings::startTimer(haloTimer);
+        E.fillHalo();
+        filledE_mp = &E;
+        IpplTimings::stopTimer(haloTimer);
+
+        advanceB(0.5 * dt);
+
+        IpplTimings::stopTimer(solveTimer);
+    }
+
+    template <typename EField, typename BField>
+    void FDTDSolver<EField, BField>::advanceB(T dt) {
+        lhs_type& E = *this->lhs_mp;
+
+        const auto viewE = std::as_const(E).getView();
+        auto viewB       = B_mp->getView();
+        const int nghost = B_mp->getNghost();
+
+        const vector_type& hr = E.get_mesh().getMeshSpacing();
+        const auto& ldom      = E.getLayout().getLocalNDIndex();
+        const auto& domain    = E.getLayout().getDomain();
+
+        const bool absorbing = this->params_m.template get<int>("boundary") == ABSORBING;
+        const int layers     = this->params_m.template get<int>("absorbing_layers");
+        const T cLight       = this->params_m.template get<double>("c");
+        const T reflection   = this->params_m.template get<double>("absorbing_reflection");
+
+        // conductivity at the boundary for the given reflection of a layer whose
+        // conductivity grows with the third power of the depth, times the step
+        const T sigmaDtH = absorbing ? -2 * cLight * Kokkos::log(reflection) / layers * dt : 0;
+
+        Vector<int, Dim> n;
+        Vector<T, Dim> sigmaDt;
+        for (unsigned d = 0; d < Dim; ++d) {
+            n[d]       = domain[d].length();
+            sigmaDt[d] = sigmaDtH / hr[d];
+        }
+
+        static IpplTimings::TimerRef bTimer = IpplTimings::getTimer("FDTD: Advance B");
+        IpplTimings::startTimer(bTimer);
+
+        using index_array_type = typename RangePolicy<Dim>::index_array_type;
+        ippl::parallel_for(
+            "FDTDSolver: advance B", getRangePolicy(viewB, nghost),
+            KOKKOS_LAMBDA(const index_array_type& args) {
+                Vector<int, Dim> ig = args - nghost;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    ig[d] += ldom[d].first();
+                }
+                const T factor = damping(ig, n, layers, sigmaDt);
+
+                for (unsigned a = 0; a < Dim; ++a) {
+                    const unsigned b = (a + 1) % Dim;
+                    const unsigned c = (a + 2) % Dim;
+
+                    index_array_type upB = args, upC = args;
+                    upB[b] += 1;
+                    upC[c] += 1;
+
+                    const T curl = (apply(viewE, upB)[c] - apply(viewE, args)[c]) / hr[b]
+                                   - (apply(viewE, upC)[b] - apply(viewE, args)[b]) / hr[c];
+
+                    apply(viewB, args)[a] = factor * (apply(viewB, args)[a] - dt * curl);
+                }
+            });
+
+        IpplTimings::stopTimer(bTimer);
+    }
+
+    template <typename EField, typename BField>
+    void FDTDSolver<EField, BField>::advanceE(T dt) {
+        lhs_type& E = *this->lhs_mp;
+        rhs_type& J = *this->rhs_mp;
+
+        const auto viewB  = std::as_const(*B_mp).getView();
+        const auto viewJ  = std::as_const(J).getView();
+        auto viewE        = E.getView();
+        const int nghost  = E.getNghost();
+        const int nghostJ = J.getNghost();
+
+        const vector_type& hr = E.get_mesh().getMeshSpacing();
+        const auto& ldom      = E.getLayout().getLocalNDIndex();
+        const auto& domain    = E.getLayout().getDomain();
+
+        const bool absorbing = this->params_m.template get<int>("boundary") == ABSORBING;
+        const int layers     = this->params_m.template get<int>("absorbing_layers");
+        const T cLight       = this->params_m.template get<double>("c");
+        const T eps0         = this->params_m.template get<double>("epsilon0");
+        const T reflection   = this->params_m.template get<double>("absorbing_reflection");
+        const T c2           = cLight * cLight;
+
+        const T sigmaDtH = absorbing ? -2 * cLight * Kokkos::log(reflection) / layers * dt : 0;
+
+        Vector<int, Dim> n;
+        Vector<T, Dim> sigmaDt;
+        for (unsigned d = 0; d < Dim; ++d) {
+            n[d]       = domain[d].length();
+            sigmaDt[d] = sigmaDtH / hr[d];
+        }
+
+        static IpplTimings::TimerRef eTimer = IpplTimings::getTimer("FDTD: Advance E");
+        IpplTimings::startTimer(eTimer);
+
+        using index_array_type = typename RangePolicy<Dim>::index_array_type;
+        ippl::parallel_for(
+            "FDTDSolver: advance E", getRangePolicy(viewE, nghost),
+            KOKKOS_LAMBDA(const index_array_type& args) {
+                Vector<int, Dim> ig = args - nghost;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    ig[d] += ldom[d].first();
+                }
+                const T factor = damping(ig, n, layers, sigmaDt);
+
+                index_array_type argsJ = args;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    argsJ[d] += nghostJ - nghost;
+                }
+
+                for (unsigned a = 0; a < Dim; ++a) {
+                    const unsigned b = (a + 1) % Dim;
+                    const unsigned c = (a + 2) % Dim;
+
+                    index_array_type lowB = args, lowC = args;
+                    lowB[b] -= 1;
+                    lowC[c] -= 1;
+
+                    const T curl = (apply(viewB, args)[c] - apply(viewB, lowB)[c]) / hr[b]
+                                   - (apply(viewB, args)[b] - apply(viewB, lowC)[b]) / hr[c];
+
+                    const T source = c2 * curl - apply(viewJ, argsJ)[a] / eps0;
+
+                    apply(viewE, args)[a] = factor * (apply(viewE, args)[a] + dt * source);
+                }
+            });
+
+        IpplTimings::stopTimer(eTimer);
+    }
+
+    template <typename EField, typename BField>
+    template <typename Q, typename P, class... Properties>
+    void FDTDSolver<EField, BField>::depositCurrent(
+        const ParticleAttrib<Q, Properties...>& q,
+        const ParticleAttrib<Vector<P, Dim>, Properties...>& R0,
+        const ParticleAttrib<Vector<P, Dim>, Properties...>& R1) {
+        rhs_type& J = *this->rhs_mp;
+
+        const int nghost = J.getNghost();
+        if (nghost < 2) {
+            throw IpplException("FDTDSolver::depositCurrent",
+                                "The current density must have two ghost layers");
+        }
+
+        static IpplTimings::TimerRef depositTimer = IpplTimings::getTimer("FDTD: Deposit");
+        IpplTimings::startTimer(depositTimer);
+
+        auto viewJ       = J.getView();
+        const auto viewQ = q.getView();
+        const auto view0 = R0.getView();
+        const auto view1 = R1.getView();
+
+        const vector_type& hr     = J.get_mesh().getMeshSpacing();
+        const vector_type& origin = J.get_mesh().getOrigin();
+        const auto& ldom          = J.getLayout().getLocalNDIndex();
+        const T dt                = getTimeStep();
+
+        using index_array_type = typename RangePolicy<Dim>::index_array_type;
+        using policy_type      = Kokkos::RangePolicy<typename EField::execution_space>;
+        Kokkos::parallel_for(
+            "FDTDSolver: deposit current", policy_type(0, q.getParticleCount()),
+            KOKKOS_LAMBDA(const size_t idx) {
+                // positions relative to the lattice points, which are the cell centers
+                Vector<T, Dim> s0, s1, sr;
+                Vector<int, Dim> i0, i1;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    s0[d] = (view0(idx)[d] - origin[d]) / hr[d] - 0.5;
+                    s1[d] = (view1(idx)[d] - origin[d]) / hr[d] - 0.5;
+                    i0[d] = Kokkos::floor(s0[d]);
+                    i1[d] = Kokkos::floor(s1[d]);
+
+                    // the path is split at the cell boundary, or in the middle if the
+                    // particle stays in its cell
+                    sr[d] = Kokkos::min(Kokkos::min(i0[d], i1[d]) + T(1),
+                                        Kokkos::max(T(Kokkos::max(i0[d], i1[d])),
+                                                    T(0.5) * (s0[d] + s1[d])));
+                }
+
+                // each part of the path lies in a single cell; its current is
+                // assigned to the faces around the path with linear weights
+                for (unsigned part = 0; part < 2; ++part) {
+                    const Vector<int, Dim>& cell = part == 0 ? i0 : i1;
+                    const Vector<T, Dim>& begin  = part == 0 ? s0 : sr;
+                    const Vector<T, Dim>& end    = part == 0 ? sr : s1;
+
+                    Vector<T, Dim> w;
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        w[d] = T(0.5) * (begin[d] + end[d]) - cell[d];
+                    }
+
+                    for (unsigned a = 0; a < Dim; ++a) {
+                        const unsigned b = (a + 1) % Dim;
+                        const unsigned c = (a + 2) % Dim;
+
+                        const T flux = viewQ(idx) * (end[a] - begin[a]) / (dt * hr[b] * hr[c]);
+
+                        for (int mb = 0; mb < 2; ++mb) {
+                            for (int mc = 0; mc < 2; ++mc) {
+                                index_array_type args;
+                                for (unsigned d = 0; d < Dim; ++d) {
+                                    args[d] = cell[d] - ldom[d].first() + nghost;
+                                }
+                                args[b] += mb;
+                                args[c] += mc;
+
+                                const T weight = (mb ? w[b] : 1 - w[b]) * (mc ? w[c] : 1 - w[c]);
+                                Kokkos::atomic_add(&apply(viewJ, args)[a], flux * weight);
+                            }
+                        }
+                    }
+                }
+            });
+
+        IpplTimings::stopTimer(depositTimer);
+
+        static IpplTimings::TimerRef accumulateHaloTimer = IpplTimings::getTimer("accumulateHalo");
+        IpplTimings::startTimer(accumulateHaloTimer);
+        J.accumulateHalo();
+        IpplTimings::stopTimer(accumulateHaloTimer);
+
+        // clear the ghost layers, so that the next deposition does not add
+        // their contributions to the neighbors again
+        Vector<int, Dim> extent;
+        for (unsigned d = 0; d < Dim; ++d) {
+            extent[d] = viewJ.extent(d);
+        }
+        ippl::parallel_for(
+            "FDTDSolver: clear current ghosts", getRangePolicy(viewJ),
+            KOKKOS_LAMBDA(const index_array_type& args) {
+                bool ghost = false;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    ghost = ghost || (int)args[d] < nghost || (int)args[d] >= extent[d] - nghost;
+                }
+                if (ghost) {
+                    apply(viewJ, args) = Vector<T, Dim>(0);
+                }
+            });
+    }
+
+    template <typename EField, typename BField>
+    typename FDTDSolver<EField, BField>::T FDTDSolver<EField, BField>::getFieldEnergy() {
+        const auto viewE = std::as_const(*this->lhs_mp).getView();
+        const auto viewB = std::as_const(*B_mp).getView();
+        const int nghost = this->lhs_mp->getNghost();
+
+        const T c    = this->params_m.template get<double>("c");
+        const T eps0 = this->params_m.template get<double>("epsilon0");
+        const T c2   = c * c;
+
+        using index_array_type = typename RangePolicy<Dim>::index_array_type;
+        T localEnergy          = 0;
+        ippl::parallel_reduce(
+            "FDTDSolver: field energy", getRangePolicy(viewE, nghost),
+            KOKKOS_LAMBDA(const index_array_type& args, T& val) {
+                for (unsigned a = 0; a < Dim; ++a) {
+                    val += apply(viewE, args)[a] * apply(viewE, args)[a]
+                           + c2 * apply(viewB, args)[a] * apply(viewB, args)[a];
+                }
+            },
+            Kokkos::Sum<T>(localEnergy));
+
+        T energy          = 0;
+        MPI_Datatype type = get_mpi_datatype<T>(localEnergy);
+        MPI_Allreduce(&localEnergy, &energy, 1, type, MPI_SUM, Comm->getCommunicator());
+
+        T volume              = 1;
+        const vector_type& hr = this->lhs_mp->get_mesh().getMeshSpacing();
+        for (unsigned d = 0; d < Dim; ++d) {
+            volume *= hr[d];
+        }
+        return 0.5 * eps0 * energy * volume;
+    }
+}  // namespace ippl
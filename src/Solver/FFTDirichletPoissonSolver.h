@@ -0,0 +1,24 @@
+//
+// Class FFTDirichletPoissonSolver
+//   FFT-based Poisson solver for a box with homogeneous Dirichlet boundaries (grounded
+//   conducting box) using the sine transform.
+//   Solves laplace(phi) = -rho, and E = -grad(phi).
+//
+
+#ifndef IPPL_FFT_DIRICHLET_POISSON_SOLVER_H
+#define IPPL_FFT_DIRICHLET_POISSON_SOLVER_H
+
+#include "Solver/FFTTrigPoissonSolver.h"
+
+namespace ippl {
+
+    template <typename FieldLHS, typename FieldRHS>
+    class FFTDirichletPoissonSolver : public FFTTrigPoissonSolver<FieldLHS, FieldRHS, SineTransform> {
+        using Base = FFTTrigPoissonSolver<FieldLHS, FieldRHS, SineTransform>;
+
+    public:
+        using Base::Base;
+    };
+}  // namespace ippl
+
+#endif
@@ -0,0 +1,179 @@
+//
+// Class FFTMixedPoissonSolver
+//   FFT-based Poisson solver for boundaries that are periodic in one dimension
+//   and open in the others, e.g. a bunched beam in a periodic lattice.
+//   Solves laplace(phi) = -rho, and E = -grad(phi).
+//
+//   Only the open dimensions are doubled for the zero-padded convolution, while
+//   the periodic dimension is transformed at its physical size. The Green's
+//   function is periodic in that dimension: each of its Fourier modes k is the
+//   free-space Green's function K0(|k| r) / (2 pi) of the screened Poisson equation
+//   in the open plane, and -ln(r) / (2 pi) for k = 0. As for any system that is
+//   periodic in one dimension, the potential is only defined up to a constant
+//   proportional to the total charge; the gradient is unaffected.
+//
+
+#ifndef IPPL_FFT_MIXED_POISSON_SOLVER_H
+#define IPPL_FFT_MIXED_POISSON_SOLVER_H
+
+#include <Kokkos_MathematicalConstants.hpp>
+#include <Kokkos_MathematicalSpecialFunctions.hpp>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "Types/Vector.h"
+
+#include "Utility/IpplException.h"
+#include "Utility/IpplTimings.h"
+
+#include "Field/Field.h"
+
+#include "Communicate/Archive.h"
+#include "Electrostatics.h"
+#include "FFT/FFT.h"
+#include "Field/HaloCells.h"
+#include "Field/Redistribution.h"
+#include "FieldLayout/FieldLayout.h"
+#include "GreensFunctions.h"
+#include "Meshes/UniformCartesian.h"
+
+namespace ippl {
+
+    template <typename FieldLHS, typename FieldRHS>
+    class FFTMixedPoissonSolver : public Electrostatics<FieldLHS, FieldRHS> {
+        constexpr static unsigned Dim = FieldLHS::dim;
+        using Trhs                    = typename FieldRHS::value_type;
+        using mesh_type               = typename FieldLHS::Mesh_t;
+
+    public:
+        using Base = Electrostatics<FieldLHS, FieldRHS>;
+        using typename Base::lhs_type, typename Base::rhs_type;
+
+        typedef FFT<RCTransform, FieldRHS> FFT_t;
+        typedef FieldRHS Field_t;
+        typedef typename FFT_t::ComplexField CxField_t;
+        typedef FieldLayout<Dim> FieldLayout_t;
+
+        using memory_space = typename FieldLHS::memory_space;
+        using buffer_type  = Communicate::buffer_type<memory_space>;
+
+        using vector_type = typename mesh_type::vector_type;
+        using scalar_type = typename mesh_type::value_type;
+
+        FFTMixedPoissonSolver();
+        FFTMixedPoissonSolver(rhs_type& rhs, ParameterList& params);
+        FFTMixedPoissonSolver(lhs_type& lhs, rhs_type& rhs, ParameterList& params);
+        ~FFTMixedPoissonSolver() = default;
+
+        void setRhs(rhs_type& rhs) override;
+
+        void solve() override;
+
+        /*!
+         * Query whether a dimension is periodic
+         * @param d the dimension
+         * @return Whether the boundaries in the dimension are periodic
+         */
+        bool isPeriodic(unsigned d) const { return periodic_m[d]; }
+
+    private:
+        // function called when the RHS is set to initialize the fields
+        void initializeFields();
+
+        // compute the transformed Green's function for the current mesh spacing
+        void greensFunction();
+
+        /*!
+         * Copies the part of a field that lies in another layout's domains into the
+         * field on that layout, communicating with the ranks that own the data
+         * @param sends the blocks of the source field to send
+         * @param recvs the blocks of the destination field to receive
+         * @param src view of the field to copy from
+         * @param srcLayout layout of the source field
+         * @param nghostSrc number of ghost cells of the source field
+         * @param dst view of the field to copy to
+         * @param dstLayout layout of the destination field
+         * @param nghostDst number of ghost cells of the destination field
+         * @param component the vector component of the destination to write, if it
+         * is a vector field
+         */
+        template <typename DstView>
+        void transfer(const std::vector<detail::CommBlock<Dim>>& sends,
+                      const std::vector<detail::CommBlock<Dim>>& recvs,
+                      const typename Field_t::view_type& src, const FieldLayout_t& srcLayout,
+                      int nghostSrc, const DstView& dst, const FieldLayout_t& dstLayout,
+                      int nghostDst, size_t component = 0);
+
+        // zero-padded charge density, doubled in the open dimensions;
+        // also holds the solution and the gradient components on that grid
+        Field_t rho2_m;
+
+        // transformed charge density, Green's function and gradient component
+        CxField_t rho2tr_m;
+        CxField_t grntr_m;
+        CxField_t temp_m;
+
+        std::unique_ptr<FFT_t> fft_m;
+
+        // mesh and layout of the RHS
+        mesh_type* mesh_mp;
+        FieldLayout_t* layout_mp;
+
+        // mesh and layout of the padded grid and of its transform
+        std::unique_ptr<mesh_type> mesh2_m;
+        std::unique_ptr<FieldLayout_t> layout2_m;
+        std::unique_ptr<mesh_type> meshComplex_m;
+        std::unique_ptr<FieldLayout_t> layoutComplex_m;
+
+        // from the physical to the padded grid; reversed for the way back
+        detail::CommPlan<Dim> doublePlan_m;
+
+        // mesh spacing, physical grid size and padded grid size
+        vector_type hr_m;
+        Vector<int, Dim> nr_m;
+        Vector<int, Dim> n2_m;
+
+        // boundary type of each dimension and the periodic dimension
+        std::array<bool, Dim> periodic_m;
+        unsigned periodicDim_m;
+
+        // buffer for communication
+        detail::FieldBufferData<Trhs> fd_m;
+
+    protected:
+        virtual void setDefaultParameters() override {
+            using heffteBackend       = typename FFT_t::heffteBackend;
+            heffte::plan_options opts = heffte::default_options<heffteBackend>();
+            this->params_m.add("use_pencils", opts.use_pencils);
+            this->params_m.add("use_reorder", opts.use_reorder);
+            this->params_m.add("use_gpu_aware", opts.use_gpu_aware);
+            this->params_m.add("r2c_direction", 0);
+
+            switch (opts.algorithm) {
+                case heffte::reshape_algorithm::alltoall:
+                    this->params_m.add("comm", a2a);
+                    break;
+                case heffte::reshape_algorithm::alltoallv:
+                    this->params_m.add("comm", a2av);
+                    break;
+                case heffte::reshape_algorithm::p2p:
+                    this->params_m.add("comm", p2p);
+                    break;
+                case heffte::reshape_algorithm::p2p_plined:
+                    this->params_m.add("comm", p2p_pl);
+                    break;
+                default:
+                    throw IpplException("FFTMixedPoissonSolver::setDefaultParameters",
+                                        "Unrecognized heffte communication type");
+            }
+
+            // bit d is set if dimension d is periodic; periodic in z by default
+            this->params_m.add("periodic_dims", 0b100);
+        }
+    };
+}  // namespace ippl
+
+#include "Solver/FFTMixedPoissonSolver.hpp"
+
+#endif
@@ -0,0 +1,378 @@
+//
+// Class FFTMixedPoissonSolver
+//   FFT-based Poisson solver for boundaries that are periodic in one dimension
+//   and open in the others.
+//
+
+namespace ippl {
+
+    /////////////////////////////////////////////////////////////////////////
+    // constructors
+    template <typename FieldLHS, typename FieldRHS>
+    FFTMixedPoissonSolver<FieldLHS, FieldRHS>::FFTMixedPoissonSolver()
+        : Base()
+        , mesh_mp(nullptr)
+        , layout_mp(nullptr) {
+        static_assert(Dim == 3, "FFTMixedPoissonSolver only supports 3D");
+        setDefaultParameters();
+    }
+
+    template <typename FieldLHS, typename FieldRHS>
+    FFTMixedPoissonSolver<FieldLHS, FieldRHS>::FFTMixedPoissonSolver(rhs_type& rhs,
+                                                                     ParameterList& params)
+        : mesh_mp(nullptr)
+        , layout_mp(nullptr) {
+        static_assert(Dim == 3, "FFTMixedPoissonSolver only supports 3D");
+        using T = typename FieldLHS::value_type::value_type;
+        static_assert(std::is_floating_point<T>::value, "Not a floating point type");
+
+        setDefaultParameters();
+        this->params_m.merge(params);
+        this->params_m.update("output_type", Base::SOL);
+
+        this->setRhs(rhs);
+    }
+
+    template <typename FieldLHS, typename FieldRHS>
+    FFTMixedPoissonSolver<FieldLHS, FieldRHS>::FFTMixedPoissonSolver(lhs_type& lhs, rhs_type& rhs,
+                                                                     ParameterList& params)
+        : mesh_mp(nullptr)
+        , layout_mp(nullptr) {
+        static_assert(Dim == 3, "FFTMixedPoissonSolver only supports 3D");
+        using T = typename FieldLHS::value_type::value_type;
+        static_assert(std::is_floating_point<T>::value, "Not a floating point type");
+
+        setDefaultParameters();
+        this->params_m.merge(params);
+
+        this->setLhs(lhs);
+        this->setRhs(rhs);
+    }
+
+    template <typename FieldLHS, typename FieldRHS>
+    void FFTMixedPoissonSolver<FieldLHS, FieldRHS>::setRhs(rhs_type& rhs) {
+        Base::setRhs(rhs);
+
+        static IpplTimings::TimerRef initialize = IpplTimings::getTimer("Initialize");
+        IpplTimings::startTimer(initialize);
+
+        initializeFields();
+
+        IpplTimings::stopTimer(initialize);
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // initializeFields method, called when the RHS is set
+    template <typename FieldLHS, typename FieldRHS>
+    void FFTMixedPoissonSolver<FieldLHS, FieldRHS>::initializeFields() {
+        const int periodic = this->params_m.template get<int>("periodic_dims");
+
+        unsigned periodicCount = 0;
+        for (unsigned d = 0; d < Dim; ++d) {
+            periodic_m[d] = (periodic >> d) & 1;
+            if (periodic_m[d]) {
+                periodicDim_m = d;
+                ++periodicCount;
+            }
+        }
+        if (periodicCount != 1) {
+            throw IpplException("FFTMixedPoissonSolver::initializeFields()",
+                                "Exactly one periodic dimension is supported; use "
+                                "FFTPoissonSolver for open and FFTPeriodicPoissonSolver "
+                                "for periodic boundaries");
+        }
+
+        layout_mp = &(this->rhs_mp->getLayout());
+        mesh_mp   = &(this->rhs_mp->get_mesh());
+
+        hr_m               = mesh_mp->getMeshSpacing();
+        vector_type origin = mesh_mp->getOrigin();
+
+        // only the open dimensions are doubled for the zero padding
+        const NDIndex<Dim>& domain = layout_mp->getDomain();
+        NDIndex<Dim> domain2;
+        for (unsigned d = 0; d < Dim; ++d) {
+            nr_m[d]    = domain[d].length();
+            n2_m[d]    = periodic_m[d] ? nr_m[d] : 2 * nr_m[d];
+            domain2[d] = Index(n2_m[d]);
+        }
+
+        e_dim_tag decomp[Dim];
+        for (unsigned d = 0; d < Dim; ++d) {
+            decomp[d] = layout_mp->getRequestedDistribution(d);
+        }
+
+        mesh2_m   = std::make_unique<mesh_type>(domain2, hr_m, origin);
+        layout2_m = std::make_unique<FieldLayout_t>(domain2, decomp);
+
+        // the blocks exchanged between the physical and the padded grid
+        doublePlan_m = detail::makeCommPlan(*layout_mp, *layout2_m);
+
+        // one of the dimensions has only (n/2 + 1) points as the fields are real
+        const unsigned RCDirection = this->params_m.template get<int>("r2c_direction");
+        NDIndex<Dim> domainComplex;
+        for (unsigned d = 0; d < Dim; ++d) {
+            domainComplex[d] = Index(d == RCDirection ? n2_m[d] / 2 + 1 : n2_m[d]);
+        }
+
+        meshComplex_m   = std::make_unique<mesh_type>(domainComplex, hr_m, origin);
+        layoutComplex_m = std::make_unique<FieldLayout_t>(domainComplex, decomp);
+
+        rho2_m.initialize(*mesh2_m, *layout2_m);
+        rho2tr_m.initialize(*meshComplex_m, *layoutComplex_m);
+        grntr_m.initialize(*meshComplex_m, *layoutComplex_m);
+
+        const int out = this->params_m.template get<int>("output_type");
+        if (out == Base::GRAD || out == Base::SOL_AND_GRAD) {
+            temp_m.initialize(*meshComplex_m, *layoutComplex_m);
+        }
+
+        fft_m = std::make_unique<FFT_t>(*layout2_m, *layoutComplex_m, this->params_m);
+
+        static IpplTimings::TimerRef ginit = IpplTimings::getTimer("Green Init");
+        IpplTimings::startTimer(ginit);
+        greensFunction();
+        IpplTimings::stopTimer(ginit);
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // compute the electric potential and/or field given a charge density
+    template <typename FieldLHS, typename FieldRHS>
+    void FFTMixedPoissonSolver<FieldLHS, FieldRHS>::solve() {
+        static IpplTimings::TimerRef solve = IpplTimings::getTimer("Solve");
+        IpplTimings::startTimer(solve);
+
+        const int out = this->params_m.template get<int>("output_type");
+
+        // recompute the Green's function if the mesh spacing has changed
+        mesh_mp    = &(this->rhs_mp->get_mesh());
+        bool green = false;
+        for (unsigned d = 0; d < Dim; ++d) {
+            if (hr_m[d] != mesh_mp->getMeshSpacing(d)) {
+                hr_m[d] = mesh_mp->getMeshSpacing(d);
+                green   = true;
+            }
+        }
+        if (green) {
+            mesh2_m->setMeshSpacing(hr_m);
+            meshComplex_m->setMeshSpacing(hr_m);
+            greensFunction();
+        }
+
+        auto view1        = this->rhs_mp->getView();
+        auto view2        = rho2_m.getView();
+        const int nghost1 = this->rhs_mp->getNghost();
+        const int nghost2 = rho2_m.getNghost();
+
+        // store rho in the physical part of the padded grid; the rest of the grid
+        // is treated as zero by the forward FFT
+        static IpplTimings::TimerRef stod = IpplTimings::getTimer("Solve: Physical to double");
+        IpplTimings::startTimer(stod);
+        transfer(doublePlan_m.sends, doublePlan_m.recvs, view1, *layout_mp, nghost1, view2,
+                 *layout2_m, nghost2);
+        IpplTimings::stopTimer(stod);
+
+        const NDIndex<Dim>& physical = layout_mp->getDomain();
+
+        static IpplTimings::TimerRef fftrho = IpplTimings::getTimer("FFT: Rho");
+        IpplTimings::startTimer(fftrho);
+        fft_m->transform(FORWARD, rho2_m, rho2tr_m, physical);
+        IpplTimings::stopTimer(fftrho);
+
+        // convolution becomes multiplication in Fourier space
+        rho2tr_m = rho2tr_m * grntr_m;
+
+        // both forward transforms are normalized by the number of points; the
+        // convolution sum is also weighted by the cell volume
+        Trhs normalization = 1.0;
+        for (unsigned d = 0; d < Dim; ++d) {
+            normalization *= n2_m[d] * hr_m[d];
+        }
+
+        if ((out == Base::SOL) || (out == Base::SOL_AND_GRAD)) {
+            static IpplTimings::TimerRef fftc = IpplTimings::getTimer("FFT: Convolution");
+            IpplTimings::startTimer(fftc);
+            fft_m->transform(BACKWARD, rho2_m, rho2tr_m, physical, normalization);
+            IpplTimings::stopTimer(fftc);
+
+            // the potential is stored in the RHS
+            static IpplTimings::TimerRef dtos = IpplTimings::getTimer("Solve: Double to physical");
+            IpplTimings::startTimer(dtos);
+            transfer(doublePlan_m.recvs, doublePlan_m.sends, view2, *layout2_m, nghost2, view1,
+                     *layout_mp, nghost1);
+            IpplTimings::stopTimer(dtos);
+        }
+
+        if ((out == Base::GRAD) || (out == Base::SOL_AND_GRAD)) {
+            static IpplTimings::TimerRef efield = IpplTimings::getTimer("Solve: Electric field");
+            IpplTimings::startTimer(efield);
+
+            auto viewL        = this->lhs_mp->getView();
+            const int nghostL = this->lhs_mp->getNghost();
+
+            auto viewR        = rho2tr_m.getView();
+            auto viewT        = temp_m.getView();
+            const int nghostR = rho2tr_m.getNghost();
+            const auto& ldomR = layoutComplex_m->getLocalNDIndex();
+
+            const scalar_type pi          = Kokkos::numbers::pi_v<scalar_type>;
+            const Kokkos::complex<Trhs> I = {0.0, 1.0};
+
+            vector_type hsize  = hr_m;
+            Vector<int, Dim> N = n2_m;
+
+            using index_array_type = typename RangePolicy<Dim>::index_array_type;
+            for (unsigned gd = 0; gd < Dim; ++gd) {
+                // multiply by -ik (gradient in Fourier space); the wave numbers
+                // of the open dimensions are those of the doubled grid
+                ippl::parallel_for(
+                    "Gradient FFTMixedPoissonSolver", getRangePolicy(viewR, nghostR),
+                    KOKKOS_LAMBDA(const index_array_type& args) {
+                        const int ig      = args[gd] - nghostR + ldomR[gd].first();
+                        const bool shift  = (ig > N[gd] / 2);
+                        const bool notMid = (2 * ig != N[gd]);
+
+                        const scalar_type k =
+                            notMid * 2 * pi / (N[gd] * hsize[gd]) * (ig - shift * N[gd]);
+
+                        apply(viewT, args) = -(I * k) * apply(viewR, args);
+                    });
+
+                static IpplTimings::TimerRef ffte = IpplTimings::getTimer("FFT: Efield");
+                IpplTimings::startTimer(ffte);
+                fft_m->transform(BACKWARD, rho2_m, temp_m, physical, normalization);
+                IpplTimings::stopTimer(ffte);
+
+                transfer(doublePlan_m.recvs, doublePlan_m.sends, view2, *layout2_m, nghost2, viewL,
+                         *layout_mp, nghostL, gd);
+            }
+
+            IpplTimings::stopTimer(efield);
+        }
+
+        IpplTimings::stopTimer(solve);
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // compute the transformed Green's function, periodic in one dimension
+    template <typename FieldLHS, typename FieldRHS>
+    void FFTMixedPoissonSolver<FieldLHS, FieldRHS>::greensFunction() {
+        const scalar_type pi = Kokkos::numbers::pi_v<scalar_type>;
+
+        // the open dimensions a, b and the periodic dimension p
+        const unsigned p = periodicDim_m;
+        const unsigned a = (p + 1) % Dim;
+        const unsigned b = (p + 2) % Dim;
+
+        const NDIndex<Dim>& ldom = layout2_m->getLocalNDIndex();
+        const int nA             = ldom[a].length();
+        const int nB             = ldom[b].length();
+        const int nModes         = nr_m[p] / 2 + 1;
+
+        const scalar_type length = nr_m[p] * hr_m[p];
+        const scalar_type ha     = hr_m[a];
+        const scalar_type hb     = hr_m[b];
+        const int firstA         = ldom[a].first();
+        const int firstB         = ldom[b].first();
+        const int sizeA          = nr_m[a];
+        const int sizeB          = nr_m[b];
+        const int sizeP          = nr_m[p];
+
+        // the singularity at r = 0 is replaced by the average of ln(r) over the cell
+        const scalar_type rEff = Kokkos::exp(detail::cellAverageLog(ha, hb));
+
+        // Fourier modes of the Green's function at each point of the local open plane,
+        // one column of modes per point
+        using Complex_t   = typename FFT_t::Complex_t;
+        const int columns = nA * nB;
+        Kokkos::View<Complex_t**, Kokkos::LayoutRight, memory_space> modes(
+            "Green's function modes", columns, nModes);
+        using mdrange_type =
+            Kokkos::MDRangePolicy<Kokkos::Rank<3>, typename Field_t::execution_space>;
+        Kokkos::parallel_for(
+            "Green's function modes FFTMixedPoissonSolver",
+            mdrange_type({0, 0, 0}, {nA, nB, nModes}),
+            KOKKOS_LAMBDA(const int i, const int j, const int m) {
+                // distance to the origin with the mirrored second half of the padded grid
+                const int ig = i + firstA;
+                const int jg = j + firstB;
+                const int da = (ig < sizeA) ? ig : 2 * sizeA - ig;
+                const int db = (jg < sizeB) ? jg : 2 * sizeB - jg;
+
+                scalar_type r = Kokkos::sqrt((da * ha) * (da * ha) + (db * hb) * (db * hb));
+                r             = (r == 0) ? rEff : r;
+
+                scalar_type g;
+                if (m == 0) {
+                    g = -Kokkos::log(r) / (2 * pi);
+                } else {
+                    const scalar_type k = 2 * pi * m / length;
+                    g = Kokkos::Experimental::cyl_bessel_k0<Kokkos::complex<scalar_type>,
+                                                             scalar_type, int>(
+                            Kokkos::complex<scalar_type>(k * r, 0))
+                            .real()
+                        / (2 * pi);
+                }
+
+                modes(i + nA * j, m) = g / length;
+            });
+
+        // The Fourier series along the periodic dimension is summed by a batch of
+        // real 1D transforms on this rank, one per column. The modes are real and
+        // even, so the negative modes are those implied by the real transform.
+        using heffteBackend = typename FFT_t::heffteBackend;
+        using plan_type     = heffte::fft3d_r2c<heffteBackend, long long>;
+
+        const long long np                  = sizeP;
+        heffte::box3d<long long> box        = {{0, 0, 0}, {np - 1, 0, 0}, {0, 1, 2}};
+        heffte::box3d<long long> boxComplex = {{0, 0, 0}, {np / 2, 0, 0}, {0, 1, 2}};
+        plan_type series(box, boxComplex, 0, MPI_COMM_SELF,
+                         heffte::default_options<heffteBackend>());
+
+        Kokkos::View<Trhs**, Kokkos::LayoutRight, memory_space> values("Green's function columns",
+                                                                      columns, sizeP);
+        if (columns > 0) {
+            typename plan_type::template buffer_container<Complex_t> workspace(
+                columns * series.size_workspace());
+            series.backward(columns, modes.data(), values.data(), workspace.data(),
+                            heffte::scale::none);
+        }
+
+        auto view        = rho2_m.getView();
+        const int nghost = rho2_m.getNghost();
+
+        using index_array_type = typename RangePolicy<Dim>::index_array_type;
+        ippl::parallel_for(
+            "Green's function FFTMixedPoissonSolver", rho2_m.getFieldRangePolicy(),
+            KOKKOS_LAMBDA(const index_array_type& args) {
+                const int i  = args[a] - nghost;
+                const int j  = args[b] - nghost;
+                const int kg = args[p] - nghost + ldom[p].first();
+
+                apply(view, args) = values(i + nA * j, kg);
+            });
+
+        static IpplTimings::TimerRef fftg = IpplTimings::getTimer("FFT: Green");
+        IpplTimings::startTimer(fftg);
+        fft_m->transform(FORWARD, rho2_m, grntr_m);
+        IpplTimings::stopTimer(fftg);
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // redistribution between the physical and the padded grid
+    template <typename FieldLHS, typename FieldRHS>
+    template <typename DstView>
+    void FFTMixedPoissonSolver<FieldLHS, FieldRHS>::transfer(
+        const std::vector<detail::CommBlock<Dim>>& sends,
+        const std::vector<detail::CommBlock<Dim>>& recvs, const typename Field_t::view_type& src,
+        const FieldLayout_t& srcLayout, int nghostSrc, const DstView& dst,
+        const FieldLayout_t& dstLayout, int nghostDst, size_t component) {
+        const auto& dstDom = dstLayout.getLocalNDIndex();
+
+        detail::exchange(sends, recvs, src, nghostSrc, srcLayout.getLocalNDIndex(), fd_m,
+                         OPEN_SOLVER_TAG, IPPL_SOLVER_SEND, IPPL_SOLVER_RECV,
+                         [&](const auto& block) {
+                             detail::unpack(block.domain, dst, fd_m, nghostDst, dstDom, component);
+                         });
+    }
+}  // namespace ippl
@@ -0,0 +1,24 @@
+//
+// Class FFTNeumannPoissonSolver
+//   FFT-based Poisson solver for a box with homogeneous Neumann boundaries using the
+//   cosine transform.
+//   Solves laplace(phi) = -rho, and E = -grad(phi).
+//
+
+#ifndef IPPL_FFT_NEUMANN_POISSON_SOLVER_H
+#define IPPL_FFT_NEUMANN_POISSON_SOLVER_H
+
+#include "Solver/FFTTrigPoissonSolver.h"
+
+namespace ippl {
+
+    template <typename FieldLHS, typename FieldRHS>
+    class FFTNeumannPoissonSolver : public FFTTrigPoissonSolver<FieldLHS, FieldRHS, CosTransform> {
+        using Base = FFTTrigPoissonSolver<FieldLHS, FieldRHS, CosTransform>;
+
+    public:
+        using Base::Base;
+    };
+}  // namespace ippl
+
+#endif
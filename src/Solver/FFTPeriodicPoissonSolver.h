@@ -8,6 +8,9 @@
 #define IPPL_FFT_PERIODIC_POISSON_SOLVER_H
 
 #include <Kokkos_MathematicalConstants.hpp>
+#include <memory>
+#include <variant>
+#include <vector>
 
 #include "Types/ViewTypes.h"
 
@@ -18,7 +21,13 @@
 
 namespace ippl {
 
-    template <typename FieldLHS, typename FieldRHS>
+    /*!
+     * @tparam FieldLHS the field type of the gradient
+     * @tparam FieldRHS the field type of the charge density and the potential
+     * @tparam SinglePrecision whether "single_precision" is available; it is opt-in
+     * because it instantiates the solver and the transforms for float fields
+     */
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision = false>
     class FFTPeriodicPoissonSolver : public Electrostatics<FieldLHS, FieldRHS> {
         constexpr static unsigned Dim = FieldLHS::dim;
         using Trhs                    = typename FieldRHS::value_type;
@@ -37,6 +46,12 @@ namespace ippl {
         using scalar_type = typename FieldLHS::Mesh_t::value_type;
         using vector_type = typename FieldLHS::Mesh_t::vector_type;
 
+        // the solver on single precision copies of the fields
+        using low_lhs_type =
+            typename detail::ChangeValueType<lhs_type, Vector<float, Dim>>::type;
+        using low_rhs_type    = typename detail::ChangeValueType<rhs_type, float>::type;
+        using low_solver_type = FFTPeriodicPoissonSolver<low_lhs_type, low_rhs_type>;
+
         FFTPeriodicPoissonSolver()
             : Base() {
             using T = typename FieldLHS::value_type::value_type;
@@ -59,15 +74,54 @@ namespace ippl {
 
         void solve() override;
 
+        /*!
+         * Solves for several right-hand sides on the layout of the solver's RHS,
+         * e.g. the charge densities of several species. Their transforms are done
+         * as a batch, so that the data of all fields is exchanged in the same
+         * messages. As for the output type SOL, the potentials overwrite the
+         * right-hand sides; gradients are not computed.
+         * @param rhs the right-hand sides
+         */
+        void solve(const std::vector<rhs_type*>& rhs);
+
+        /*!
+         * Estimates the relative error of the last solution due to the rounding
+         * in the transforms, which dominates if "single_precision" is set
+         * @return The relative error estimate
+         */
+        Trhs getErrorEstimate() const { return errorEstimate_m; }
+
     private:
         void initialize();
 
+        // sets up the solver on single precision copies of the RHS and the LHS
+        void initializeLowPrecision();
+
+        // converts the RHS to single precision, solves and converts the results back
+        void solveLowPrecision();
+
         std::shared_ptr<FFT_t> fft_mp;
         CxField_t fieldComplex_m;
-        CxField_t tempFieldComplex_m;
+        // transforms of the right-hand sides of a batched solve, or of the
+        // gradient components, which are transformed back as a batch
+        typename FFT_t::batch_view_type batchComplex_m;
         NDIndex<Dim> domain_m;
         std::shared_ptr<Layout_t> layoutComplex_mp;
 
+        // with "single_precision", the transforms and the multiplication in Fourier
+        // space are done by another solver on single precision copies of the fields,
+        // which is only instantiated if SinglePrecision is enabled
+        std::conditional_t<SinglePrecision, std::unique_ptr<low_solver_type>, std::monostate>
+            low_mp;
+        // the copies are created anew for each RHS and LHS, whose mesh and
+        // layout may differ from those of the previous fields
+        std::unique_ptr<low_rhs_type> lowRhs_mp;
+        std::unique_ptr<low_lhs_type> lowLhs_mp;
+        // the LHS for which lowLhs_mp has been set up
+        const lhs_type* lowLhsOf_m = nullptr;
+
+        Trhs errorEstimate_m = 0;
+
     protected:
         virtual void setDefaultParameters() override {
             using heffteBackend       = typename FFT_t::heffteBackend;
@@ -76,6 +130,7 @@ namespace ippl {
             this->params_m.add("use_reorder", opts.use_reorder);
             this->params_m.add("use_gpu_aware", opts.use_gpu_aware);
             this->params_m.add("r2c_direction", 0);
+            this->params_m.add("single_precision", false);
 
             switch (opts.algorithm) {
                 case heffte::reshape_algorithm::alltoall:
@@ -6,8 +6,8 @@
 
 namespace ippl {
 
-    template <typename FieldLHS, typename FieldRHS>
-    void FFTPeriodicPoissonSolver<FieldLHS, FieldRHS>::setRhs(rhs_type& rhs) {
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPeriodicPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::setRhs(rhs_type& rhs) {
         bool needsReinit =
             this->rhs_mp != &rhs || (this->rhs_mp && this->rhs_mp->getLayout() != rhs.getLayout());
         Base::setRhs(rhs);
@@ -16,8 +16,19 @@ namespace ippl {
         }
     }
 
-    template <typename FieldLHS, typename FieldRHS>
-    void FFTPeriodicPoissonSolver<FieldLHS, FieldRHS>::initialize() {
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPeriodicPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::initialize() {
+        if constexpr (SinglePrecision) {
+            if (this->params_m.template get<bool>("single_precision")) {
+                initializeLowPrecision();
+                return;
+            }
+            low_mp.reset();
+        } else if (this->params_m.template get<bool>("single_precision")) {
+            throw IpplException("FFTPeriodicPoissonSolver::initialize",
+                                "Single precision is not enabled for this solver");
+        }
+
         const Layout_t& layout_r = this->rhs_mp->getLayout();
         domain_m                 = layout_r.getDomain();
 
@@ -46,15 +57,60 @@ namespace ippl {
 
         fieldComplex_m.initialize(meshComplex, *layoutComplex_mp);
 
-        if (this->params_m.template get<int>("output_type") == Base::GRAD) {
-            tempFieldComplex_m.initialize(meshComplex, *layoutComplex_mp);
+        fft_mp = std::make_shared<FFT_t>(layout_r, *layoutComplex_mp, this->params_m);
+    }
+
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPeriodicPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::initializeLowPrecision() {
+        rhs_type& rhs = *this->rhs_mp;
+        lowRhs_mp =
+            std::make_unique<low_rhs_type>(rhs.get_mesh(), rhs.getLayout(), rhs.getNghost());
+
+        low_mp = std::make_unique<low_solver_type>();
+        low_mp->mergeParameters(this->params_m);
+        low_mp->updateParameter("single_precision", false);
+        low_mp->setRhs(*lowRhs_mp);
+
+        // the LHS may only be set after the RHS, so its copy is set up by the next solve
+        lowLhsOf_m = nullptr;
+    }
+
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPeriodicPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::solveLowPrecision() {
+        if (low_mp == nullptr) {
+            initializeLowPrecision();
         }
 
-        fft_mp = std::make_shared<FFT_t>(layout_r, *layoutComplex_mp, this->params_m);
+        const int out = this->params_m.template get<int>("output_type");
+        if (out == Base::GRAD && lowLhsOf_m != this->lhs_mp) {
+            lhs_type& lhs = *this->lhs_mp;
+            lowLhs_mp =
+                std::make_unique<low_lhs_type>(lhs.get_mesh(), lhs.getLayout(), lhs.getNghost());
+            low_mp->setLhs(*lowLhs_mp);
+            lowLhsOf_m = this->lhs_mp;
+        }
+
+        *lowRhs_mp = *this->rhs_mp;
+        low_mp->solve();
+
+        if (out == Base::GRAD) {
+            *this->lhs_mp = *lowLhs_mp;
+        } else {
+            *this->rhs_mp = *lowRhs_mp;
+        }
+
+        errorEstimate_m = low_mp->getErrorEstimate();
     }
 
-    template <typename FieldLHS, typename FieldRHS>
-    void FFTPeriodicPoissonSolver<FieldLHS, FieldRHS>::solve() {
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPeriodicPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::solve() {
+        if constexpr (SinglePrecision) {
+            if (this->params_m.template get<bool>("single_precision")) {
+                solveLowPrecision();
+                return;
+            }
+        }
+
         fft_mp->transform(FORWARD, *this->rhs_mp, fieldComplex_m);
 
         auto view        = fieldComplex_m.getView();
@@ -115,60 +171,145 @@ namespace ippl {
                 // Compute gradient in Fourier space and then
                 // take inverse FFT.
 
-                Complex_t imag    = {0.0, 1.0};
-                auto tempview     = tempFieldComplex_m.getView();
-                auto viewRhs      = this->rhs_mp->getView();
-                auto viewLhs      = this->lhs_mp->getView();
-                const int nghostL = this->lhs_mp->getNghost();
-
-                for (size_t gd = 0; gd < Dim; ++gd) {
-                    ippl::parallel_for(
-                        "Gradient FFTPeriodicPoissonSolver", getRangePolicy(view, nghost),
-                        KOKKOS_LAMBDA(const index_array_type& args) {
-                            Vector<int, Dim> iVec = args - nghost;
-                            for (unsigned d = 0; d < Dim; ++d) {
-                                iVec[d] += lDomComplex[d].first();
-                            }
-
-                            Vector_t kVec;
-
-                            for (size_t d = 0; d < Dim; ++d) {
-                                const scalar_type Len = rmax[d] - origin[d];
-                                bool shift            = (iVec[d] > (N[d] / 2));
-                                bool notMid           = (iVec[d] != (N[d] / 2));
-                                // For the noMid part see
-                                // https://math.mit.edu/~stevenj/fft-deriv.pdf Algorithm 1
-                                kVec[d] = notMid * 2 * pi / Len * (iVec[d] - shift * N[d]);
-                            }
-
-                            scalar_type Dr = 0;
-                            for (unsigned d = 0; d < Dim; ++d) {
-                                Dr += kVec[d] * kVec[d];
-                            }
-
-                            apply(tempview, args) = apply(view, args);
-
-                            bool isNotZero     = (Dr != 0.0);
-                            scalar_type factor = isNotZero * (1.0 / (Dr + ((!isNotZero) * 1.0)));
-
-                            apply(tempview, args) *= -(imag * kVec[gd] * factor);
-                        });
-
-                    fft_mp->transform(BACKWARD, *this->rhs_mp, tempFieldComplex_m);
-
-                    ippl::parallel_for(
-                        "Assign Gradient FFTPeriodicPoissonSolver",
-                        getRangePolicy(viewLhs, nghostL),
-                        KOKKOS_LAMBDA(const index_array_type& args) {
-                            apply(viewLhs, args)[gd] = apply(viewRhs, args);
-                        });
+                Complex_t imag = {0.0, 1.0};
+
+                // All components are formed in a single sweep, one after the other
+                // in the batch, and then transformed back together
+                using batch_view_type = typename FFT_t::batch_view_type;
+                if (batchComplex_m.size() != Dim * fieldComplex_m.getOwned().size()) {
+                    batchComplex_m = detail::batchedShrinkView<batch_view_type>(
+                        "batchComplex", view, nghost, Dim);
                 }
 
+                auto batchView        = batchComplex_m;
+                constexpr unsigned bd = detail::batchDimension<batch_view_type>();
+                const int extent      = lDomComplex[bd].length();
+
+                ippl::parallel_for(
+                    "Gradient FFTPeriodicPoissonSolver", getRangePolicy(view, nghost),
+                    KOKKOS_LAMBDA(const index_array_type& args) {
+                        Vector<int, Dim> iVec = args - nghost;
+                        for (unsigned d = 0; d < Dim; ++d) {
+                            iVec[d] += lDomComplex[d].first();
+                        }
+
+                        Vector_t kVec;
+
+                        for (size_t d = 0; d < Dim; ++d) {
+                            const scalar_type Len = rmax[d] - origin[d];
+                            bool shift            = (iVec[d] > (N[d] / 2));
+                            bool notMid           = (iVec[d] != (N[d] / 2));
+                            // For the noMid part see
+                            // https://math.mit.edu/~stevenj/fft-deriv.pdf Algorithm 1
+                            kVec[d] = notMid * 2 * pi / Len * (iVec[d] - shift * N[d]);
+                        }
+
+                        scalar_type Dr = 0;
+                        for (unsigned d = 0; d < Dim; ++d) {
+                            Dr += kVec[d] * kVec[d];
+                        }
+
+                        bool isNotZero     = (Dr != 0.0);
+                        scalar_type factor = isNotZero * (1.0 / (Dr + ((!isNotZero) * 1.0)));
+
+                        index_array_type idx = args - nghost;
+                        for (unsigned gd = 0; gd < Dim; ++gd) {
+                            apply(batchView, idx) = -(imag * kVec[gd] * factor) * apply(view, args);
+                            idx[bd] += extent;
+                        }
+                    });
+
+                fft_mp->transform(BACKWARD, *this->lhs_mp, batchComplex_m);
+
                 break;
             }
 
             default:
                 throw IpplException("FFTPeriodicPoissonSolver::solve", "Unrecognized output_type");
         }
+
+        errorEstimate_m = detail::fftErrorEstimate<Trhs>(domain_m.size());
+    }
+
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPeriodicPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::solve(
+        const std::vector<rhs_type*>& rhs) {
+        if (this->rhs_mp == nullptr) {
+            throw IpplException("FFTPeriodicPoissonSolver::solve",
+                                "The RHS must be set before a batched solve");
+        }
+        if (this->params_m.template get<bool>("single_precision")) {
+            throw IpplException("FFTPeriodicPoissonSolver::solve",
+                                "Batched solves are only done in the precision of the fields");
+        }
+        for (const rhs_type* field : rhs) {
+            if (field->getLayout() != this->rhs_mp->getLayout()) {
+                throw IpplException("FFTPeriodicPoissonSolver::solve",
+                                    "All right-hand sides must be on the layout of the RHS");
+            }
+        }
+
+        using batch_view_type = typename FFT_t::batch_view_type;
+        const size_t batch    = rhs.size();
+        if (batchComplex_m.size() != batch * fieldComplex_m.getOwned().size()) {
+            batchComplex_m = detail::batchedShrinkView<batch_view_type>(
+                "batchComplex", fieldComplex_m.getView(), fieldComplex_m.getNghost(), batch);
+        }
+
+        fft_mp->transform(FORWARD, rhs, batchComplex_m);
+
+        auto view = batchComplex_m;
+
+        scalar_type pi            = Kokkos::numbers::pi_v<scalar_type>;
+        const mesh_type& mesh     = this->rhs_mp->get_mesh();
+        const auto& lDomComplex   = layoutComplex_mp->getLocalNDIndex();
+        using vector_type         = typename mesh_type::vector_type;
+        const vector_type& origin = mesh.getOrigin();
+        const vector_type& hx     = mesh.getMeshSpacing();
+
+        vector_type rmax;
+        Vector<int, Dim> N;
+        for (size_t d = 0; d < Dim; ++d) {
+            N[d]    = domain_m[d].length();
+            rmax[d] = origin[d] + (N[d] * hx[d]);
+        }
+
+        // the transforms are stored one after the other along the batch dimension,
+        // so all of them are scaled in the same sweep
+        constexpr unsigned bd = detail::batchDimension<batch_view_type>();
+        const int extent      = lDomComplex[bd].length();
+
+        using index_array_type = typename RangePolicy<Dim>::index_array_type;
+        ippl::parallel_for(
+            "Batched solution FFTPeriodicPoissonSolver", getRangePolicy(view),
+            KOKKOS_LAMBDA(const index_array_type& args) {
+                Vector<int, Dim> iVec = args;
+                iVec[bd] %= extent;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    iVec[d] += lDomComplex[d].first();
+                }
+
+                Vector_t kVec;
+
+                for (size_t d = 0; d < Dim; ++d) {
+                    const scalar_type Len = rmax[d] - origin[d];
+                    bool shift            = (iVec[d] > (N[d] / 2));
+                    kVec[d]               = 2 * pi / Len * (iVec[d] - shift * N[d]);
+                }
+
+                scalar_type Dr = 0;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    Dr += kVec[d] * kVec[d];
+                }
+
+                bool isNotZero     = (Dr != 0.0);
+                scalar_type factor = isNotZero * (1.0 / (Dr + ((!isNotZero) * 1.0)));
+
+                apply(view, args) *= factor;
+            });
+
+        fft_mp->transform(BACKWARD, rhs, batchComplex_m);
+
+        errorEstimate_m = detail::fftErrorEstimate<Trhs>(domain_m.size());
     }
 }  // namespace ippl
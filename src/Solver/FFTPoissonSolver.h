@@ -1,6 +1,6 @@
 //
 // Class FFTPoissonSolver
-//   FFT-based Poisson Solver for open boundaries.
+//   FFT-based Poisson Solver for open boundaries in 2D and 3D.
 //   Solves laplace(phi) = -rho, and E = -grad(phi).
 //
 //
@@ -10,6 +10,10 @@
 
 #include <Kokkos_MathematicalConstants.hpp>
 #include <Kokkos_MathematicalFunctions.hpp>
+#include <Kokkos_MathematicalSpecialFunctions.hpp>
+#include <type_traits>
+#include <variant>
+#include <vector>
 
 #include "Types/Vector.h"
 
@@ -17,65 +21,35 @@
 #include "Utility/IpplTimings.h"
 
 #include "Field/Field.h"
+#include "Field/FieldPool.h"
+#include "Field/Redistribution.h"
 
 #include "Communicate/Archive.h"
 #include "Electrostatics.h"
 #include "FFT/FFT.h"
 #include "Field/HaloCells.h"
 #include "FieldLayout/FieldLayout.h"
+#include "GreensFunctionCache.h"
+#include "GreensFunctions.h"
 #include "Meshes/UniformCartesian.h"
 
 namespace ippl {
 
-    namespace detail {
-
-        /*!
-         * Access a view that either contains a vector field or a scalar field
-         * in such a way that the correct element access is determined at compile
-         * time, reducing the number of functions needed to achieve the same
-         * behavior for both kinds of fields
-         * @tparam tensorRank indicates whether scalar, vector, or matrix field
-         * @tparam - the view type
-         */
-        template <int tensorRank, typename>
-        struct ViewAccess;
-
-        template <typename View>
-        struct ViewAccess<2, View> {
-            KOKKOS_INLINE_FUNCTION constexpr static auto& get(View&& view, unsigned dim1,
-                                                              unsigned dim2, size_t i, size_t j,
-                                                              size_t k) {
-                return view(i, j, k)[dim1][dim2];
-            }
-        };
-
-        template <typename View>
-        struct ViewAccess<1, View> {
-            KOKKOS_INLINE_FUNCTION constexpr static auto& get(View&& view, unsigned dim1,
-                                                              [[maybe_unused]] unsigned dim2,
-                                                              size_t i, size_t j, size_t k) {
-                return view(i, j, k)[dim1];
-            }
-        };
-
-        template <typename View>
-        struct ViewAccess<0, View> {
-            KOKKOS_INLINE_FUNCTION constexpr static auto& get(View&& view,
-                                                              [[maybe_unused]] unsigned dim1,
-                                                              [[maybe_unused]] unsigned dim2,
-                                                              size_t i, size_t j, size_t k) {
-                return view(i, j, k);
-            }
-        };
-    }  // namespace detail
-
-    template <typename FieldLHS, typename FieldRHS>
+    /*!
+     * @tparam FieldLHS the field type of the gradient
+     * @tparam FieldRHS the field type of the charge density and the potential
+     * @tparam SinglePrecision whether "single_precision" is available; it is opt-in
+     * because it instantiates the solver and the transforms for float fields
+     */
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision = false>
     class FFTPoissonSolver : public Electrostatics<FieldLHS, FieldRHS> {
         constexpr static unsigned Dim = FieldLHS::dim;
         using Trhs                    = typename FieldRHS::value_type;
         using mesh_type               = typename FieldLHS::Mesh_t;
         using Tg                      = typename FieldLHS::value_type::value_type;
 
+        static_assert(Dim == 2 || Dim == 3, "Open boundaries are only supported in 2D and 3D");
+
     public:
         // type of output
         using Base = Electrostatics<FieldLHS, FieldRHS>;
@@ -83,17 +57,17 @@ namespace ippl {
         // types for LHS and RHS
         using typename Base::lhs_type, typename Base::rhs_type;
 
-        // define a type for the 3 dimensional real to complex Fourier transform
+        // define a type for the real to complex Fourier transform
         typedef FFT<RCTransform, FieldRHS> FFT_t;
 
-        // enum type for the algorithm
+        // enum type for the algorithm; Biharmonic is only available in 3D
         enum Algorithm {
             HOCKNEY    = 0b01,
             VICO       = 0b10,
             BIHARMONIC = 0b11
         };
 
-        // define a type for a 3 dimensional field (e.g. charge density field)
+        // define a type for a scalar field (e.g. charge density field)
         // define a type of Field with integers to be used for the helper Green's function
         // also define a type for the Fourier transformed complex valued fields
         // define matrix and matrix field types for the Hessian
@@ -118,6 +92,12 @@ namespace ippl {
         using vector_type = typename mesh_type::vector_type;
         using scalar_type = typename mesh_type::value_type;
 
+        // the solver on single precision copies of the fields
+        using low_lhs_type =
+            typename detail::ChangeValueType<lhs_type, Vector<float, Dim>>::type;
+        using low_rhs_type    = typename detail::ChangeValueType<rhs_type, float>::type;
+        using low_solver_type = FFTPoissonSolver<low_lhs_type, low_rhs_type>;
+
         // constructor and destructor
         FFTPoissonSolver();
         FFTPoissonSolver(rhs_type& rhs, ParameterList& params);
@@ -136,6 +116,17 @@ namespace ippl {
         // more specifically, compute the scalar potential given a density field rho using
         void solve() override;
 
+        /*!
+         * Solves for several charge densities on the layout of the solver's RHS,
+         * e.g. those of several species or bunches. Their transforms are done as a
+         * batch, so that the data of all fields is exchanged in the same messages,
+         * and are multiplied by the Green's function in a single kernel. As for the
+         * output type SOL, the potentials overwrite the charge densities; gradients
+         * and Hessians are not computed.
+         * @param rhs the charge densities
+         */
+        void solve(const std::vector<rhs_type*>& rhs);
+
         // override getHessian to return Hessian field if flag is on
         MField_t* getHessian() override {
             bool hessian = this->params_m.template get<bool>("hessian");
@@ -144,22 +135,66 @@ namespace ippl {
                     "FFTPoissonSolver::getHessian()",
                     "Cannot call getHessian() if 'hessian' flag in ParameterList is false");
             }
+            // the Hessian is stored in the precision of the mesh in both cases
+            if constexpr (SinglePrecision) {
+                if (low_mp != nullptr) {
+                    return low_mp->getHessian();
+                }
+            }
             return &hess_m;
         }
 
+        /*!
+         * Estimates the relative error of the last solution due to the rounding
+         * in the transforms, which dominates if "single_precision" is set
+         * @return The relative error estimate
+         */
+        Trhs getErrorEstimate() const { return errorEstimate_m; }
+
+        // the transformed Green's function, whose view may be shared with the cache
+        const CxField_t& getGreensFunction() const { return grntr_m; }
+
         // compute standard Green's function
         void greensFunction();
 
+        // obtain the Green's function from the cache, a file, or by computing it
+        void updateGreensFunction();
+
         // function called in the constructor to initialize the fields
         void initializeFields();
 
+        // update the mesh spacing from the RHS; returns whether it has changed
+        bool updateMeshSpacing();
+
+        // the normalization of the convolution, applied by the inverse FFTs
+        Trhs convolutionNormalization() const;
+
+        // copy rho to the lower left quadrant of a doubled field, which is zero elsewhere
+        void physicalToDouble(rhs_type& rho, Field_t& rho2);
+
+        // copy the lower left quadrant of a doubled field to phi
+        void doubleToPhysical(Field_t& rho2, rhs_type& phi);
+
+        // set up the solver on single precision copies of the RHS and the LHS
+        void initializeLowPrecision();
+
+        // convert the RHS to single precision, solve and convert the results back
+        void solveLowPrecision();
+
         // communication used for multi-rank Vico-Greengard's Green's function
-        void communicateVico(Vector<int, Dim> size, typename CxField_gt::view_type view_g,
-                             const ippl::NDIndex<Dim> ldom_g, const int nghost_g,
-                             typename Field_t::view_type view, const ippl::NDIndex<Dim> ldom,
-                             const int nghost);
+        void communicateVico(typename CxField_gt::view_type view_g, const ippl::NDIndex<Dim> ldom_g,
+                             const int nghost_g, typename Field_t::view_type view,
+                             const ippl::NDIndex<Dim> ldom, const int nghost);
 
     private:
+        // from the physical to the doubled grid; reversed for the way back
+        detail::CommPlan<Dim> doublePlan_m;
+
+        // from the (4N)^3 grid of the Vico Green's function to the doubled grid
+        detail::CommPlan<Dim> vicoPlan_m;
+
+        void buildVicoPlan();
+
         // create a field to use as temporary storage
         // references to it can be created to make the code where it is used readable
         Field_t storage_field;
@@ -168,16 +203,26 @@ namespace ippl {
             storage_field;  // the charge-density field with mesh doubled in each dimension
         Field_t& grn_mr = storage_field;  // the Green's function
 
+        // the transforms of the charge densities of a batched solve; the doubled
+        // charge densities beyond the first, which uses rho2_mr, are pooled
+        typename FFT_t::batch_view_type rho2trBatch_m;
+
         // rho2tr_m is the Fourier transformed charge-density field
         // domain3_m and mesh3_m are used
         CxField_t rho2tr_m;
 
         // grntr_m is the Fourier transformed Green's function
         // domain3_m and mesh3_m are used
+        // its view may be shared with the Green's function cache
         CxField_t grntr_m;
 
-        // temp_m field for the E-field computation
-        CxField_t temp_m;
+        using green_cache = GreensFunctionCache<CxField_t>;
+
+        // whether grntr_m holds the Green's function for the current setup
+        bool greenValid_m = false;
+
+        // the cache key of the Green's function for the current setup
+        typename green_cache::Key greensFunctionKey() const;
 
         // fields that facilitate the calculation in greensFunction()
         IField_t grnIField_m[Dim];
@@ -228,6 +273,20 @@ namespace ippl {
         // buffer for communication
         detail::FieldBufferData<Trhs> fd_m;
 
+        // with "single_precision", the transforms and the convolution are done
+        // by another solver on single precision copies of the fields, which is
+        // only instantiated if SinglePrecision is enabled
+        std::conditional_t<SinglePrecision, std::unique_ptr<low_solver_type>, std::monostate>
+            low_mp;
+        // the copies are created anew for each RHS and LHS, whose mesh and
+        // layout may differ from those of the previous fields
+        std::unique_ptr<low_rhs_type> lowRhs_mp;
+        std::unique_ptr<low_lhs_type> lowLhs_mp;
+        // the LHS for which lowLhs_mp has been set up
+        const lhs_type* lowLhsOf_m = nullptr;
+
+        Trhs errorEstimate_m = 0;
+
     protected:
         virtual void setDefaultParameters() override {
             using heffteBackend       = typename FFT_t::heffteBackend;
@@ -257,6 +316,15 @@ namespace ippl {
 
             this->params_m.add("algorithm", HOCKNEY);
             this->params_m.add("hessian", true);
+
+            // transform and convolve in single precision, which halves the
+            // FFT communication and workspace; see getErrorEstimate()
+            this->params_m.add("single_precision", false);
+
+            // Green's functions are shared between solvers with the same setup;
+            // if a file is given, they are also stored for later runs
+            this->params_m.add("green_cache_entries", 4);
+            this->params_m.add("green_cache_file", std::string());
         }
     };
 }  // namespace ippl
@@ -5,113 +5,12 @@
 //
 //
 
-// Communication specific functions (pack and unpack).
-template <typename Tb, typename Tf>
-void pack(const ippl::NDIndex<3> intersect, Kokkos::View<Tf***>& view,
-          ippl::detail::FieldBufferData<Tb>& fd, int nghost, const ippl::NDIndex<3> ldom,
-          ippl::Communicate::size_type& nsends) {
-    Kokkos::View<Tb*>& buffer = fd.buffer;
-
-    size_t size = intersect.size();
-    nsends      = size;
-    if (buffer.size() < size) {
-        const int overalloc = ippl::Comm->getDefaultOverallocation();
-        Kokkos::realloc(buffer, size * overalloc);
-    }
-
-    const int first0 = intersect[0].first() + nghost - ldom[0].first();
-    const int first1 = intersect[1].first() + nghost - ldom[1].first();
-    const int first2 = intersect[2].first() + nghost - ldom[2].first();
-
-    const int last0 = intersect[0].last() + nghost - ldom[0].first() + 1;
-    const int last1 = intersect[1].last() + nghost - ldom[1].first() + 1;
-    const int last2 = intersect[2].last() + nghost - ldom[2].first() + 1;
-
-    using mdrange_type = Kokkos::MDRangePolicy<Kokkos::Rank<3>>;
-    // This type casting to long int is necessary as otherwise Kokkos complains for
-    // intel compilers
-    Kokkos::parallel_for(
-        "pack()",
-        mdrange_type({first0, first1, first2}, {(long int)last0, (long int)last1, (long int)last2}),
-        KOKKOS_LAMBDA(const size_t i, const size_t j, const size_t k) {
-            const int ig = i - first0;
-            const int jg = j - first1;
-            const int kg = k - first2;
-
-            int l = ig + jg * intersect[0].length()
-                    + kg * intersect[1].length() * intersect[0].length();
-
-            Kokkos::complex<Tb> val = view(i, j, k);
-
-            buffer(l) = Kokkos::real(val);
-        });
-    Kokkos::fence();
-}
-
-template <int tensorRank, typename Tb, typename Tf>
-void unpack_impl(const ippl::NDIndex<3> intersect, const Kokkos::View<Tf***>& view,
-                 ippl::detail::FieldBufferData<Tb>& fd, int nghost, const ippl::NDIndex<3> ldom,
-                 size_t dim1 = 0, size_t dim2 = 0, bool x = false, bool y = false, bool z = false) {
-    Kokkos::View<Tb*>& buffer = fd.buffer;
-
-    const int first0 = intersect[0].first() + nghost - ldom[0].first();
-    const int first1 = intersect[1].first() + nghost - ldom[1].first();
-    const int first2 = intersect[2].first() + nghost - ldom[2].first();
-
-    const int last0 = intersect[0].last() + nghost - ldom[0].first() + 1;
-    const int last1 = intersect[1].last() + nghost - ldom[1].first() + 1;
-    const int last2 = intersect[2].last() + nghost - ldom[2].first() + 1;
-
-    using mdrange_type = Kokkos::MDRangePolicy<Kokkos::Rank<3>>;
-    Kokkos::parallel_for(
-        "pack()", mdrange_type({first0, first1, first2}, {last0, last1, last2}),
-        KOKKOS_LAMBDA(const size_t i, const size_t j, const size_t k) {
-            int ig = i - first0;
-            int jg = j - first1;
-            int kg = k - first2;
-
-            ig = x * (intersect[0].length() - 2 * ig - 1) + ig;
-            jg = y * (intersect[1].length() - 2 * jg - 1) + jg;
-            kg = z * (intersect[2].length() - 2 * kg - 1) + kg;
-
-            int l = ig + jg * intersect[0].length()
-                    + kg * intersect[1].length() * intersect[0].length();
-
-            ippl::detail::ViewAccess<tensorRank, decltype(view)>::get(view, dim1, dim2, i, j, k) =
-                buffer(l);
-        });
-    Kokkos::fence();
-}
-
-template <typename Tb, typename Tf>
-void unpack(const ippl::NDIndex<3> intersect, const Kokkos::View<Tf***>& view,
-            ippl::detail::FieldBufferData<Tb>& fd, int nghost, const ippl::NDIndex<3> ldom,
-            bool x = false, bool y = false, bool z = false) {
-    unpack_impl<0, Tb, Tf>(intersect, view, fd, nghost, ldom, 0, 0, x, y, z);
-}
-
-template <typename Tb, typename Tf>
-void unpack(const ippl::NDIndex<3> intersect, const Kokkos::View<ippl::Vector<Tf, 3>***>& view,
-            size_t dim1, ippl::detail::FieldBufferData<Tb>& fd, int nghost,
-            const ippl::NDIndex<3> ldom) {
-    unpack_impl<1, Tb, ippl::Vector<Tf, 3>>(intersect, view, fd, nghost, ldom, dim1);
-}
-
-template <typename Tb, typename Tf>
-void unpack(const ippl::NDIndex<3> intersect,
-            const Kokkos::View<ippl::Vector<ippl::Vector<Tf, 3>, 3>***>& view,
-            ippl::detail::FieldBufferData<Tb>& fd, int nghost, const ippl::NDIndex<3> ldom,
-            size_t dim1, size_t dim2) {
-    unpack_impl<2, Tb, ippl::Vector<ippl::Vector<Tf, 3>, 3>>(intersect, view, fd, nghost, ldom,
-                                                             dim1, dim2);
-}
-
 namespace ippl {
 
     /////////////////////////////////////////////////////////////////////////
     // constructor and destructor
-    template <typename FieldLHS, typename FieldRHS>
-    FFTPoissonSolver<FieldLHS, FieldRHS>::FFTPoissonSolver()
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::FFTPoissonSolver()
         : Base()
         , mesh_mp(nullptr)
         , layout_mp(nullptr)
@@ -125,8 +24,9 @@ namespace ippl {
         setDefaultParameters();
     }
 
-    template <typename FieldLHS, typename FieldRHS>
-    FFTPoissonSolver<FieldLHS, FieldRHS>::FFTPoissonSolver(rhs_type& rhs, ParameterList& params)
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::FFTPoissonSolver(rhs_type& rhs,
+                                                                            ParameterList& params)
         : mesh_mp(nullptr)
         , layout_mp(nullptr)
         , mesh2_m(nullptr)
@@ -146,9 +46,10 @@ namespace ippl {
         this->setRhs(rhs);
     }
 
-    template <typename FieldLHS, typename FieldRHS>
-    FFTPoissonSolver<FieldLHS, FieldRHS>::FFTPoissonSolver(lhs_type& lhs, rhs_type& rhs,
-                                                           ParameterList& params)
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::FFTPoissonSolver(lhs_type& lhs,
+                                                                            rhs_type& rhs,
+                                                                            ParameterList& params)
         : mesh_mp(nullptr)
         , layout_mp(nullptr)
         , mesh2_m(nullptr)
@@ -170,8 +71,8 @@ namespace ippl {
 
     /////////////////////////////////////////////////////////////////////////
     // override setRhs to call class-specific initialization
-    template <typename FieldLHS, typename FieldRHS>
-    void FFTPoissonSolver<FieldLHS, FieldRHS>::setRhs(rhs_type& rhs) {
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::setRhs(rhs_type& rhs) {
         Base::setRhs(rhs);
 
         // start a timer
@@ -187,8 +88,8 @@ namespace ippl {
     // allows user to set gradient of phi = Efield instead of spectral
     // calculation of Efield (which uses FFTs)
 
-    template <typename FieldLHS, typename FieldRHS>
-    void FFTPoissonSolver<FieldLHS, FieldRHS>::setGradFD() {
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::setGradFD() {
         // get the output type (sol, grad, or sol & grad)
         const int out = this->params_m.template get<int>("output_type");
 
@@ -204,8 +105,8 @@ namespace ippl {
     /////////////////////////////////////////////////////////////////////////
     // initializeFields method, called in constructor
 
-    template <typename FieldLHS, typename FieldRHS>
-    void FFTPoissonSolver<FieldLHS, FieldRHS>::initializeFields() {
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::initializeFields() {
         // get algorithm and hessian flag from parameter list
         const int alg      = this->params_m.template get<int>("algorithm");
         const bool hessian = this->params_m.template get<bool>("hessian");
@@ -217,11 +118,27 @@ namespace ippl {
                 "FFTPoissonSolver::initializeFields()",
                 "Currently only Hockney, Vico, and Biharmonic are supported for open BCs");
         }
+        if ((Dim != 3) && (alg == Algorithm::BIHARMONIC)) {
+            throw IpplException("FFTPoissonSolver::initializeFields()",
+                                "The Biharmonic algorithm is only available in 3D");
+        }
 
         // get layout and mesh
         layout_mp = &(this->rhs_mp->getLayout());
         mesh_mp   = &(this->rhs_mp->get_mesh());
 
+        // in single precision, the fields are set up by the solver on the copies
+        if constexpr (SinglePrecision) {
+            if (this->params_m.template get<bool>("single_precision")) {
+                initializeLowPrecision();
+                return;
+            }
+            low_mp.reset();
+        } else if (this->params_m.template get<bool>("single_precision")) {
+            throw IpplException("FFTPoissonSolver::initializeFields()",
+                                "Single precision is not enabled for this solver");
+        }
+
         // get mesh spacing and origin
         hr_m               = mesh_mp->getMeshSpacing();
         vector_type origin = mesh_mp->getOrigin();
@@ -248,6 +165,9 @@ namespace ippl {
         mesh2_m         = std::unique_ptr<mesh_type>(new mesh_type(domain2_m, hr_m, origin));
         layout2_m       = std::unique_ptr<FieldLayout_t>(new FieldLayout_t(domain2_m, decomp));
 
+        // the blocks exchanged between the physical and the doubled grid
+        doublePlan_m = detail::makeCommPlan(*layout_mp, *layout2_m);
+
         // create the domain for the transformed (complex) fields
         // since we use HeFFTe for the transforms it doesn't require permuting to the right
         // one of the dimensions has only (n/2 +1) as our original fields are fully real
@@ -271,11 +191,6 @@ namespace ippl {
         rho2tr_m.initialize(*meshComplex_m, *layoutComplex_m);
         grntr_m.initialize(*meshComplex_m, *layoutComplex_m);
 
-        int out = this->params_m.template get<int>("output_type");
-        if (((out == Base::GRAD || out == Base::SOL_AND_GRAD) && !isGradFD_m) || hessian) {
-            temp_m.initialize(*meshComplex_m, *layoutComplex_m);
-        }
-
         if (hessian) {
             hess_m.initialize(*mesh_mp, *layout_mp);
         }
@@ -299,6 +214,7 @@ namespace ippl {
             using mesh_type = typename lhs_type::Mesh_t;
             mesh4_m         = std::unique_ptr<mesh_type>(new mesh_type(domain4_m, hr_m, origin));
             layout4_m       = std::unique_ptr<FieldLayout_t>(new FieldLayout_t(domain4_m, decomp));
+            buildVicoPlan();
 
             // initialize fields
             grnL_m.initialize(*mesh4_m, *layout4_m);
@@ -328,56 +244,28 @@ namespace ippl {
                 const int size = nr_m[d];
 
                 // Kokkos parallel for loop to initialize grnIField[d]
-                switch (d) {
-                    case 0:
-                        Kokkos::parallel_for(
-                            "Helper index Green field initialization",
-                            grnIField_m[d].getFieldRangePolicy(),
-                            KOKKOS_LAMBDA(const int i, const int j, const int k) {
-                                // go from local indices to global
-                                const int ig = i + ldom[0].first() - nghost;
-                                const int jg = j + ldom[1].first() - nghost;
-                                const int kg = k + ldom[2].first() - nghost;
-
-                                // assign (index)^2 if 0 <= index < N, and (2N-index)^2 elsewhere
-                                const bool outsideN = (ig >= size);
-                                view(i, j, k) =
-                                    (2 * size * outsideN - ig) * (2 * size * outsideN - ig);
-
-                                // add 1.0 if at (0,0,0) to avoid singularity
-                                const bool isOrig = ((ig == 0) && (jg == 0) && (kg == 0));
-                                view(i, j, k) += isOrig * 1.0;
-                            });
-                        break;
-                    case 1:
-                        Kokkos::parallel_for(
-                            "Helper index Green field initialization",
-                            grnIField_m[d].getFieldRangePolicy(),
-                            KOKKOS_LAMBDA(const int i, const int j, const int k) {
-                                // go from local indices to global
-                                const int jg = j + ldom[1].first() - nghost;
-
-                                // assign (index)^2 if 0 <= index < N, and (2N-index)^2 elsewhere
-                                const bool outsideN = (jg >= size);
-                                view(i, j, k) =
-                                    (2 * size * outsideN - jg) * (2 * size * outsideN - jg);
-                            });
-                        break;
-                    case 2:
-                        Kokkos::parallel_for(
-                            "Helper index Green field initialization",
-                            grnIField_m[d].getFieldRangePolicy(),
-                            KOKKOS_LAMBDA(const int i, const int j, const int k) {
-                                // go from local indices to global
-                                const int kg = k + ldom[2].first() - nghost;
-
-                                // assign (index)^2 if 0 <= index < N, and (2N-index)^2 elsewhere
-                                const bool outsideN = (kg >= size);
-                                view(i, j, k) =
-                                    (2 * size * outsideN - kg) * (2 * size * outsideN - kg);
-                            });
-                        break;
-                }
+                using index_array_type = typename RangePolicy<Dim>::index_array_type;
+                ippl::parallel_for(
+                    "Helper index Green field initialization", getRangePolicy(view, nghost),
+                    KOKKOS_LAMBDA(const index_array_type& args) {
+                        // go from local indices to global
+                        Vector<int, Dim> iVec = args - nghost;
+                        for (unsigned e = 0; e < Dim; ++e) {
+                            iVec[e] += ldom[e].first();
+                        }
+
+                        // assign (index)^2 if 0 <= index < N, and (2N-index)^2 elsewhere
+                        const bool outsideN = (iVec[d] >= size);
+                        const int ig        = 2 * size * outsideN - iVec[d];
+                        apply(view, args)   = ig * ig;
+
+                        // add 1.0 if at the origin to avoid singularity
+                        bool isOrig = (d == 0);
+                        for (unsigned e = 0; e < Dim; ++e) {
+                            isOrig = isOrig && (iVec[e] == 0);
+                        }
+                        apply(view, args) += isOrig * 1.0;
+                    });
             }
             IpplTimings::stopTimer(initialize_hockney);
         }
@@ -396,42 +284,24 @@ namespace ippl {
         rho2tr_m = 0.0;
         grnL_m   = 0.0;
 
-        // call greensFunction and we will get the transformed G in the class attribute
-        // this is done in initialization so that we already have the precomputed fct
-        // for all timesteps (green's fct will only change if mesh size changes)
-        static IpplTimings::TimerRef ginit = IpplTimings::getTimer("Green Init");
-        IpplTimings::startTimer(ginit);
-        greensFunction();
-        IpplTimings::stopTimer(ginit);
+        // the transformed Green's function is obtained lazily in the first solve,
+        // from the cache if a solver with the same setup already computed it
+        // (green's fct will only change if mesh size changes)
+        greenValid_m = false;
     };
 
     /////////////////////////////////////////////////////////////////////////
-    // compute electric potential by solving Poisson's eq given a field rho and mesh spacings hr
-    template <typename FieldLHS, typename FieldRHS>
-    void FFTPoissonSolver<FieldLHS, FieldRHS>::solve() {
-        // start a timer
-        static IpplTimings::TimerRef solve = IpplTimings::getTimer("Solve");
-        IpplTimings::startTimer(solve);
-
-        // get the output type (sol, grad, or sol & grad)
-        const int out = this->params_m.template get<int>("output_type");
-
-        // get the algorithm (hockney, vico, or biharmonic)
-        const int alg = this->params_m.template get<int>("algorithm");
-
-        // get hessian flag (if true, we compute the Hessian)
-        const bool hessian = this->params_m.template get<bool>("hessian");
-
-        // set the mesh & spacing, which may change each timestep
+    // update the mesh spacing and the normalization of the convolution
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    bool FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::updateMeshSpacing() {
         mesh_mp = &(this->rhs_mp->get_mesh());
 
         // check whether the mesh spacing has changed with respect to the old one
-        // if yes, update and set green flag to true
-        bool green = false;
+        bool changed = false;
         for (unsigned int i = 0; i < Dim; ++i) {
             if (hr_m[i] != mesh_mp->getMeshSpacing(i)) {
                 hr_m[i] = mesh_mp->getMeshSpacing(i);
-                green   = true;
+                changed = true;
             }
         }
 
@@ -439,95 +309,69 @@ namespace ippl {
         mesh2_m->setMeshSpacing(hr_m);
         meshComplex_m->setMeshSpacing(hr_m);
 
-        // field object on the doubled grid; zero-padded
-        rho2_mr = 0.0;
-
-        // start a timer
-        static IpplTimings::TimerRef stod = IpplTimings::getTimer("Solve: Physical to double");
-        IpplTimings::startTimer(stod);
-
-        // store rho (RHS) in the lower left quadrant of the doubled grid
-        // with or without communication (if only 1 rank)
-
-        const int ranks = Comm->size();
-
-        auto view2 = rho2_mr.getView();
-        auto view1 = this->rhs_mp->getView();
-
-        const int nghost2 = rho2_mr.getNghost();
-        const int nghost1 = this->rhs_mp->getNghost();
-
-        const auto& ldom2 = layout2_m->getLocalNDIndex();
-        const auto& ldom1 = layout_mp->getLocalNDIndex();
-
-        if (ranks > 1) {
-            // COMMUNICATION
-            const auto& lDomains2 = layout2_m->getHostLocalDomains();
-
-            // send
-            std::vector<MPI_Request> requests(0);
-
-            for (int i = 0; i < ranks; ++i) {
-                if (lDomains2[i].touches(ldom1)) {
-                    auto intersection = lDomains2[i].intersect(ldom1);
-
-                    requests.resize(requests.size() + 1);
-
-                    Communicate::size_type nsends;
-                    pack(intersection, view1, fd_m, nghost1, ldom1, nsends);
+        return changed;
+    }
 
-                    buffer_type buf =
-                        Comm->getBuffer<memory_space, Trhs>(IPPL_SOLVER_SEND + i, nsends);
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    typename FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::Trhs
+    FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::convolutionNormalization() const {
+        const int alg = this->params_m.template get<int>("algorithm");
 
-                    Comm->isend(i, OPEN_SOLVER_TAG, fd_m, *buf, requests.back(), nsends);
-                    buf->resetWritePos();
-                }
+        // Hockney: multiply the rho2_mr field by the total number of points to account for
+        // double counting (rho and green) of normalization factor in forward transform
+        // also multiply by the mesh spacing^3 (to account for discretization)
+        // Vico: need to multiply by normalization factor of 1/4N^3,
+        // since only backward transform was performed on the 4N grid
+        Trhs normalization = 1.0;
+        for (unsigned int i = 0; i < Dim; ++i) {
+            if (alg == Algorithm::VICO || alg == Algorithm::BIHARMONIC) {
+                normalization *= 2.0 * (1.0 / 4.0);
+            } else {
+                normalization *= 2.0 * nr_m[i] * hr_m[i];
             }
+        }
+        return normalization;
+    }
 
-            // receive
-            const auto& lDomains1 = layout_mp->getHostLocalDomains();
-            int myRank            = Comm->rank();
-
-            for (int i = 0; i < ranks; ++i) {
-                if (lDomains1[i].touches(ldom2)) {
-                    auto intersection = lDomains1[i].intersect(ldom2);
+    /////////////////////////////////////////////////////////////////////////
+    // compute electric potential by solving Poisson's eq given a field rho and mesh spacings hr
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::solve() {
+        if constexpr (SinglePrecision) {
+            if (this->params_m.template get<bool>("single_precision")) {
+                solveLowPrecision();
+                return;
+            }
+        }
 
-                    Communicate::size_type nrecvs;
-                    nrecvs = intersection.size();
+        // start a timer
+        static IpplTimings::TimerRef solve = IpplTimings::getTimer("Solve");
+        IpplTimings::startTimer(solve);
 
-                    buffer_type buf =
-                        Comm->getBuffer<memory_space, Trhs>(IPPL_SOLVER_RECV + myRank, nrecvs);
+        // get the output type (sol, grad, or sol & grad)
+        const int out = this->params_m.template get<int>("output_type");
 
-                    Comm->recv(i, OPEN_SOLVER_TAG, fd_m, *buf, nrecvs * sizeof(Trhs), nrecvs);
-                    buf->resetReadPos();
+        // get hessian flag (if true, we compute the Hessian)
+        const bool hessian = this->params_m.template get<bool>("hessian");
 
-                    unpack(intersection, view2, fd_m, nghost2, ldom2);
-                }
-            }
+        // set the mesh & spacing, which may change each timestep
+        // if the spacing has changed, set green flag to true
+        const bool green = updateMeshSpacing();
 
-            // wait for all messages to be received
-            if (requests.size() > 0) {
-                MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
-            }
-            Comm->barrier();
+        // field object on the doubled grid; zero-padded
+        // only the physical part is written, since the FFT of rho2_mr treats it as zero
+        // elsewhere and only computes the physical part of its inverse FFTs
+        const NDIndex<Dim>& physical = layout_mp->getDomain();
 
-        } else {
-            Kokkos::parallel_for(
-                "Write rho on the doubled grid", this->rhs_mp->getFieldRangePolicy(),
-                KOKKOS_LAMBDA(const size_t i, const size_t j, const size_t k) {
-                    const size_t ig2 = i + ldom2[0].first() - nghost2;
-                    const size_t jg2 = j + ldom2[1].first() - nghost2;
-                    const size_t kg2 = k + ldom2[2].first() - nghost2;
+        // the normalization is applied by the inverse FFTs
+        const Trhs normalization = convolutionNormalization();
 
-                    const size_t ig1 = i + ldom1[0].first() - nghost1;
-                    const size_t jg1 = j + ldom1[1].first() - nghost1;
-                    const size_t kg1 = k + ldom1[2].first() - nghost1;
+        // start a timer
+        static IpplTimings::TimerRef stod = IpplTimings::getTimer("Solve: Physical to double");
+        IpplTimings::startTimer(stod);
 
-                    // write physical rho on [0,N-1] of doubled field
-                    const bool isQuadrant1 = ((ig1 == ig2) && (jg1 == jg2) && (kg1 == kg2));
-                    view2(i, j, k)         = view1(i, j, k) * isQuadrant1;
-                });
-        }
+        // store rho (RHS) in the lower left quadrant of the doubled grid
+        physicalToDouble(*this->rhs_mp, rho2_mr);
 
         IpplTimings::stopTimer(stod);
 
@@ -536,13 +380,13 @@ namespace ippl {
         IpplTimings::startTimer(fftrho);
 
         // forward FFT of the charge density field on doubled grid
-        fft_m->transform(FORWARD, rho2_mr, rho2tr_m);
+        fft_m->transform(FORWARD, rho2_mr, rho2tr_m, physical);
 
         IpplTimings::stopTimer(fftrho);
 
-        // call greensFunction to recompute if the mesh spacing has changed
-        if (green) {
-            greensFunction();
+        // obtain the Green's function again if the mesh spacing has changed
+        if (green || !greenValid_m) {
+            updateGreensFunction();
         }
 
         // multiply FFT(rho2)*FFT(green)
@@ -557,100 +401,17 @@ namespace ippl {
             IpplTimings::startTimer(fftc);
 
             // inverse FFT of the product and store the electrostatic potential in rho2_mr
-            fft_m->transform(BACKWARD, rho2_mr, rho2tr_m);
+            fft_m->transform(BACKWARD, rho2_mr, rho2tr_m, physical, normalization);
 
             IpplTimings::stopTimer(fftc);
 
-            // Hockney: multiply the rho2_mr field by the total number of points to account for
-            // double counting (rho and green) of normalization factor in forward transform
-            // also multiply by the mesh spacing^3 (to account for discretization)
-            // Vico: need to multiply by normalization factor of 1/4N^3,
-            // since only backward transform was performed on the 4N grid
-            for (unsigned int i = 0; i < Dim; ++i) {
-                if (alg == Algorithm::VICO || alg == Algorithm::BIHARMONIC) {
-                    rho2_mr = rho2_mr * 2.0 * (1.0 / 4.0);
-                } else {
-                    rho2_mr = rho2_mr * 2.0 * nr_m[i] * hr_m[i];
-                }
-            }
-
             // start a timer
             static IpplTimings::TimerRef dtos = IpplTimings::getTimer("Solve: Double to physical");
             IpplTimings::startTimer(dtos);
 
             // get the physical part only --> physical electrostatic potential is now given in RHS
-            // need communication if more than one rank
-
-            if (ranks > 1) {
-                // COMMUNICATION
-
-                // send
-                const auto& lDomains1 = layout_mp->getHostLocalDomains();
-
-                std::vector<MPI_Request> requests(0);
+            doubleToPhysical(rho2_mr, *this->rhs_mp);
 
-                for (int i = 0; i < ranks; ++i) {
-                    if (lDomains1[i].touches(ldom2)) {
-                        auto intersection = lDomains1[i].intersect(ldom2);
-
-                        requests.resize(requests.size() + 1);
-
-                        Communicate::size_type nsends;
-                        pack(intersection, view2, fd_m, nghost2, ldom2, nsends);
-
-                        buffer_type buf =
-                            Comm->getBuffer<memory_space, Trhs>(IPPL_SOLVER_SEND + i, nsends);
-
-                        Comm->isend(i, OPEN_SOLVER_TAG, fd_m, *buf, requests.back(), nsends);
-                        buf->resetWritePos();
-                    }
-                }
-
-                // receive
-                const auto& lDomains2 = layout2_m->getHostLocalDomains();
-                int myRank            = Comm->rank();
-
-                for (int i = 0; i < ranks; ++i) {
-                    if (ldom1.touches(lDomains2[i])) {
-                        auto intersection = ldom1.intersect(lDomains2[i]);
-
-                        Communicate::size_type nrecvs;
-                        nrecvs = intersection.size();
-
-                        buffer_type buf =
-                            Comm->getBuffer<memory_space, Trhs>(IPPL_SOLVER_RECV + myRank, nrecvs);
-
-                        Comm->recv(i, OPEN_SOLVER_TAG, fd_m, *buf, nrecvs * sizeof(Trhs), nrecvs);
-                        buf->resetReadPos();
-
-                        unpack(intersection, view1, fd_m, nghost1, ldom1);
-                    }
-                }
-
-                // wait for all messages to be received
-                if (requests.size() > 0) {
-                    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
-                }
-                Comm->barrier();
-
-            } else {
-                Kokkos::parallel_for(
-                    "Write the solution into the LHS on physical grid",
-                    this->rhs_mp->getFieldRangePolicy(),
-                    KOKKOS_LAMBDA(const int i, const int j, const int k) {
-                        const int ig2 = i + ldom2[0].first() - nghost2;
-                        const int jg2 = j + ldom2[1].first() - nghost2;
-                        const int kg2 = k + ldom2[2].first() - nghost2;
-
-                        const int ig = i + ldom1[0].first() - nghost1;
-                        const int jg = j + ldom1[1].first() - nghost1;
-                        const int kg = k + ldom1[2].first() - nghost1;
-
-                        // take [0,N-1] as physical solution
-                        const bool isQuadrant1 = ((ig == ig2) && (jg == jg2) && (kg == kg2));
-                        view1(i, j, k)         = view2(i, j, k) * isQuadrant1;
-                    });
-            }
             IpplTimings::stopTimer(dtos);
         }
 
@@ -661,6 +422,17 @@ namespace ippl {
             *(this->lhs_mp) = -grad(*this->rhs_mp);
         }
 
+        // the gradient and the Hessian are restricted to the physical grid below
+        const int ranks = Comm->size();
+
+        auto view2        = rho2_mr.getView();
+        const int nghost2 = rho2_mr.getNghost();
+
+        const auto& ldom2 = layout2_m->getLocalNDIndex();
+        const auto& ldom1 = layout_mp->getLocalNDIndex();
+
+        using index_array_type = typename RangePolicy<Dim>::index_array_type;
+
         // if output_type is GRAD or SOL_AND_GRAD, we calculate E-field (gradient in Fourier domain)
         if (((out == Base::GRAD) || (out == Base::SOL_AND_GRAD)) && (!isGradFD_m)) {
             // start a timer
@@ -676,8 +448,10 @@ namespace ippl {
             const int nghostR = rho2tr_m.getNghost();
             const auto& ldomR = layoutComplex_m->getLocalNDIndex();
 
-            // use temp_m as a temporary complex field
-            auto view_g = temp_m.getView();
+            // a temporary complex field from the pool
+            auto tempHandle = FieldPool<CxField_t>::acquire(*meshComplex_m, *layoutComplex_m);
+            CxField_t& temp = *tempHandle;
+            auto view_g     = temp.getView();
 
             // define some constants
             const scalar_type pi          = Kokkos::numbers::pi_v<scalar_type>;
@@ -690,15 +464,14 @@ namespace ippl {
             // loop over each component (E = vector field)
             for (size_t gd = 0; gd < Dim; ++gd) {
                 // loop over rho2tr_m to multiply by -ik (gradient in Fourier space)
-                Kokkos::parallel_for(
-                    "Gradient - E field", rho2tr_m.getFieldRangePolicy(),
-                    KOKKOS_LAMBDA(const int i, const int j, const int k) {
+                ippl::parallel_for(
+                    "Gradient - E field", getRangePolicy(viewR, nghostR),
+                    KOKKOS_LAMBDA(const index_array_type& args) {
                         // global indices for 2N rhotr_m
-                        const int ig = i + ldomR[0].first() - nghostR;
-                        const int jg = j + ldomR[1].first() - nghostR;
-                        const int kg = k + ldomR[2].first() - nghostR;
-
-                        Vector<int, 3> iVec = {ig, jg, kg};
+                        Vector<int, Dim> iVec = args - nghostR;
+                        for (unsigned d = 0; d < Dim; ++d) {
+                            iVec[d] += ldomR[d].first();
+                        }
 
                         scalar_type k_gd;
                         const scalar_type Len = N[gd] * hsize[gd];
@@ -707,27 +480,18 @@ namespace ippl {
 
                         k_gd = notMid * (pi / Len) * (iVec[gd] - shift * 2 * N[gd]);
 
-                        view_g(i, j, k) = -(I * k_gd) * viewR(i, j, k);
+                        apply(view_g, args) = -(I * k_gd) * apply(viewR, args);
                     });
 
                 // start a timer
                 static IpplTimings::TimerRef ffte = IpplTimings::getTimer("FFT: Efield");
                 IpplTimings::startTimer(ffte);
 
-                // transform to get E-field
-                fft_m->transform(BACKWARD, rho2_mr, temp_m);
+                // transform to get E-field, with proper normalization
+                fft_m->transform(BACKWARD, rho2_mr, temp, physical, normalization);
 
                 IpplTimings::stopTimer(ffte);
 
-                // apply proper normalization
-                for (unsigned int i = 0; i < Dim; ++i) {
-                    if (alg == Algorithm::VICO || alg == Algorithm::BIHARMONIC) {
-                        rho2_mr = rho2_mr * 2.0 * (1.0 / 4.0);
-                    } else {
-                        rho2_mr = rho2_mr * 2.0 * nr_m[i] * hr_m[i];
-                    }
-                }
-
                 // start a timer
                 static IpplTimings::TimerRef edtos =
                     IpplTimings::getTimer("Efield: double to phys.");
@@ -736,72 +500,24 @@ namespace ippl {
                 // restrict to physical grid (N^3) and assign to LHS (E-field)
                 // communication needed if more than one rank
                 if (ranks > 1) {
-                    // COMMUNICATION
-
-                    // send
-                    const auto& lDomains1 = layout_mp->getHostLocalDomains();
-                    std::vector<MPI_Request> requests(0);
-
-                    for (int i = 0; i < ranks; ++i) {
-                        if (lDomains1[i].touches(ldom2)) {
-                            auto intersection = lDomains1[i].intersect(ldom2);
-
-                            requests.resize(requests.size() + 1);
-
-                            Communicate::size_type nsends;
-                            pack(intersection, view2, fd_m, nghost2, ldom2, nsends);
-
-                            buffer_type buf =
-                                Comm->getBuffer<memory_space, Trhs>(IPPL_SOLVER_SEND + i, nsends);
-
-                            Comm->isend(i, OPEN_SOLVER_TAG, fd_m, *buf, requests.back(), nsends);
-                            buf->resetWritePos();
-                        }
-                    }
-
-                    // receive
-                    const auto& lDomains2 = layout2_m->getHostLocalDomains();
-                    int myRank            = Comm->rank();
-
-                    for (int i = 0; i < ranks; ++i) {
-                        if (ldom1.touches(lDomains2[i])) {
-                            auto intersection = ldom1.intersect(lDomains2[i]);
-
-                            Communicate::size_type nrecvs;
-                            nrecvs = intersection.size();
-
-                            buffer_type buf = Comm->getBuffer<memory_space, Trhs>(
-                                IPPL_SOLVER_RECV + myRank, nrecvs);
-
-                            Comm->recv(i, OPEN_SOLVER_TAG, fd_m, *buf, nrecvs * sizeof(Trhs),
-                                       nrecvs);
-                            buf->resetReadPos();
-
-                            unpack(intersection, viewL, gd, fd_m, nghostL, ldom1);
-                        }
-                    }
-
-                    // wait for all messages to be received
-                    if (requests.size() > 0) {
-                        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
-                    }
-                    Comm->barrier();
-
+                    detail::exchange(doublePlan_m.recvs, doublePlan_m.sends, view2, nghost2, ldom2,
+                                     fd_m, OPEN_SOLVER_TAG, IPPL_SOLVER_SEND, IPPL_SOLVER_RECV,
+                                     [&](const auto& block) {
+                                         detail::unpack(block.domain, viewL, fd_m, nghostL,
+                                                        ldom1, gd);
+                                     });
                 } else {
-                    Kokkos::parallel_for(
-                        "Write the E-field on physical grid", this->lhs_mp->getFieldRangePolicy(),
-                        KOKKOS_LAMBDA(const int i, const int j, const int k) {
-                            const int ig2 = i + ldom2[0].first() - nghost2;
-                            const int jg2 = j + ldom2[1].first() - nghost2;
-                            const int kg2 = k + ldom2[2].first() - nghost2;
-
-                            const int ig = i + ldom1[0].first() - nghostL;
-                            const int jg = j + ldom1[1].first() - nghostL;
-                            const int kg = k + ldom1[2].first() - nghostL;
-
+                    ippl::parallel_for(
+                        "Write the E-field on physical grid", getRangePolicy(viewL, nghostL),
+                        KOKKOS_LAMBDA(const index_array_type& args) {
                             // take [0,N-1] as physical solution
-                            const bool isQuadrant1 = ((ig == ig2) && (jg == jg2) && (kg == kg2));
-                            viewL(i, j, k)[gd]     = view2(i, j, k) * isQuadrant1;
+                            bool isQuadrant1 = true;
+                            for (unsigned d = 0; d < Dim; ++d) {
+                                isQuadrant1 = isQuadrant1
+                                              && (args[d] + ldom1[d].first() - nghostL
+                                                  == args[d] + ldom2[d].first() - nghost2);
+                            }
+                            apply(viewL, args)[gd] = apply(view2, args) * isQuadrant1;
                         });
                 }
                 IpplTimings::stopTimer(edtos);
@@ -824,8 +540,10 @@ namespace ippl {
             const int nghostR = rho2tr_m.getNghost();
             const auto& ldomR = layoutComplex_m->getLocalNDIndex();
 
-            // use temp_m as a temporary complex field
-            auto view_g = temp_m.getView();
+            // a temporary complex field from the pool
+            auto tempHandle = FieldPool<CxField_t>::acquire(*meshComplex_m, *layoutComplex_m);
+            CxField_t& temp = *tempHandle;
+            auto view_g     = temp.getView();
 
             // define some constants
             const scalar_type pi = Kokkos::numbers::pi_v<scalar_type>;
@@ -841,15 +559,15 @@ namespace ippl {
                     // if diagonal element (row = col), do not need N/2 term = 0
                     // else, if mixed derivative, need kVec = 0 at N/2
 
-                    Kokkos::parallel_for(
-                        "Hessian", rho2tr_m.getFieldRangePolicy(),
-                        KOKKOS_LAMBDA(const int i, const int j, const int k) {
+                    ippl::parallel_for(
+                        "Hessian", getRangePolicy(viewR, nghostR),
+                        KOKKOS_LAMBDA(const index_array_type& args) {
                             // global indices for 2N rhotr_m
-                            const int ig = i + ldomR[0].first() - nghostR;
-                            const int jg = j + ldomR[1].first() - nghostR;
-                            const int kg = k + ldomR[2].first() - nghostR;
+                            Vector<int, Dim> iVec = args - nghostR;
+                            for (unsigned d = 0; d < Dim; ++d) {
+                                iVec[d] += ldomR[d].first();
+                            }
 
-                            Vector<int, 3> iVec = {ig, jg, kg};
                             Vector_t kVec;
 
                             for (size_t d = 0; d < Dim; ++d) {
@@ -862,27 +580,18 @@ namespace ippl {
                                           * (iVec[d] - shift * 2 * N[d]);
                             }
 
-                            view_g(i, j, k) = -(kVec[col] * kVec[row]) * viewR(i, j, k);
+                            apply(view_g, args) = -(kVec[col] * kVec[row]) * apply(viewR, args);
                         });
 
                     // start a timer
                     static IpplTimings::TimerRef ffth = IpplTimings::getTimer("FFT: Hessian");
                     IpplTimings::startTimer(ffth);
 
-                    // transform to get Hessian
-                    fft_m->transform(BACKWARD, rho2_mr, temp_m);
+                    // transform to get Hessian, with proper normalization
+                    fft_m->transform(BACKWARD, rho2_mr, temp, physical, normalization);
 
                     IpplTimings::stopTimer(ffth);
 
-                    // apply proper normalization
-                    for (unsigned int i = 0; i < Dim; ++i) {
-                        if (alg == Algorithm::VICO || alg == Algorithm::BIHARMONIC) {
-                            rho2_mr = rho2_mr * 2.0 * (1.0 / 4.0);
-                        } else {
-                            rho2_mr = rho2_mr * 2.0 * nr_m[i] * hr_m[i];
-                        }
-                    }
-
                     // start a timer
                     static IpplTimings::TimerRef hdtos =
                         IpplTimings::getTimer("Hessian: double to phys.");
@@ -891,89 +600,276 @@ namespace ippl {
                     // restrict to physical grid (N^3) and assign to Matrix field (Hessian)
                     // communication needed if more than one rank
                     if (ranks > 1) {
-                        // COMMUNICATION
+                        detail::exchange(doublePlan_m.recvs, doublePlan_m.sends, view2, nghost2,
+                                         ldom2, fd_m, OPEN_SOLVER_TAG, IPPL_SOLVER_SEND,
+                                         IPPL_SOLVER_RECV, [&](const auto& block) {
+                                             detail::unpack(block.domain, viewH, fd_m, nghostH,
+                                                            ldom1, row, col);
+                                         });
+                    } else {
+                        ippl::parallel_for(
+                            "Write Hessian on physical grid", getRangePolicy(viewH, nghostH),
+                            KOKKOS_LAMBDA(const index_array_type& args) {
+                                // take [0,N-1] as physical solution
+                                bool isQuadrant1 = true;
+                                for (unsigned d = 0; d < Dim; ++d) {
+                                    isQuadrant1 = isQuadrant1
+                                                  && (args[d] + ldom1[d].first() - nghostH
+                                                      == args[d] + ldom2[d].first() - nghost2);
+                                }
+                                apply(viewH, args)[row][col] = apply(view2, args) * isQuadrant1;
+                            });
+                    }
+                    IpplTimings::stopTimer(hdtos);
+                }
+            }
+            IpplTimings::stopTimer(hess);
+        }
 
-                        // send
-                        const auto& lDomains1 = layout_mp->getHostLocalDomains();
-                        std::vector<MPI_Request> requests(0);
+        errorEstimate_m = detail::fftErrorEstimate<Trhs>(domain2_m.size());
 
-                        for (int i = 0; i < ranks; ++i) {
-                            if (lDomains1[i].touches(ldom2)) {
-                                auto intersection = lDomains1[i].intersect(ldom2);
+        IpplTimings::stopTimer(solve);
+    };
 
-                                requests.resize(requests.size() + 1);
+    /////////////////////////////////////////////////////////////////////////
+    // set up the solver on single precision copies of the fields
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::initializeLowPrecision() {
+        lowRhs_mp = std::make_unique<low_rhs_type>(*mesh_mp, *layout_mp, this->rhs_mp->getNghost());
+
+        low_mp = std::make_unique<low_solver_type>();
+        low_mp->mergeParameters(this->params_m);
+        low_mp->updateParameter("single_precision", false);
+        low_mp->setRhs(*lowRhs_mp);
+
+        // the LHS may only be set after the RHS, so its copy is set up by the next solve
+        lowLhsOf_m = nullptr;
+    }
 
-                                Communicate::size_type nsends;
-                                pack(intersection, view2, fd_m, nghost2, ldom2, nsends);
+    /////////////////////////////////////////////////////////////////////////
+    // solve on single precision copies of the fields
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::solveLowPrecision() {
+        if (low_mp == nullptr) {
+            initializeLowPrecision();
+        }
 
-                                buffer_type buf = Comm->getBuffer<memory_space, Trhs>(
-                                    IPPL_SOLVER_SEND + i, nsends);
+        const int out   = this->params_m.template get<int>("output_type");
+        const bool sol  = (out == Base::SOL) || (out == Base::SOL_AND_GRAD);
+        const bool grad = (out == Base::GRAD) || (out == Base::SOL_AND_GRAD);
 
-                                Comm->isend(i, OPEN_SOLVER_TAG, fd_m, *buf, requests.back(),
-                                            nsends);
-                                buf->resetWritePos();
-                            }
-                        }
+        if (grad && lowLhsOf_m != this->lhs_mp) {
+            lhs_type& lhs = *this->lhs_mp;
+            lowLhs_mp =
+                std::make_unique<low_lhs_type>(lhs.get_mesh(), lhs.getLayout(), lhs.getNghost());
+            low_mp->setLhs(*lowLhs_mp);
+            lowLhsOf_m = this->lhs_mp;
+        }
+        if (isGradFD_m) {
+            low_mp->setGradFD();
+        }
 
-                        // receive
-                        const auto& lDomains2 = layout2_m->getHostLocalDomains();
-                        int myRank            = Comm->rank();
+        static IpplTimings::TimerRef convert = IpplTimings::getTimer("Solve: Precision conversion");
 
-                        for (int i = 0; i < ranks; ++i) {
-                            if (ldom1.touches(lDomains2[i])) {
-                                auto intersection = ldom1.intersect(lDomains2[i]);
+        IpplTimings::startTimer(convert);
+        *lowRhs_mp = *this->rhs_mp;
+        IpplTimings::stopTimer(convert);
 
-                                Communicate::size_type nrecvs;
-                                nrecvs = intersection.size();
+        low_mp->solve();
 
-                                buffer_type buf = Comm->getBuffer<memory_space, Trhs>(
-                                    IPPL_SOLVER_RECV + myRank, nrecvs);
+        IpplTimings::startTimer(convert);
+        if (sol) {
+            *this->rhs_mp = *lowRhs_mp;
+        }
+        if (grad) {
+            *this->lhs_mp = *lowLhs_mp;
+        }
+        IpplTimings::stopTimer(convert);
 
-                                Comm->recv(i, OPEN_SOLVER_TAG, fd_m, *buf, nrecvs * sizeof(Trhs),
-                                           nrecvs);
-                                buf->resetReadPos();
+        errorEstimate_m = low_mp->getErrorEstimate();
+    }
 
-                                unpack(intersection, viewH, fd_m, nghostH, ldom1, row, col);
-                            }
-                        }
+    /////////////////////////////////////////////////////////////////////////
+    // compute the electric potentials of several charge densities at once
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::solve(
+        const std::vector<rhs_type*>& rhs) {
+        if (this->params_m.template get<bool>("single_precision")) {
+            throw IpplException("FFTPoissonSolver::solve",
+                                "Batched solves are only done in the precision of the fields");
+        }
 
-                        // wait for all messages to be received
-                        if (requests.size() > 0) {
-                            MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
-                        }
-                        Comm->barrier();
+        static IpplTimings::TimerRef solveBatch = IpplTimings::getTimer("Solve: Batched");
+        IpplTimings::startTimer(solveBatch);
 
-                    } else {
-                        Kokkos::parallel_for(
-                            "Write Hessian on physical grid", hess_m.getFieldRangePolicy(),
-                            KOKKOS_LAMBDA(const int i, const int j, const int k) {
-                                const int ig2 = i + ldom2[0].first() - nghost2;
-                                const int jg2 = j + ldom2[1].first() - nghost2;
-                                const int kg2 = k + ldom2[2].first() - nghost2;
+        for (const rhs_type* field : rhs) {
+            if (field->getLayout() != *layout_mp) {
+                throw IpplException("FFTPoissonSolver::solve",
+                                    "All right-hand sides must be on the layout of the RHS");
+            }
+        }
+
+        const bool green             = updateMeshSpacing();
+        const NDIndex<Dim>& physical = layout_mp->getDomain();
+        const Trhs normalization     = convolutionNormalization();
+
+        // the first charge density is stored on the doubled grid in storage_field,
+        // the others in pooled fields on the doubled grid
+        const size_t batch = rhs.size();
+        std::vector<typename FieldPool<Field_t>::Handle> rho2Batch;
+        rho2Batch.reserve(batch);
+        std::vector<Field_t*> rho2(batch);
+        for (size_t b = 0; b < batch; ++b) {
+            if (b == 0) {
+                rho2[b] = &rho2_mr;
+            } else {
+                rho2Batch.push_back(FieldPool<Field_t>::acquire(*mesh2_m, *layout2_m));
+                rho2[b] = &*rho2Batch.back();
+            }
+        }
 
-                                const int ig = i + ldom1[0].first() - nghostH;
-                                const int jg = j + ldom1[1].first() - nghostH;
-                                const int kg = k + ldom1[2].first() - nghostH;
+        using batch_view_type = typename FFT_t::batch_view_type;
+        if (rho2trBatch_m.size() != batch * rho2tr_m.getOwned().size()) {
+            rho2trBatch_m = detail::batchedShrinkView<batch_view_type>(
+                "rho2trBatch", rho2tr_m.getView(), rho2tr_m.getNghost(), batch);
+        }
 
-                                // take [0,N-1] as physical solution
-                                const bool isQuadrant1 =
-                                    ((ig == ig2) && (jg == jg2) && (kg == kg2));
-                                viewH(i, j, k)[row][col] = view2(i, j, k) * isQuadrant1;
-                            });
+        static IpplTimings::TimerRef stod = IpplTimings::getTimer("Solve: Physical to double");
+        IpplTimings::startTimer(stod);
+        for (size_t b = 0; b < batch; ++b) {
+            physicalToDouble(*rhs[b], *rho2[b]);
+        }
+        IpplTimings::stopTimer(stod);
+
+        // forward FFTs of all charge densities, which share the reshape messages
+        static IpplTimings::TimerRef fftrho = IpplTimings::getTimer("FFT: Rho");
+        IpplTimings::startTimer(fftrho);
+        fft_m->transform(FORWARD, rho2, rho2trBatch_m, physical);
+        IpplTimings::stopTimer(fftrho);
+
+        // the Green's function overwrites storage_field, which has been transformed
+        if (green || !greenValid_m) {
+            updateGreensFunction();
+        }
+
+        // multiply all transforms by the transformed Green's function in one sweep;
+        // they are stored one after the other along the batch dimension
+        auto view         = rho2trBatch_m;
+        auto viewG        = grntr_m.getView();
+        const int nghostG = grntr_m.getNghost();
+
+        constexpr unsigned bd = detail::batchDimension<batch_view_type>();
+        const int extent      = layoutComplex_m->getLocalNDIndex()[bd].length();
+
+        using index_array_type = typename RangePolicy<Dim>::index_array_type;
+        ippl::parallel_for(
+            "Batched convolution FFTPoissonSolver", getRangePolicy(view),
+            KOKKOS_LAMBDA(const index_array_type& args) {
+                index_array_type idx = args;
+                idx[bd] %= extent;
+                apply(view, args) = -apply(view, args) * apply(viewG, idx + nghostG);
+            });
+
+        static IpplTimings::TimerRef fftc = IpplTimings::getTimer("FFT: Convolution");
+        IpplTimings::startTimer(fftc);
+        fft_m->transform(BACKWARD, rho2, rho2trBatch_m, physical, normalization);
+        IpplTimings::stopTimer(fftc);
+
+        static IpplTimings::TimerRef dtos = IpplTimings::getTimer("Solve: Double to physical");
+        IpplTimings::startTimer(dtos);
+        for (size_t b = 0; b < batch; ++b) {
+            doubleToPhysical(*rho2[b], *rhs[b]);
+        }
+        IpplTimings::stopTimer(dtos);
+
+        errorEstimate_m = detail::fftErrorEstimate<Trhs>(domain2_m.size());
+
+        IpplTimings::stopTimer(solveBatch);
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // copy fields between the physical and the doubled grid
+
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::physicalToDouble(rhs_type& rho,
+                                                                                 Field_t& rho2) {
+        const int ranks = Comm->size();
+
+        auto view2 = rho2.getView();
+        auto view1 = rho.getView();
+
+        const int nghost2 = rho2.getNghost();
+        const int nghost1 = rho.getNghost();
+
+        const auto& ldom2 = layout2_m->getLocalNDIndex();
+        const auto& ldom1 = layout_mp->getLocalNDIndex();
+
+        if (ranks > 1) {
+            detail::exchange(doublePlan_m.sends, doublePlan_m.recvs, view1, nghost1, ldom1, fd_m,
+                             OPEN_SOLVER_TAG, IPPL_SOLVER_SEND, IPPL_SOLVER_RECV,
+                             [&](const auto& block) {
+                                 detail::unpack(block.domain, view2, fd_m, nghost2, ldom2);
+                             });
+        } else {
+            using index_array_type = typename RangePolicy<Dim>::index_array_type;
+            ippl::parallel_for(
+                "Write rho on the doubled grid", getRangePolicy(view1, nghost1),
+                KOKKOS_LAMBDA(const index_array_type& args) {
+                    // write physical rho on [0,N-1] of doubled field
+                    bool isQuadrant1 = true;
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        isQuadrant1 = isQuadrant1
+                                      && (args[d] + ldom1[d].first() - nghost1
+                                          == args[d] + ldom2[d].first() - nghost2);
                     }
-                    IpplTimings::stopTimer(hdtos);
-                }
-            }
-            IpplTimings::stopTimer(hess);
+                    apply(view2, args) = apply(view1, args) * isQuadrant1;
+                });
         }
-        IpplTimings::stopTimer(solve);
-    };
+    }
+
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::doubleToPhysical(Field_t& rho2,
+                                                                                 rhs_type& phi) {
+        const int ranks = Comm->size();
+
+        auto view2 = rho2.getView();
+        auto view1 = phi.getView();
+
+        const int nghost2 = rho2.getNghost();
+        const int nghost1 = phi.getNghost();
+
+        const auto& ldom2 = layout2_m->getLocalNDIndex();
+        const auto& ldom1 = layout_mp->getLocalNDIndex();
+
+        if (ranks > 1) {
+            // the blocks of the doubled grid go back the way they came
+            detail::exchange(doublePlan_m.recvs, doublePlan_m.sends, view2, nghost2, ldom2, fd_m,
+                             OPEN_SOLVER_TAG, IPPL_SOLVER_SEND, IPPL_SOLVER_RECV,
+                             [&](const auto& block) {
+                                 detail::unpack(block.domain, view1, fd_m, nghost1, ldom1);
+                             });
+        } else {
+            using index_array_type = typename RangePolicy<Dim>::index_array_type;
+            ippl::parallel_for(
+                "Write the solution into the LHS on physical grid", getRangePolicy(view1, nghost1),
+                KOKKOS_LAMBDA(const index_array_type& args) {
+                    // take [0,N-1] as physical solution
+                    bool isQuadrant1 = true;
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        isQuadrant1 = isQuadrant1
+                                      && (args[d] + ldom1[d].first() - nghost1
+                                          == args[d] + ldom2[d].first() - nghost2);
+                    }
+                    apply(view1, args) = apply(view2, args) * isQuadrant1;
+                });
+        }
+    }
 
     ////////////////////////////////////////////////////////////////////////
     // calculate FFT of the Green's function
 
-    template <typename FieldLHS, typename FieldRHS>
-    void FFTPoissonSolver<FieldLHS, FieldRHS>::greensFunction() {
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::greensFunction() {
         const scalar_type pi = Kokkos::numbers::pi_v<scalar_type>;
         grn_mr               = 0.0;
 
@@ -1012,68 +908,78 @@ namespace ippl {
 
             Vector<int, Dim> size = nr_m;
 
-            // Kokkos parallel for loop to assign analytic grnL_m
+            // Kokkos parallel for loop to assign analytic grnL_m; s is the norm of the
+            // wave vector, whose components are negative in the upper half of the 4N grid
+            using index_array_type = typename RangePolicy<Dim>::index_array_type;
             if (alg == Algorithm::VICO) {
-                Kokkos::parallel_for(
-                    "Initialize Green's function ", grnL_m.getFieldRangePolicy(),
-                    KOKKOS_LAMBDA(const int i, const int j, const int k) {
-                        // go from local indices to global
-                        const int ig = i + ldom_g[0].first() - nghost_g;
-                        const int jg = j + ldom_g[1].first() - nghost_g;
-                        const int kg = k + ldom_g[2].first() - nghost_g;
-
-                        bool isOutside = (ig > 2 * size[0] - 1);
-                        const Tg t     = ig * hs_m[0] + isOutside * origin[0];
-
-                        isOutside  = (jg > 2 * size[1] - 1);
-                        const Tg u = jg * hs_m[1] + isOutside * origin[1];
-
-                        isOutside  = (kg > 2 * size[2] - 1);
-                        const Tg v = kg * hs_m[2] + isOutside * origin[2];
-
-                        Tg s = (t * t) + (u * u) + (v * v);
-                        s    = Kokkos::sqrt(s);
-
-                        // assign the green's function value
-                        // if (0,0,0), assign L^2/2 (analytical limit of sinc)
-
-                        const bool isOrig    = ((ig == 0 && jg == 0 && kg == 0));
-                        const Tg analyticLim = -L_sum * L_sum * 0.5;
-                        const Tg value = -2.0 * (Kokkos::sin(0.5 * L_sum * s) / (s + isOrig * 1.0))
-                                         * (Kokkos::sin(0.5 * L_sum * s) / (s + isOrig * 1.0));
+                ippl::parallel_for(
+                    "Initialize Green's function ", getRangePolicy(view_g, nghost_g),
+                    KOKKOS_LAMBDA(const index_array_type& args) {
+                        Tg s        = 0;
+                        bool isOrig = true;
+                        for (unsigned d = 0; d < Dim; ++d) {
+                            // go from local indices to global
+                            const int ig = args[d] + ldom_g[d].first() - nghost_g;
+
+                            const bool isOutside = (ig > 2 * size[d] - 1);
+                            const Tg t           = ig * hs_m[d] + isOutside * origin[d];
+
+                            s += t * t;
+                            isOrig = isOrig && (ig == 0);
+                        }
+                        s = Kokkos::sqrt(s);
+
+                        // assign the green's function value and replace it with
+                        // the analytical limit at the origin
+                        Tg value, analyticLim;
+                        if constexpr (Dim == 3) {
+                            // truncated 1/(4 pi r), whose limit is L^2/2
+                            analyticLim = -L_sum * L_sum * 0.5;
+                            value = -2.0 * (Kokkos::sin(0.5 * L_sum * s) / (s + isOrig * 1.0))
+                                    * (Kokkos::sin(0.5 * L_sum * s) / (s + isOrig * 1.0));
+                        } else {
+                            // truncated -ln(r)/(2 pi), whose limit is L^2 (1 - 2 ln(L)) / 4
+                            using Kokkos::Experimental::cyl_bessel_j0;
+                            using Kokkos::Experimental::cyl_bessel_j1;
+                            using complex_type = Kokkos::complex<Tg>;
+
+                            const complex_type Ls(L_sum * s, 0);
+                            const Tg j0 = cyl_bessel_j0<complex_type, Tg, int>(Ls).real();
+                            const Tg j1 = cyl_bessel_j1<complex_type, Tg, int>(Ls).real();
+
+                            analyticLim = -0.25 * L_sum * L_sum * (1 - 2 * Kokkos::log(L_sum));
+                            value       = -((1 - j0) / (s * s + isOrig * 1.0)
+                                      - L_sum * Kokkos::log(L_sum) * j1 / (s + isOrig * 1.0));
+                        }
 
-                        view_g(i, j, k) = (!isOrig) * value + isOrig * analyticLim;
+                        apply(view_g, args) = (!isOrig) * value + isOrig * analyticLim;
                     });
 
             } else if (alg == Algorithm::BIHARMONIC) {
-                Kokkos::parallel_for(
-                    "Initialize Green's function ", grnL_m.getFieldRangePolicy(),
-                    KOKKOS_LAMBDA(const int i, const int j, const int k) {
-                        // go from local indices to global
-                        const int ig = i + ldom_g[0].first() - nghost_g;
-                        const int jg = j + ldom_g[1].first() - nghost_g;
-                        const int kg = k + ldom_g[2].first() - nghost_g;
-
-                        bool isOutside = (ig > 2 * size[0] - 1);
-                        const Tg t     = ig * hs_m[0] + isOutside * origin[0];
-
-                        isOutside  = (jg > 2 * size[1] - 1);
-                        const Tg u = jg * hs_m[1] + isOutside * origin[1];
-
-                        isOutside  = (kg > 2 * size[2] - 1);
-                        const Tg v = kg * hs_m[2] + isOutside * origin[2];
-
-                        Tg s = (t * t) + (u * u) + (v * v);
-                        s    = Kokkos::sqrt(s);
+                ippl::parallel_for(
+                    "Initialize Green's function ", getRangePolicy(view_g, nghost_g),
+                    KOKKOS_LAMBDA(const index_array_type& args) {
+                        Tg s        = 0;
+                        bool isOrig = true;
+                        for (unsigned d = 0; d < Dim; ++d) {
+                            // go from local indices to global
+                            const int ig = args[d] + ldom_g[d].first() - nghost_g;
+
+                            const bool isOutside = (ig > 2 * size[d] - 1);
+                            const Tg t           = ig * hs_m[d] + isOutside * origin[d];
+
+                            s += t * t;
+                            isOrig = isOrig && (ig == 0);
+                        }
+                        s = Kokkos::sqrt(s);
 
                         // assign value and replace with analytic limit at origin (0,0,0)
-                        const bool isOrig    = ((ig == 0 && jg == 0 && kg == 0));
                         const Tg analyticLim = -L_sum * L_sum * L_sum * L_sum / 8.0;
                         const Tg value = -((2 - (L_sum * L_sum * s * s)) * Kokkos::cos(L_sum * s)
                                            + 2 * L_sum * s * Kokkos::sin(L_sum * s) - 2)
                                          / (2 * s * s * s * s + isOrig * 1.0);
 
-                        view_g(i, j, k) = (!isOrig) * value + isOrig * analyticLim;
+                        apply(view_g, args) = (!isOrig) * value + isOrig * analyticLim;
                     });
             }
 
@@ -1101,41 +1007,46 @@ namespace ippl {
             const int ranks = Comm->size();
 
             if (ranks > 1) {
-                communicateVico(size, view_g, ldom_g, nghost_g, view, ldom, nghost);
+                communicateVico(view_g, ldom_g, nghost_g, view, ldom, nghost);
             } else {
-                // restrict the green's function to a (2N)^3 grid from the (4N)^3 grid
-                using mdrange_type = Kokkos::MDRangePolicy<Kokkos::Rank<3>>;
-                Kokkos::parallel_for(
+                // restrict the green's function to the 2N grid from the 4N grid
+                using index_type = typename RangePolicy<Dim>::index_type;
+                Kokkos::Array<index_type, Dim> begin, end;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    begin[d] = nghost;
+                    end[d]   = view.extent(d) - nghost - size[d];
+                }
+                ippl::parallel_for(
                     "Restrict domain of Green's function from 4N to 2N",
-                    mdrange_type({nghost, nghost, nghost}, {view.extent(0) - nghost - size[0],
-                                                            view.extent(1) - nghost - size[1],
-                                                            view.extent(2) - nghost - size[2]}),
-                    KOKKOS_LAMBDA(const int i, const int j, const int k) {
+                    createRangePolicy<Dim>(begin, end),
+                    KOKKOS_LAMBDA(const index_array_type& args) {
                         // go from local indices to global
-                        const int ig = i + ldom[0].first() - nghost;
-                        const int jg = j + ldom[1].first() - nghost;
-                        const int kg = k + ldom[2].first() - nghost;
-
-                        const int ig2 = i + ldom_g[0].first() - nghost_g;
-                        const int jg2 = j + ldom_g[1].first() - nghost_g;
-                        const int kg2 = k + ldom_g[2].first() - nghost_g;
+                        Vector<int, Dim> iVec = args - nghost;
+                        bool isQuadrant1      = true;
+                        for (unsigned d = 0; d < Dim; ++d) {
+                            iVec[d] += ldom[d].first();
+                            isQuadrant1 = isQuadrant1
+                                          && (iVec[d] == args[d] + ldom_g[d].first() - nghost_g);
+                        }
 
-                        if ((ig == ig2) && (jg == jg2) && (kg == kg2)) {
-                            view(i, j, k) = real(view_g(i, j, k));
+                        if (isQuadrant1) {
+                            apply(view, args) = real(apply(view_g, args));
                         }
 
-                        // Now fill the rest of the field
-                        const int s = 2 * size[0] - ig - 1 - ldom_g[0].first() + nghost_g;
-                        const int p = 2 * size[1] - jg - 1 - ldom_g[1].first() + nghost_g;
-                        const int q = 2 * size[2] - kg - 1 - ldom_g[2].first() + nghost_g;
-
-                        view(s, j, k) = real(view_g(i + 1, j, k));
-                        view(i, p, k) = real(view_g(i, j + 1, k));
-                        view(i, j, q) = real(view_g(i, j, k + 1));
-                        view(s, j, q) = real(view_g(i + 1, j, k + 1));
-                        view(s, p, k) = real(view_g(i + 1, j + 1, k));
-                        view(i, p, q) = real(view_g(i, j + 1, k + 1));
-                        view(s, p, q) = real(view_g(i + 1, j + 1, k + 1));
+                        // Now fill the rest of the field; the other quadrants are mirror
+                        // images in the dimensions in which they are upper
+                        for (unsigned q = 1; q < (1u << Dim); ++q) {
+                            index_array_type dst = args;
+                            index_array_type src = args;
+                            for (unsigned d = 0; d < Dim; ++d) {
+                                if (q & (1u << d)) {
+                                    dst[d] = 2 * size[d] - iVec[d] - 1 - ldom_g[d].first()
+                                             + nghost_g;
+                                    src[d] += 1;
+                                }
+                            }
+                            apply(view, dst) = real(apply(view_g, src));
+                        }
                     });
             }
             IpplTimings::stopTimer(ifftshift);
@@ -1151,24 +1062,35 @@ namespace ippl {
                 grn_mr = grn_mr + grnIField_m[i] * hrsq[i];
             }
 
-            grn_mr = -1.0 / (4.0 * pi * sqrt(grn_mr));
+            // the value at the origin, which replaces the singularity; in 2D, it is
+            // the average of ln(r) over the cell
+            Trhs origValue;
+            if constexpr (Dim == 3) {
+                grn_mr    = -1.0 / (4.0 * pi * sqrt(grn_mr));
+                origValue = -1.0 / (4.0 * pi);
+            } else {
+                // the negative of -ln(r) / (2 pi), as in 3D
+                grn_mr = log(grn_mr) / (4.0 * pi);
+
+                origValue = detail::cellAverageLog<Trhs>(hr_m[0], hr_m[1]) / (2.0 * pi);
+            }
 
             typename Field_t::view_type view = grn_mr.getView();
             const int nghost                 = grn_mr.getNghost();
             const auto& ldom                 = layout2_m->getLocalNDIndex();
 
-            // Kokkos parallel for loop to find (0,0,0) point and regularize
-            Kokkos::parallel_for(
-                "Regularize Green's function ", grn_mr.getFieldRangePolicy(),
-                KOKKOS_LAMBDA(const int i, const int j, const int k) {
+            // Kokkos parallel for loop to find the origin and regularize
+            using index_array_type = typename RangePolicy<Dim>::index_array_type;
+            ippl::parallel_for(
+                "Regularize Green's function ", getRangePolicy(view, nghost),
+                KOKKOS_LAMBDA(const index_array_type& args) {
                     // go from local indices to global
-                    const int ig = i + ldom[0].first() - nghost;
-                    const int jg = j + ldom[1].first() - nghost;
-                    const int kg = k + ldom[2].first() - nghost;
+                    bool isOrig = true;
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        isOrig = isOrig && (args[d] + ldom[d].first() - nghost == 0);
+                    }
 
-                    // if (0,0,0), assign to it 1/(4*pi)
-                    const bool isOrig = (ig == 0 && jg == 0 && kg == 0);
-                    view(i, j, k)     = isOrig * (-1.0 / (4.0 * pi)) + (!isOrig) * view(i, j, k);
+                    apply(view, args) = isOrig * origValue + (!isOrig) * apply(view, args);
                 });
         }
 
@@ -1176,574 +1098,123 @@ namespace ippl {
         static IpplTimings::TimerRef fftg = IpplTimings::getTimer("FFT: Green");
         IpplTimings::startTimer(fftg);
 
-        // perform the FFT of the Green's function for the convolution
+        // perform the FFT of the Green's function for the convolution;
+        // a view shared with the cache must not be overwritten
+        green_cache::detach(grntr_m);
         fft_m->transform(FORWARD, grn_mr, grntr_m);
 
         IpplTimings::stopTimer(fftg);
     };
 
-    template <typename FieldLHS, typename FieldRHS>
-    void FFTPoissonSolver<FieldLHS, FieldRHS>::communicateVico(
-        Vector<int, Dim> size, typename CxField_gt::view_type view_g,
-        const ippl::NDIndex<Dim> ldom_g, const int nghost_g, typename Field_t::view_type view,
-        const ippl::NDIndex<Dim> ldom, const int nghost) {
-        const auto& lDomains2 = layout2_m->getHostLocalDomains();
-        const auto& lDomains4 = layout4_m->getHostLocalDomains();
-
-        std::vector<MPI_Request> requests(0);
-        const int myRank = Comm->rank();
-        const int ranks  = Comm->size();
-
-        // 1st step: Define 8 domains corresponding to the different quadrants
-        ippl::NDIndex<Dim> none;
-        for (unsigned i = 0; i < Dim; i++) {
-            none[i] = ippl::Index(size[i]);
-        }
-
-        ippl::NDIndex<Dim> x;
-        x[0] = ippl::Index(size[0], 2 * size[0] - 1);
-        x[1] = ippl::Index(size[1]);
-        x[2] = ippl::Index(size[2]);
-
-        ippl::NDIndex<Dim> y;
-        y[0] = ippl::Index(size[0]);
-        y[1] = ippl::Index(size[1], 2 * size[1] - 1);
-        y[2] = ippl::Index(size[2]);
-
-        ippl::NDIndex<Dim> z;
-        z[0] = ippl::Index(size[0]);
-        z[1] = ippl::Index(size[1]);
-        z[2] = ippl::Index(size[2], 2 * size[2] - 1);
-
-        ippl::NDIndex<Dim> xy;
-        xy[0] = ippl::Index(size[0], 2 * size[0] - 1);
-        xy[1] = ippl::Index(size[1], 2 * size[1] - 1);
-        xy[2] = ippl::Index(size[2]);
-
-        ippl::NDIndex<Dim> xz;
-        xz[0] = ippl::Index(size[0], 2 * size[0] - 1);
-        xz[1] = ippl::Index(size[1]);
-        xz[2] = ippl::Index(size[2], 2 * size[2] - 1);
-
-        ippl::NDIndex<Dim> yz;
-        yz[0] = ippl::Index(size[0]);
-        yz[1] = ippl::Index(size[1], 2 * size[1] - 1);
-        yz[2] = ippl::Index(size[2], 2 * size[2] - 1);
-
-        ippl::NDIndex<Dim> xyz;
-        for (unsigned i = 0; i < Dim; i++) {
-            xyz[i] = ippl::Index(size[i], 2 * size[i] - 1);
-        }
-
-        // 2nd step: send
-        for (int i = 0; i < ranks; ++i) {
-            auto domain2 = lDomains2[i];
-
-            if (domain2.touches(none)) {
-                auto intersection = domain2.intersect(none);
-
-                if (ldom_g.touches(intersection)) {
-                    intersection = intersection.intersect(ldom_g);
-                    requests.resize(requests.size() + 1);
-
-                    Communicate::size_type nsends;
-                    pack(intersection, view_g, fd_m, nghost_g, ldom_g, nsends);
-
-                    buffer_type buf =
-                        Comm->getBuffer<memory_space, Trhs>(IPPL_VICO_SEND + i, nsends);
-
-                    int tag = VICO_SOLVER_TAG;
-
-                    Comm->isend(i, tag, fd_m, *buf, requests.back(), nsends);
-                    buf->resetWritePos();
-                }
-            }
-
-            if (domain2.touches(x)) {
-                auto intersection = domain2.intersect(x);
-                auto xdom         = ippl::Index((2 * size[0] - intersection[0].first()),
-                                                (2 * size[0] - intersection[0].last()), -1);
-
-                ippl::NDIndex<Dim> domain4;
-                domain4[0] = xdom;
-                domain4[1] = intersection[1];
-                domain4[2] = intersection[2];
-
-                if (ldom_g.touches(domain4)) {
-                    intersection = ldom_g.intersect(domain4);
-
-                    requests.resize(requests.size() + 1);
-
-                    Communicate::size_type nsends;
-                    pack(intersection, view_g, fd_m, nghost_g, ldom_g, nsends);
-
-                    buffer_type buf =
-                        Comm->getBuffer<memory_space, Trhs>(IPPL_VICO_SEND + 8 + i, nsends);
-
-                    int tag = VICO_SOLVER_TAG + 1;
-
-                    Comm->isend(i, tag, fd_m, *buf, requests.back(), nsends);
-                    buf->resetWritePos();
-                }
-            }
-
-            if (domain2.touches(y)) {
-                auto intersection = domain2.intersect(y);
-                auto ydom         = ippl::Index((2 * size[1] - intersection[1].first()),
-                                                (2 * size[1] - intersection[1].last()), -1);
-
-                ippl::NDIndex<Dim> domain4;
-                domain4[0] = intersection[0];
-                domain4[1] = ydom;
-                domain4[2] = intersection[2];
-
-                if (ldom_g.touches(domain4)) {
-                    intersection = ldom_g.intersect(domain4);
-
-                    requests.resize(requests.size() + 1);
-
-                    Communicate::size_type nsends;
-                    pack(intersection, view_g, fd_m, nghost_g, ldom_g, nsends);
-
-                    buffer_type buf =
-                        Comm->getBuffer<memory_space, Trhs>(IPPL_VICO_SEND + 2 * 8 + i, nsends);
-
-                    int tag = VICO_SOLVER_TAG + 2;
-
-                    Comm->isend(i, tag, fd_m, *buf, requests.back(), nsends);
-                    buf->resetWritePos();
-                }
-            }
-
-            if (domain2.touches(z)) {
-                auto intersection = domain2.intersect(z);
-                auto zdom         = ippl::Index((2 * size[2] - intersection[2].first()),
-                                                (2 * size[2] - intersection[2].last()), -1);
-
-                ippl::NDIndex<Dim> domain4;
-                domain4[0] = intersection[0];
-                domain4[1] = intersection[1];
-                domain4[2] = zdom;
-
-                if (ldom_g.touches(domain4)) {
-                    intersection = ldom_g.intersect(domain4);
-
-                    requests.resize(requests.size() + 1);
-
-                    Communicate::size_type nsends;
-                    pack(intersection, view_g, fd_m, nghost_g, ldom_g, nsends);
-
-                    buffer_type buf =
-                        Comm->getBuffer<memory_space, Trhs>(IPPL_VICO_SEND + 3 * 8 + i, nsends);
-
-                    int tag = VICO_SOLVER_TAG + 3;
-
-                    Comm->isend(i, tag, fd_m, *buf, requests.back(), nsends);
-                    buf->resetWritePos();
-                }
-            }
-
-            if (domain2.touches(xy)) {
-                auto intersection = domain2.intersect(xy);
-                auto xdom         = ippl::Index((2 * size[0] - intersection[0].first()),
-                                                (2 * size[0] - intersection[0].last()), -1);
-                auto ydom         = ippl::Index((2 * size[1] - intersection[1].first()),
-                                                (2 * size[1] - intersection[1].last()), -1);
-
-                ippl::NDIndex<Dim> domain4;
-                domain4[0] = xdom;
-                domain4[1] = ydom;
-                domain4[2] = intersection[2];
-
-                if (ldom_g.touches(domain4)) {
-                    intersection = ldom_g.intersect(domain4);
-
-                    requests.resize(requests.size() + 1);
-
-                    Communicate::size_type nsends;
-                    pack(intersection, view_g, fd_m, nghost_g, ldom_g, nsends);
-
-                    buffer_type buf =
-                        Comm->getBuffer<memory_space, Trhs>(IPPL_VICO_SEND + 4 * 8 + i, nsends);
-
-                    int tag = VICO_SOLVER_TAG + 4;
-
-                    Comm->isend(i, tag, fd_m, *buf, requests.back(), nsends);
-                    buf->resetWritePos();
-                }
-            }
-
-            if (domain2.touches(yz)) {
-                auto intersection = domain2.intersect(yz);
-                auto ydom         = ippl::Index((2 * size[1] - intersection[1].first()),
-                                                (2 * size[1] - intersection[1].last()), -1);
-                auto zdom         = ippl::Index((2 * size[2] - intersection[2].first()),
-                                                (2 * size[2] - intersection[2].last()), -1);
-
-                ippl::NDIndex<Dim> domain4;
-                domain4[0] = intersection[0];
-                domain4[1] = ydom;
-                domain4[2] = zdom;
-
-                if (ldom_g.touches(domain4)) {
-                    intersection = ldom_g.intersect(domain4);
-
-                    requests.resize(requests.size() + 1);
-
-                    Communicate::size_type nsends;
-                    pack(intersection, view_g, fd_m, nghost_g, ldom_g, nsends);
-
-                    buffer_type buf =
-                        Comm->getBuffer<memory_space, Trhs>(IPPL_VICO_SEND + 5 * 8 + i, nsends);
-
-                    int tag = VICO_SOLVER_TAG + 5;
-
-                    Comm->isend(i, tag, fd_m, *buf, requests.back(), nsends);
-                    buf->resetWritePos();
-                }
-            }
-
-            if (domain2.touches(xz)) {
-                auto intersection = domain2.intersect(xz);
-                auto xdom         = ippl::Index((2 * size[0] - intersection[0].first()),
-                                                (2 * size[0] - intersection[0].last()), -1);
-                auto zdom         = ippl::Index((2 * size[2] - intersection[2].first()),
-                                                (2 * size[2] - intersection[2].last()), -1);
-
-                ippl::NDIndex<Dim> domain4;
-                domain4[0] = xdom;
-                domain4[1] = intersection[1];
-                domain4[2] = zdom;
-
-                if (ldom_g.touches(domain4)) {
-                    intersection = ldom_g.intersect(domain4);
-
-                    requests.resize(requests.size() + 1);
-
-                    Communicate::size_type nsends;
-                    pack(intersection, view_g, fd_m, nghost_g, ldom_g, nsends);
-
-                    buffer_type buf =
-                        Comm->getBuffer<memory_space, Trhs>(IPPL_VICO_SEND + 6 * 8 + i, nsends);
-
-                    int tag = VICO_SOLVER_TAG + 6;
-
-                    Comm->isend(i, tag, fd_m, *buf, requests.back(), nsends);
-                    buf->resetWritePos();
-                }
-            }
-
-            if (domain2.touches(xyz)) {
-                auto intersection = domain2.intersect(xyz);
-                auto xdom         = ippl::Index((2 * size[0] - intersection[0].first()),
-                                                (2 * size[0] - intersection[0].last()), -1);
-                auto ydom         = ippl::Index((2 * size[1] - intersection[1].first()),
-                                                (2 * size[1] - intersection[1].last()), -1);
-                auto zdom         = ippl::Index((2 * size[2] - intersection[2].first()),
-                                                (2 * size[2] - intersection[2].last()), -1);
-
-                ippl::NDIndex<Dim> domain4;
-                domain4[0] = xdom;
-                domain4[1] = ydom;
-                domain4[2] = zdom;
-
-                if (ldom_g.touches(domain4)) {
-                    intersection = ldom_g.intersect(domain4);
-
-                    requests.resize(requests.size() + 1);
-
-                    Communicate::size_type nsends;
-                    pack(intersection, view_g, fd_m, nghost_g, ldom_g, nsends);
-
-                    buffer_type buf =
-                        Comm->getBuffer<memory_space, Trhs>(IPPL_VICO_SEND + 7 * 8 + i, nsends);
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    typename FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::green_cache::Key
+    FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::greensFunctionKey() const {
+        typename green_cache::Key key;
+        key.algorithm   = this->params_m.template get<int>("algorithm");
+        key.size        = nr_m;
+        key.spacing     = hr_m;
+        key.localDomain = layoutComplex_m->getLocalNDIndex();
+        key.ranks       = Comm->size();
+        return key;
+    }
 
-                    int tag = VICO_SOLVER_TAG + 7;
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::updateGreensFunction() {
+        static IpplTimings::TimerRef ginit = IpplTimings::getTimer("Green Init");
+        IpplTimings::startTimer(ginit);
 
-                    Comm->isend(i, tag, fd_m, *buf, requests.back(), nsends);
-                    buf->resetWritePos();
+        green_cache::setCapacity(this->params_m.template get<int>("green_cache_entries"));
+        const std::string file = this->params_m.template get<std::string>("green_cache_file");
+
+        // the Green's function is computed collectively, so all ranks
+        // must agree on whether it was found
+        auto onAllRanks = [](bool found) {
+            bool global = false;
+            MPI_Allreduce(&found, &global, 1, MPI_C_BOOL, MPI_LAND, Comm->getCommunicator());
+            return global;
+        };
+
+        const auto key = greensFunctionKey();
+        if (!onAllRanks(green_cache::lookup(key, grntr_m))) {
+            green_cache::detach(grntr_m);
+            bool loaded = !file.empty() && green_cache::load(file, key, grntr_m);
+            if (!onAllRanks(loaded)) {
+                greensFunction();
+                if (!file.empty()) {
+                    green_cache::save(file, key, grntr_m);
                 }
             }
+            green_cache::insert(key, grntr_m);
         }
+        greenValid_m = true;
 
-        // 3rd step: receive
-        for (int i = 0; i < ranks; ++i) {
-            if (ldom.touches(none)) {
-                auto intersection = ldom.intersect(none);
-
-                if (lDomains4[i].touches(intersection)) {
-                    intersection = intersection.intersect(lDomains4[i]);
-
-                    Communicate::size_type nrecvs;
-                    nrecvs = intersection.size();
-
-                    buffer_type buf =
-                        Comm->getBuffer<memory_space, Trhs>(IPPL_VICO_RECV + myRank, nrecvs);
-
-                    int tag = VICO_SOLVER_TAG;
-
-                    Comm->recv(i, tag, fd_m, *buf, nrecvs * sizeof(Trhs), nrecvs);
-                    buf->resetReadPos();
-
-                    unpack(intersection, view, fd_m, nghost, ldom);
-                }
-            }
-
-            if (ldom.touches(x)) {
-                auto intersection = ldom.intersect(x);
-
-                auto xdom = ippl::Index((2 * size[0] - intersection[0].first()),
-                                        (2 * size[0] - intersection[0].last()), -1);
-
-                ippl::NDIndex<Dim> domain4;
-                domain4[0] = xdom;
-                domain4[1] = intersection[1];
-                domain4[2] = intersection[2];
-
-                if (lDomains4[i].touches(domain4)) {
-                    domain4    = lDomains4[i].intersect(domain4);
-                    domain4[0] = ippl::Index(2 * size[0] - domain4[0].first(),
-                                             2 * size[0] - domain4[0].last(), -1);
-
-                    intersection = intersection.intersect(domain4);
-
-                    Communicate::size_type nrecvs;
-                    nrecvs = intersection.size();
-
-                    buffer_type buf =
-                        Comm->getBuffer<memory_space, Trhs>(IPPL_VICO_RECV + 8 + myRank, nrecvs);
-
-                    int tag = VICO_SOLVER_TAG + 1;
-
-                    Comm->recv(i, tag, fd_m, *buf, nrecvs * sizeof(Trhs), nrecvs);
-                    buf->resetReadPos();
-
-                    unpack(intersection, view, fd_m, nghost, ldom, true, false, false);
-                }
-            }
-
-            if (ldom.touches(y)) {
-                auto intersection = ldom.intersect(y);
-
-                auto ydom = ippl::Index((2 * size[1] - intersection[1].first()),
-                                        (2 * size[1] - intersection[1].last()), -1);
-
-                ippl::NDIndex<Dim> domain4;
-                domain4[0] = intersection[0];
-                domain4[1] = ydom;
-                domain4[2] = intersection[2];
-
-                if (lDomains4[i].touches(domain4)) {
-                    domain4    = lDomains4[i].intersect(domain4);
-                    domain4[1] = ippl::Index(2 * size[1] - domain4[1].first(),
-                                             2 * size[1] - domain4[1].last(), -1);
-
-                    intersection = intersection.intersect(domain4);
-
-                    Communicate::size_type nrecvs;
-                    nrecvs = intersection.size();
-
-                    buffer_type buf = Comm->getBuffer<memory_space, Trhs>(
-                        IPPL_VICO_RECV + 8 * 2 + myRank, nrecvs);
-
-                    int tag = VICO_SOLVER_TAG + 2;
-
-                    Comm->recv(i, tag, fd_m, *buf, nrecvs * sizeof(Trhs), nrecvs);
-                    buf->resetReadPos();
-
-                    unpack(intersection, view, fd_m, nghost, ldom, false, true, false);
-                }
-            }
-
-            if (ldom.touches(z)) {
-                auto intersection = ldom.intersect(z);
-
-                auto zdom = ippl::Index((2 * size[2] - intersection[2].first()),
-                                        (2 * size[2] - intersection[2].last()), -1);
-
-                ippl::NDIndex<Dim> domain4;
-                domain4[0] = intersection[0];
-                domain4[1] = intersection[1];
-                domain4[2] = zdom;
-
-                if (lDomains4[i].touches(domain4)) {
-                    domain4    = lDomains4[i].intersect(domain4);
-                    domain4[2] = ippl::Index(2 * size[2] - domain4[2].first(),
-                                             2 * size[2] - domain4[2].last(), -1);
-
-                    intersection = intersection.intersect(domain4);
-
-                    Communicate::size_type nrecvs;
-                    nrecvs = intersection.size();
-
-                    buffer_type buf = Comm->getBuffer<memory_space, Trhs>(
-                        IPPL_VICO_RECV + 8 * 3 + myRank, nrecvs);
-
-                    int tag = VICO_SOLVER_TAG + 3;
-
-                    Comm->recv(i, tag, fd_m, *buf, nrecvs * sizeof(Trhs), nrecvs);
-                    buf->resetReadPos();
-
-                    unpack(intersection, view, fd_m, nghost, ldom, false, false, true);
-                }
-            }
-
-            if (ldom.touches(xy)) {
-                auto intersection = ldom.intersect(xy);
-
-                auto xdom = ippl::Index((2 * size[0] - intersection[0].first()),
-                                        (2 * size[0] - intersection[0].last()), -1);
-                auto ydom = ippl::Index((2 * size[1] - intersection[1].first()),
-                                        (2 * size[1] - intersection[1].last()), -1);
-
-                ippl::NDIndex<Dim> domain4;
-                domain4[0] = xdom;
-                domain4[1] = ydom;
-                domain4[2] = intersection[2];
-
-                if (lDomains4[i].touches(domain4)) {
-                    domain4    = lDomains4[i].intersect(domain4);
-                    domain4[0] = ippl::Index(2 * size[0] - domain4[0].first(),
-                                             2 * size[0] - domain4[0].last(), -1);
-                    domain4[1] = ippl::Index(2 * size[1] - domain4[1].first(),
-                                             2 * size[1] - domain4[1].last(), -1);
-
-                    intersection = intersection.intersect(domain4);
-
-                    Communicate::size_type nrecvs;
-                    nrecvs = intersection.size();
-
-                    buffer_type buf = Comm->getBuffer<memory_space, Trhs>(
-                        IPPL_VICO_RECV + 8 * 4 + myRank, nrecvs);
-
-                    int tag = VICO_SOLVER_TAG + 4;
+        IpplTimings::stopTimer(ginit);
+    }
 
-                    Comm->recv(i, tag, fd_m, *buf, nrecvs * sizeof(Trhs), nrecvs);
-                    buf->resetReadPos();
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::communicateVico(
+        typename CxField_gt::view_type view_g, const ippl::NDIndex<Dim> ldom_g, const int nghost_g,
+        typename Field_t::view_type view, const ippl::NDIndex<Dim> ldom, const int nghost) {
+        // the blocks of the quadrants are found in buildVicoPlan
+        detail::exchange(vicoPlan_m.sends, vicoPlan_m.recvs, view_g, nghost_g, ldom_g, fd_m,
+                         VICO_SOLVER_TAG, IPPL_VICO_SEND, IPPL_VICO_RECV, [&](const auto& block) {
+                             detail::unpack(block.domain, view, fd_m, nghost, ldom, 0, 0,
+                                            block.mirror);
+                         });
+    }
 
-                    unpack(intersection, view, fd_m, nghost, ldom, true, true, false);
-                }
+    template <typename FieldLHS, typename FieldRHS, bool SinglePrecision>
+    void FFTPoissonSolver<FieldLHS, FieldRHS, SinglePrecision>::buildVicoPlan() {
+        const auto& lDomains2 = layout2_m->getHostLocalDomains();
+        const auto& lDomains4 = layout4_m->getHostLocalDomains();
+        const auto& ldom2     = layout2_m->getLocalNDIndex();
+        const auto& ldom4     = layout4_m->getLocalNDIndex();
+
+        vicoPlan_m = detail::CommPlan<Dim>();
+
+        // The doubled grid consists of 2^Dim quadrants. The lower quadrant is taken
+        // from the 4N grid as is, the others are mirror images of the lower half
+        // of the 4N grid in the dimensions in which they are upper.
+        // Each quadrant uses its own tag.
+        for (int q = 0; q < (1 << Dim); ++q) {
+            Vector<bool, Dim> mirror;
+            NDIndex<Dim> quadrant;
+            for (unsigned d = 0; d < Dim; ++d) {
+                mirror[d]   = q & (1 << d);
+                quadrant[d] = mirror[d] ? Index(nr_m[d], 2 * nr_m[d] - 1) : Index(nr_m[d]);
             }
 
-            if (ldom.touches(yz)) {
-                auto intersection = ldom.intersect(yz);
-
-                auto ydom = ippl::Index((2 * size[1] - intersection[1].first()),
-                                        (2 * size[1] - intersection[1].last()), -1);
-                auto zdom = ippl::Index((2 * size[2] - intersection[2].first()),
-                                        (2 * size[2] - intersection[2].last()), -1);
-
-                ippl::NDIndex<Dim> domain4;
-                domain4[0] = intersection[0];
-                domain4[1] = ydom;
-                domain4[2] = zdom;
-
-                if (lDomains4[i].touches(domain4)) {
-                    domain4    = lDomains4[i].intersect(domain4);
-                    domain4[1] = ippl::Index(2 * size[1] - domain4[1].first(),
-                                             2 * size[1] - domain4[1].last(), -1);
-                    domain4[2] = ippl::Index(2 * size[2] - domain4[2].first(),
-                                             2 * size[2] - domain4[2].last(), -1);
-
-                    intersection = intersection.intersect(domain4);
-
-                    Communicate::size_type nrecvs;
-                    nrecvs = intersection.size();
-
-                    buffer_type buf = Comm->getBuffer<memory_space, Trhs>(
-                        IPPL_VICO_RECV + 8 * 5 + myRank, nrecvs);
-
-                    int tag = VICO_SOLVER_TAG + 5;
-
-                    Comm->recv(i, tag, fd_m, *buf, nrecvs * sizeof(Trhs), nrecvs);
-                    buf->resetReadPos();
-
-                    unpack(intersection, view, fd_m, nghost, ldom, false, true, true);
+            // maps a domain of the quadrant to the 4N grid and back
+            auto reflect = [&](NDIndex<Dim> domain) {
+                for (unsigned d = 0; d < Dim; ++d) {
+                    if (mirror[d]) {
+                        domain[d] = Index(2 * nr_m[d] - domain[d].first(),
+                                          2 * nr_m[d] - domain[d].last(), -1);
+                    }
                 }
-            }
-
-            if (ldom.touches(xz)) {
-                auto intersection = ldom.intersect(xz);
-
-                auto xdom = ippl::Index((2 * size[0] - intersection[0].first()),
-                                        (2 * size[0] - intersection[0].last()), -1);
-                auto zdom = ippl::Index((2 * size[2] - intersection[2].first()),
-                                        (2 * size[2] - intersection[2].last()), -1);
-
-                ippl::NDIndex<Dim> domain4;
-                domain4[0] = xdom;
-                domain4[1] = intersection[1];
-                domain4[2] = zdom;
-
-                if (lDomains4[i].touches(domain4)) {
-                    domain4    = lDomains4[i].intersect(domain4);
-                    domain4[0] = ippl::Index(2 * size[0] - domain4[0].first(),
-                                             2 * size[0] - domain4[0].last(), -1);
-                    domain4[2] = ippl::Index(2 * size[2] - domain4[2].first(),
-                                             2 * size[2] - domain4[2].last(), -1);
-
-                    intersection = intersection.intersect(domain4);
-
-                    Communicate::size_type nrecvs;
-                    nrecvs = intersection.size();
-
-                    buffer_type buf = Comm->getBuffer<memory_space, Trhs>(
-                        IPPL_VICO_RECV + 8 * 6 + myRank, nrecvs);
-
-                    int tag = VICO_SOLVER_TAG + 6;
-
-                    Comm->recv(i, tag, fd_m, *buf, nrecvs * sizeof(Trhs), nrecvs);
-                    buf->resetReadPos();
-
-                    unpack(intersection, view, fd_m, nghost, ldom, true, false, true);
+                return domain;
+            };
+
+            for (int i = 0; i < Comm->size(); ++i) {
+                // the part of rank i's quadrant that this rank holds
+                if (lDomains2[i].touches(quadrant)) {
+                    auto domain4 = reflect(lDomains2[i].intersect(quadrant));
+                    if (ldom4.touches(domain4)) {
+                        vicoPlan_m.sends.push_back({i, q, ldom4.intersect(domain4), mirror});
+                    }
                 }
-            }
 
-            if (ldom.touches(xyz)) {
-                auto intersection = ldom.intersect(xyz);
-
-                auto xdom = ippl::Index((2 * size[0] - intersection[0].first()),
-                                        (2 * size[0] - intersection[0].last()), -1);
-                auto ydom = ippl::Index((2 * size[1] - intersection[1].first()),
-                                        (2 * size[1] - intersection[1].last()), -1);
-                auto zdom = ippl::Index((2 * size[2] - intersection[2].first()),
-                                        (2 * size[2] - intersection[2].last()), -1);
-
-                ippl::NDIndex<Dim> domain4;
-                domain4[0] = xdom;
-                domain4[1] = ydom;
-                domain4[2] = zdom;
-
-                if (lDomains4[i].touches(domain4)) {
-                    domain4    = lDomains4[i].intersect(domain4);
-                    domain4[0] = ippl::Index(2 * size[0] - domain4[0].first(),
-                                             2 * size[0] - domain4[0].last(), -1);
-                    domain4[1] = ippl::Index(2 * size[1] - domain4[1].first(),
-                                             2 * size[1] - domain4[1].last(), -1);
-                    domain4[2] = ippl::Index(2 * size[2] - domain4[2].first(),
-                                             2 * size[2] - domain4[2].last(), -1);
-
-                    intersection = intersection.intersect(domain4);
-
-                    Communicate::size_type nrecvs;
-                    nrecvs = intersection.size();
-
-                    buffer_type buf = Comm->getBuffer<memory_space, Trhs>(
-                        IPPL_VICO_RECV + 8 * 7 + myRank, nrecvs);
-
-                    int tag = VICO_SOLVER_TAG + 7;
-
-                    Comm->recv(i, tag, fd_m, *buf, nrecvs * sizeof(Trhs), nrecvs);
-                    buf->resetReadPos();
-
-                    unpack(intersection, view, fd_m, nghost, ldom, true, true, true);
+                // the part of this rank's quadrant that rank i holds
+                if (ldom2.touches(quadrant)) {
+                    auto intersection = ldom2.intersect(quadrant);
+                    auto domain4      = reflect(intersection);
+                    if (lDomains4[i].touches(domain4)) {
+                        domain4      = reflect(lDomains4[i].intersect(domain4));
+                        intersection = intersection.intersect(domain4);
+                        vicoPlan_m.recvs.push_back({i, q, intersection, mirror});
+                    }
                 }
             }
         }
-
-        if (requests.size() > 0) {
-            MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
-        }
-        Comm->barrier();
-    };
+    }
 }  // namespace ippl
@@ -0,0 +1,127 @@
+//
+// Class FFTTrigPoissonSolver
+//   FFT-based Poisson solver for a box with homogeneous Dirichlet or Neumann
+//   boundaries, using the sine or cosine transform respectively.
+//   Solves laplace(phi) = -rho, and E = -grad(phi).
+//
+//   The fields are cell-centred and the boundaries lie on the cell faces at the
+//   edges of the domain. heFFTe's sine and cosine transforms are of type II
+//   forward and type III backward, whose basis functions are the eigenvectors
+//   of the Laplacian with exactly these boundaries, so the solve is a pointwise
+//   division in transform space. The eigenvalues are either those of the
+//   second-order finite difference Laplacian, which makes the result the exact
+//   solution of the discretized problem, or those of the continuous Laplacian.
+//
+//   With Neumann boundaries the constant mode is discarded: the charge density
+//   is solved for with its mean removed and the potential has zero mean.
+//
+
+#ifndef IPPL_FFT_TRIG_POISSON_SOLVER_H
+#define IPPL_FFT_TRIG_POISSON_SOLVER_H
+
+#include <Kokkos_MathematicalConstants.hpp>
+#include <memory>
+#include <type_traits>
+
+#include "Utility/IpplException.h"
+#include "Utility/IpplTimings.h"
+
+#include "Electrostatics.h"
+#include "FFT/FFT.h"
+#include "FieldLayout/FieldLayout.h"
+
+namespace ippl {
+
+    template <typename FieldLHS, typename FieldRHS, typename Transform>
+    class FFTTrigPoissonSolver : public Electrostatics<FieldLHS, FieldRHS> {
+        constexpr static unsigned Dim = FieldLHS::dim;
+        using Trhs                    = typename FieldRHS::value_type;
+        using mesh_type               = typename FieldRHS::Mesh_t;
+
+        static_assert(std::is_same_v<Transform, SineTransform>
+                          || std::is_same_v<Transform, CosTransform>,
+                      "FFTTrigPoissonSolver requires a sine or cosine transform");
+
+        // sine transforms give homogeneous Dirichlet, cosine transforms
+        // homogeneous Neumann boundaries
+        constexpr static bool isDirichlet = std::is_same_v<Transform, SineTransform>;
+
+    public:
+        using Field_t  = FieldRHS;
+        using FFT_t    = FFT<Transform, FieldRHS>;
+        using Layout_t = FieldLayout<Dim>;
+
+        using Base = Electrostatics<FieldLHS, FieldRHS>;
+        using typename Base::lhs_type, typename Base::rhs_type;
+        using scalar_type = typename mesh_type::value_type;
+        using vector_type = typename mesh_type::vector_type;
+
+        /*!
+         * Eigenvalues used to invert the Laplacian in transform space
+         */
+        enum EigenvalueType {
+            FINITE_DIFFERENCE = 0,
+            SPECTRAL          = 1
+        };
+
+        FFTTrigPoissonSolver();
+        FFTTrigPoissonSolver(rhs_type& rhs, ParameterList& params);
+        FFTTrigPoissonSolver(lhs_type& lhs, rhs_type& rhs, ParameterList& params);
+        ~FFTTrigPoissonSolver() = default;
+
+        void setRhs(rhs_type& rhs) override;
+
+        void solve() override;
+
+    private:
+        void initialize();
+
+        // divide the transformed charge density by the eigenvalues of the Laplacian
+        void scaleByEigenvalues(Field_t& field);
+
+        // centred differences of the potential, with the ghost values across the
+        // domain boundaries given by the boundary condition
+        void gradient();
+
+        std::shared_ptr<FFT_t> fft_mp;
+
+        // potential with ghost cells for the gradient, and the transformed density
+        // when only the gradient is requested
+        Field_t phi_m;
+
+        NDIndex<Dim> domain_m;
+
+    protected:
+        virtual void setDefaultParameters() override {
+            using heffteBackend       = typename FFT_t::heffteBackend;
+            heffte::plan_options opts = heffte::default_options<heffteBackend>();
+            this->params_m.add("use_pencils", opts.use_pencils);
+            this->params_m.add("use_reorder", opts.use_reorder);
+            this->params_m.add("use_gpu_aware", opts.use_gpu_aware);
+
+            switch (opts.algorithm) {
+                case heffte::reshape_algorithm::alltoall:
+                    this->params_m.add("comm", a2a);
+                    break;
+                case heffte::reshape_algorithm::alltoallv:
+                    this->params_m.add("comm", a2av);
+                    break;
+                case heffte::reshape_algorithm::p2p:
+                    this->params_m.add("comm", p2p);
+                    break;
+                case heffte::reshape_algorithm::p2p_plined:
+                    this->params_m.add("comm", p2p_pl);
+                    break;
+                default:
+                    throw IpplException("FFTTrigPoissonSolver::setDefaultParameters",
+                                        "Unrecognized heffte communication type");
+            }
+
+            this->params_m.add("eigenvalues", FINITE_DIFFERENCE);
+        }
+    };
+}  // namespace ippl
+
+#include "Solver/FFTTrigPoissonSolver.hpp"
+
+#endif
@@ -0,0 +1,193 @@
+//
+// Class FFTTrigPoissonSolver
+//   FFT-based Poisson solver for a box with homogeneous Dirichlet or Neumann
+//   boundaries, using the sine or cosine transform respectively.
+//
+
+namespace ippl {
+
+    /////////////////////////////////////////////////////////////////////////
+    // constructors
+    template <typename FieldLHS, typename FieldRHS, typename Transform>
+    FFTTrigPoissonSolver<FieldLHS, FieldRHS, Transform>::FFTTrigPoissonSolver()
+        : Base() {
+        setDefaultParameters();
+    }
+
+    template <typename FieldLHS, typename FieldRHS, typename Transform>
+    FFTTrigPoissonSolver<FieldLHS, FieldRHS, Transform>::FFTTrigPoissonSolver(
+        rhs_type& rhs, ParameterList& params) {
+        using T = typename FieldLHS::value_type::value_type;
+        static_assert(std::is_floating_point<T>::value, "Not a floating point type");
+
+        setDefaultParameters();
+        this->params_m.merge(params);
+        this->params_m.update("output_type", Base::SOL);
+
+        this->setRhs(rhs);
+    }
+
+    template <typename FieldLHS, typename FieldRHS, typename Transform>
+    FFTTrigPoissonSolver<FieldLHS, FieldRHS, Transform>::FFTTrigPoissonSolver(
+        lhs_type& lhs, rhs_type& rhs, ParameterList& params) {
+        using T = typename FieldLHS::value_type::value_type;
+        static_assert(std::is_floating_point<T>::value, "Not a floating point type");
+
+        setDefaultParameters();
+        this->params_m.merge(params);
+
+        this->setLhs(lhs);
+        this->setRhs(rhs);
+    }
+
+    template <typename FieldLHS, typename FieldRHS, typename Transform>
+    void FFTTrigPoissonSolver<FieldLHS, FieldRHS, Transform>::setRhs(rhs_type& rhs) {
+        bool needsReinit =
+            this->rhs_mp != &rhs || (this->rhs_mp && this->rhs_mp->getLayout() != rhs.getLayout());
+        Base::setRhs(rhs);
+        if (needsReinit) {
+            initialize();
+        }
+    }
+
+    template <typename FieldLHS, typename FieldRHS, typename Transform>
+    void FFTTrigPoissonSolver<FieldLHS, FieldRHS, Transform>::initialize() {
+        Layout_t& layout = this->rhs_mp->getLayout();
+        domain_m         = layout.getDomain();
+
+        const int out = this->params_m.template get<int>("output_type");
+        if (out == Base::GRAD || out == Base::SOL_AND_GRAD) {
+            phi_m.initialize(this->rhs_mp->get_mesh(), layout, this->rhs_mp->getNghost());
+        }
+
+        fft_mp = std::make_shared<FFT_t>(layout, this->params_m);
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // compute the electric potential and/or field given a charge density
+    template <typename FieldLHS, typename FieldRHS, typename Transform>
+    void FFTTrigPoissonSolver<FieldLHS, FieldRHS, Transform>::solve() {
+        static IpplTimings::TimerRef solve = IpplTimings::getTimer("Solve");
+        IpplTimings::startTimer(solve);
+
+        const int out = this->params_m.template get<int>("output_type");
+
+        // the transforms are in place; the potential is stored in the RHS unless
+        // only the gradient is requested, in which case the RHS is left untouched
+        Field_t* phi = this->rhs_mp;
+        if (out == Base::GRAD) {
+            Kokkos::deep_copy(phi_m.getView(), this->rhs_mp->getView());
+            phi = &phi_m;
+        } else if (out != Base::SOL && out != Base::SOL_AND_GRAD) {
+            throw IpplException("FFTTrigPoissonSolver::solve", "Unrecognized output_type");
+        }
+
+        static IpplTimings::TimerRef fftrho = IpplTimings::getTimer("FFT: Rho");
+        IpplTimings::startTimer(fftrho);
+        fft_mp->transform(FORWARD, *phi);
+        IpplTimings::stopTimer(fftrho);
+
+        scaleByEigenvalues(*phi);
+
+        static IpplTimings::TimerRef fftphi = IpplTimings::getTimer("FFT: Potential");
+        IpplTimings::startTimer(fftphi);
+        fft_mp->transform(BACKWARD, *phi);
+        IpplTimings::stopTimer(fftphi);
+
+        if (out == Base::GRAD || out == Base::SOL_AND_GRAD) {
+            static IpplTimings::TimerRef efield = IpplTimings::getTimer("Solve: Electric field");
+            IpplTimings::startTimer(efield);
+
+            if (phi != &phi_m) {
+                Kokkos::deep_copy(phi_m.getView(), phi->getView());
+            }
+            gradient();
+
+            IpplTimings::stopTimer(efield);
+        }
+
+        IpplTimings::stopTimer(solve);
+    }
+
+    template <typename FieldLHS, typename FieldRHS, typename Transform>
+    void FFTTrigPoissonSolver<FieldLHS, FieldRHS, Transform>::scaleByEigenvalues(Field_t& field) {
+        const scalar_type pi = Kokkos::numbers::pi_v<scalar_type>;
+
+        auto view           = field.getView();
+        const int nghost    = field.getNghost();
+        const auto& lDom    = field.getLayout().getLocalNDIndex();
+        const vector_type h = field.get_mesh().getMeshSpacing();
+
+        Vector<int, Dim> N;
+        for (unsigned d = 0; d < Dim; ++d) {
+            N[d] = domain_m[d].length();
+        }
+
+        // the type II sine transform starts at the first harmonic, the
+        // cosine transform at the constant mode
+        const int offset    = isDirichlet ? 1 : 0;
+        const bool spectral = this->params_m.template get<int>("eigenvalues") == SPECTRAL;
+
+        using index_array_type = typename RangePolicy<Dim>::index_array_type;
+        ippl::parallel_for(
+            "Eigenvalue scaling FFTTrigPoissonSolver", getRangePolicy(view, nghost),
+            KOKKOS_LAMBDA(const index_array_type& args) {
+                scalar_type eigenvalue = 0;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    const int m = args[d] - nghost + lDom[d].first() + offset;
+                    if (spectral) {
+                        const scalar_type k = pi * m / (N[d] * h[d]);
+                        eigenvalue += k * k;
+                    } else {
+                        const scalar_type s = 2 / h[d] * Kokkos::sin(pi * m / (2 * N[d]));
+                        eigenvalue += s * s;
+                    }
+                }
+
+                // only the constant Neumann mode has a zero eigenvalue
+                bool isNotZero     = (eigenvalue != 0.0);
+                scalar_type factor = isNotZero * (1.0 / (eigenvalue + ((!isNotZero) * 1.0)));
+
+                apply(view, args) *= factor;
+            });
+    }
+
+    template <typename FieldLHS, typename FieldRHS, typename Transform>
+    void FFTTrigPoissonSolver<FieldLHS, FieldRHS, Transform>::gradient() {
+        phi_m.fillHalo();
+
+        auto viewP          = phi_m.getView();
+        auto viewE          = this->lhs_mp->getView();
+        const int nghostP   = phi_m.getNghost();
+        const int nghostE   = this->lhs_mp->getNghost();
+        const auto& lDom    = phi_m.getLayout().getLocalNDIndex();
+        const vector_type h = phi_m.get_mesh().getMeshSpacing();
+
+        Vector<int, Dim> N;
+        for (unsigned d = 0; d < Dim; ++d) {
+            N[d] = domain_m[d].length();
+        }
+
+        // the potential is odd about a Dirichlet and even about a Neumann face
+        const scalar_type mirror = isDirichlet ? -1 : 1;
+
+        using index_array_type = typename RangePolicy<Dim>::index_array_type;
+        ippl::parallel_for(
+            "Gradient FFTTrigPoissonSolver", getRangePolicy(viewP, nghostP),
+            KOKKOS_LAMBDA(const index_array_type& args) {
+                const scalar_type center = apply(viewP, args);
+                for (unsigned d = 0; d < Dim; ++d) {
+                    const int ig = args[d] - nghostP + lDom[d].first();
+
+                    index_array_type lo = args, hi = args;
+                    lo[d] -= 1;
+                    hi[d] += 1;
+
+                    const scalar_type left  = (ig == 0) ? mirror * center : apply(viewP, lo);
+                    const scalar_type right = (ig == N[d] - 1) ? mirror * center : apply(viewP, hi);
+
+                    apply(viewE, args - nghostP + nghostE)[d] = -(right - left) / (2 * h[d]);
+                }
+            });
+    }
+}  // namespace ippl
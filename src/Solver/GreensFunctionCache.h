@@ -0,0 +1,122 @@
+//
+// Class GreensFunctionCache
+//   Process-wide cache of transformed Green's functions for FFT-based solvers,
+//   shared by all solver instances. Entries are keyed by the algorithm, the grid
+//   size, the mesh spacing and the local domain of the transformed field on this
+//   rank, so any solver with an identical setup can reuse an entry instead of
+//   recomputing it. The cache stores the field views themselves; a solver that
+//   adopts a cached view shares its memory with the cache and must reallocate its
+//   view before computing a different Green's function into it. The least recently
+//   used entries are evicted once the capacity is exceeded.
+//
+//   Entries can also be written to and read from binary files, one per rank, so
+//   that later runs or restarts with an identical setup can skip the computation.
+//   A file whose header does not match the requested key is ignored.
+//
+
+#ifndef IPPL_GREENS_FUNCTION_CACHE_H
+#define IPPL_GREENS_FUNCTION_CACHE_H
+
+#include <map>
+#include <string>
+
+#include "Types/Vector.h"
+
+#include "Index/NDIndex.h"
+
+namespace ippl {
+
+    template <typename Field>
+    class GreensFunctionCache {
+        constexpr static unsigned Dim = Field::dim;
+
+    public:
+        using view_type   = typename Field::view_type;
+        using scalar_type = typename Field::Mesh_t::value_type;
+
+        /*!
+         * Identifies a Green's function on this rank
+         */
+        struct Key {
+            int algorithm;
+            Vector<int, Dim> size;
+            Vector<scalar_type, Dim> spacing;
+            NDIndex<Dim> localDomain;
+            int ranks;
+
+            bool operator<(const Key& other) const;
+            bool operator==(const Key& other) const;
+        };
+
+        /*!
+         * Makes a field use the cached view for a key
+         * @param key the key
+         * @param field the field whose view is replaced by the cached one
+         * @return Whether the key was found
+         */
+        static bool lookup(const Key& key, Field& field);
+
+        /*!
+         * Adds the view of a field to the cache; the view is shared, not copied
+         * @param key the key
+         * @param field the field holding the Green's function
+         */
+        static void insert(const Key& key, Field& field);
+
+        /*!
+         * Ensures that a field does not share its view with the cache, so that
+         * it can be overwritten
+         * @param field the field
+         */
+        static void detach(Field& field);
+
+        /*!
+         * Reads a Green's function from this rank's file
+         * @param path the file path, to which the rank is appended
+         * @param key the expected key
+         * @param field the field in which to store the Green's function
+         * @return Whether a matching file was found and read
+         */
+        static bool load(const std::string& path, const Key& key, Field& field);
+
+        /*!
+         * Writes a Green's function to this rank's file
+         * @param path the file path, to which the rank is appended
+         * @param key the key
+         * @param field the field holding the Green's function
+         */
+        static void save(const std::string& path, const Key& key, const Field& field);
+
+        /*!
+         * Sets the maximum number of cached Green's functions
+         * @param capacity the capacity; 0 disables caching
+         */
+        static void setCapacity(size_t capacity);
+
+        static size_t size() { return entries().size(); }
+
+        /*!
+         * Removes all cached Green's functions
+         */
+        static void clear() { entries().clear(); }
+
+    private:
+        struct Entry {
+            view_type view;
+            size_t lastUse;
+        };
+
+        static std::map<Key, Entry>& entries();
+
+        static void evict();
+
+        static std::string fileName(const std::string& path);
+
+        inline static size_t capacity_m = 4;
+        inline static size_t clock_m    = 0;
+    };
+}  // namespace ippl
+
+#include "Solver/GreensFunctionCache.hpp"
+
+#endif
@@ -0,0 +1,182 @@
+//
+// Class GreensFunctionCache
+//   Process-wide cache of transformed Green's functions for FFT-based solvers.
+//
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "Utility/IpplException.h"
+
+namespace ippl {
+    namespace detail {
+        /*!
+         * Builds the header of a cached Green's function file, which
+         * identifies the key and the extents of the stored view
+         */
+        template <typename Key, typename View, unsigned Dim>
+        std::vector<char> greensFunctionHeader(const Key& key, const View& view) {
+            std::vector<char> header;
+            auto write = [&]<typename T>(const T& value) {
+                const char* bytes = reinterpret_cast<const char*>(&value);
+                header.insert(header.end(), bytes, bytes + sizeof(T));
+            };
+
+            const char magic[8] = {'I', 'P', 'P', 'L', 'G', 'R', 'N', '1'};
+            header.insert(header.end(), magic, magic + sizeof(magic));
+            write(static_cast<std::uint32_t>(Dim));
+            write(static_cast<std::uint32_t>(sizeof(typename View::value_type)));
+            write(static_cast<std::int32_t>(key.algorithm));
+            write(static_cast<std::int32_t>(key.ranks));
+            for (unsigned d = 0; d < Dim; ++d) {
+                write(static_cast<std::int32_t>(key.size[d]));
+                write(key.spacing[d]);
+                write(static_cast<std::int32_t>(key.localDomain[d].first()));
+                write(static_cast<std::int32_t>(key.localDomain[d].last()));
+            }
+            for (unsigned r = 0; r < View::rank; ++r) {
+                write(static_cast<std::uint64_t>(view.extent(r)));
+            }
+            return header;
+        }
+    }  // namespace detail
+
+    template <typename Field>
+    bool GreensFunctionCache<Field>::Key::operator<(const Key& other) const {
+        if (algorithm != other.algorithm) {
+            return algorithm < other.algorithm;
+        }
+        if (ranks != other.ranks) {
+            return ranks < other.ranks;
+        }
+        for (unsigned d = 0; d < Dim; ++d) {
+            if (size[d] != other.size[d]) {
+                return size[d] < other.size[d];
+            }
+            if (spacing[d] != other.spacing[d]) {
+                return spacing[d] < other.spacing[d];
+            }
+            if (localDomain[d].first() != other.localDomain[d].first()) {
+                return localDomain[d].first() < other.localDomain[d].first();
+            }
+            if (localDomain[d].last() != other.localDomain[d].last()) {
+                return localDomain[d].last() < other.localDomain[d].last();
+            }
+        }
+        return false;
+    }
+
+    template <typename Field>
+    bool GreensFunctionCache<Field>::Key::operator==(const Key& other) const {
+        return !(*this < other) && !(other < *this);
+    }
+
+    template <typename Field>
+    bool GreensFunctionCache<Field>::lookup(const Key& key, Field& field) {
+        auto& cache = entries();
+        auto it     = cache.find(key);
+        if (it == cache.end()) {
+            return false;
+        }
+        it->second.lastUse = ++clock_m;
+        field.getView()    = it->second.view;
+        return true;
+    }
+
+    template <typename Field>
+    void GreensFunctionCache<Field>::insert(const Key& key, Field& field) {
+        if (capacity_m == 0) {
+            return;
+        }
+        entries()[key] = Entry{field.getView(), ++clock_m};
+        evict();
+    }
+
+    template <typename Field>
+    void GreensFunctionCache<Field>::detach(Field& field) {
+        view_type& view = field.getView();
+        if (view.use_count() > 1) {
+            view = view_type(Kokkos::view_alloc(Kokkos::WithoutInitializing, view.label()),
+                             view.layout());
+        }
+    }
+
+    template <typename Field>
+    bool GreensFunctionCache<Field>::load(const std::string& path, const Key& key, Field& field) {
+        std::ifstream file(fileName(path), std::ios::binary);
+        if (!file) {
+            return false;
+        }
+
+        const view_type& view    = field.getView();
+        std::vector<char> header = detail::greensFunctionHeader<Key, view_type, Dim>(key, view);
+        std::vector<char> stored(header.size());
+        if (!file.read(stored.data(), stored.size())
+            || std::memcmp(stored.data(), header.data(), header.size()) != 0) {
+            return false;
+        }
+
+        auto hostView = Kokkos::create_mirror_view(view);
+        if (!file.read(reinterpret_cast<char*>(hostView.data()),
+                       hostView.span() * sizeof(typename view_type::value_type))) {
+            return false;
+        }
+        Kokkos::deep_copy(view, hostView);
+        return true;
+    }
+
+    template <typename Field>
+    void GreensFunctionCache<Field>::save(const std::string& path, const Key& key,
+                                          const Field& field) {
+        std::ofstream file(fileName(path), std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw IpplException("GreensFunctionCache::save",
+                                "Cannot open " + fileName(path) + " for writing");
+        }
+
+        const view_type& view    = field.getView();
+        std::vector<char> header = detail::greensFunctionHeader<Key, view_type, Dim>(key, view);
+        file.write(header.data(), header.size());
+
+        auto hostView = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), view);
+        file.write(reinterpret_cast<const char*>(hostView.data()),
+                   hostView.span() * sizeof(typename view_type::value_type));
+    }
+
+    template <typename Field>
+    void GreensFunctionCache<Field>::setCapacity(size_t capacity) {
+        capacity_m = capacity;
+        evict();
+    }
+
+    template <typename Field>
+    void GreensFunctionCache<Field>::evict() {
+        auto& cache = entries();
+        while (cache.size() > capacity_m) {
+            auto oldest = std::min_element(cache.begin(), cache.end(), [](auto& a, auto& b) {
+                return a.second.lastUse < b.second.lastUse;
+            });
+            cache.erase(oldest);
+        }
+    }
+
+    template <typename Field>
+    std::string GreensFunctionCache<Field>::fileName(const std::string& path) {
+        return path + "." + std::to_string(Comm->rank());
+    }
+
+    template <typename Field>
+    std::map<typename GreensFunctionCache<Field>::Key, typename GreensFunctionCache<Field>::Entry>&
+    GreensFunctionCache<Field>::entries() {
+        static std::map<Key, Entry> cache;
+        // the cached views must be freed before Kokkos is finalized
+        static bool hooked = [] {
+            Kokkos::push_finalize_hook([] { cache.clear(); });
+            return true;
+        }();
+        (void)hooked;
+        return cache;
+    }
+}  // namespace ippl
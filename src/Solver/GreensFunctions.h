@@ -0,0 +1,32 @@
+//
+// File GreensFunctions
+//   Helpers shared by the Green's functions of the FFT-based solvers.
+//
+
+#ifndef IPPL_GREENS_FUNCTIONS_H
+#define IPPL_GREENS_FUNCTIONS_H
+
+#include <cmath>
+
+namespace ippl {
+    namespace detail {
+        /*!
+         * The average of ln(r) over a cell of the open plane centered at the
+         * origin, which replaces the singularity of the 2D Green's function
+         * @param ha the mesh spacing in the first open dimension
+         * @param hb the mesh spacing in the second open dimension
+         * @return The average of ln(r) over the cell
+         */
+        template <typename T>
+        T cellAverageLog(T ha, T hb) {
+            const T halfA = 0.5 * ha;
+            const T halfB = 0.5 * hb;
+            return 0.5
+                   * (std::log(halfA * halfA + halfB * halfB) - 3
+                      + halfA / halfB * std::atan(halfB / halfA)
+                      + halfB / halfA * std::atan(halfA / halfB));
+        }
+    }  // namespace detail
+}  // namespace ippl
+
+#endif
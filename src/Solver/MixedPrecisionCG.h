@@ -0,0 +1,115 @@
+//
+// Class MixedPrecisionCG
+//   Conjugate gradient algorithm with mixed-precision iterative refinement.
+//   The residue and the solution are kept in the precision of the LHS, while the
+//   correction equation op(e) = r is solved approximately by an inner CG that works
+//   entirely on lower precision copies of the fields, which halves the memory traffic
+//   of the stencil and vector updates as well as the size of halo messages for
+//   single precision. The refinement is repeated until the residue meets the
+//   tolerance, so the accuracy of the solution matches a solve in full precision.
+//
+
+#ifndef IPPL_MIXED_PRECISION_CG_H
+#define IPPL_MIXED_PRECISION_CG_H
+
+#include "PCG.h"
+
+namespace ippl {
+
+    template <typename OpRet, typename FieldLHS, typename FieldRHS, typename LowOpRet,
+              typename FieldLow>
+    class MixedPrecisionCG : public PCG<OpRet, FieldLHS, FieldRHS> {
+        using Base = PCG<OpRet, FieldLHS, FieldRHS>;
+        typedef typename Base::lhs_type::value_type T;
+        typedef typename FieldLow::value_type Tlow;
+
+    public:
+        using typename Base::lhs_type, typename Base::rhs_type;
+        using low_type                  = FieldLow;
+        using inner_operator_type       = std::function<LowOpRet(low_type)>;
+        using inner_preconditioner_type = Preconditioner<low_type>;
+
+        /*!
+         * Sets the operator used by the inner solver
+         * @param op A function that returns LowOpRet and takes a low precision field
+         */
+        void setInnerOperator(inner_operator_type op) { inner_m.setOperator(std::move(op)); }
+
+        /*!
+         * Sets the preconditioner of the inner solver
+         * @param precond The preconditioner, or nullptr for unpreconditioned CG
+         */
+        void setInnerPreconditioner(std::shared_ptr<inner_preconditioner_type> precond) {
+            inner_m.setPreconditioner(std::move(precond));
+        }
+
+        /*!
+         * Query the number of refinement steps of the last solve; the iteration
+         * count is the total number of inner iterations
+         * @return Refinement step count of last solve
+         */
+        int getRefinementCount() const { return refinements_m; }
+
+        void operator()(lhs_type& lhs, rhs_type& rhs, const ParameterList& params) override {
+            typename lhs_type::Mesh_t& mesh     = lhs.get_mesh();
+            typename lhs_type::Layout_t& layout = lhs.getLayout();
+
+            auto& op = this->op_m;
+
+            this->iterations_m      = 0;
+            refinements_m           = 0;
+            const int maxIterations = params.get<int>("max_iterations");
+            const int maxRefinement = params.get<int>("max_refinements");
+
+            BConds<low_type, lhs_type::dim> lowBC;
+            bool allFacesPeriodic = Base::makeResidueBCs(lhs, lowBC);
+
+            auto rHandle    = FieldPool<lhs_type>::acquire(mesh, layout);
+            auto rLowHandle = FieldPool<low_type>::acquire(mesh, layout);
+            auto eLowHandle = FieldPool<low_type>::acquire(mesh, layout);
+
+            lhs_type& r    = *rHandle;
+            low_type& rLow = *rLowHandle;
+            low_type& eLow = *eLowHandle;
+            eLow.setFieldBC(lowBC);
+
+            // the inner tolerance is relative to the residue of the current step
+            ParameterList innerParams;
+            innerParams.add("tolerance", static_cast<Tlow>(params.get<T>("inner_tolerance")));
+            innerParams.add("max_iterations", maxIterations);
+
+            T rr              = fused(assign(r, rhs - op(lhs)), reduce(r * r))[0];
+            const T tolerance = params.get<T>("tolerance") * norm(rhs);
+
+            this->residueNorm = std::sqrt(rr);
+            while (this->residueNorm > tolerance && refinements_m < maxRefinement
+                   && this->iterations_m < maxIterations) {
+                // Solve for the correction in low precision
+                rLow = r;
+                eLow = 0;
+                innerParams.update("max_iterations", maxIterations - this->iterations_m);
+                inner_m(eLow, rLow, innerParams);
+                this->iterations_m += inner_m.getIterationCount();
+
+                // Update and recompute the residue in full precision
+                lhs = lhs + eLow;
+                rr  = fused(assign(r, rhs - op(lhs)), reduce(r * r))[0];
+
+                this->residueNorm = std::sqrt(rr);
+                ++refinements_m;
+            }
+
+            if (allFacesPeriodic) {
+                T avg = lhs.getVolumeAverage();
+                lhs   = lhs - avg;
+            }
+        }
+
+    protected:
+        PCG<LowOpRet, low_type, low_type> inner_m;
+        int refinements_m = 0;
+    };
+
+}  // namespace ippl
+
+#endif
@@ -0,0 +1,255 @@
+//
+// Class Multigrid
+//   Geometric multigrid for the Poisson equation -laplace(x) = b on cell-centered fields.
+//
+//   Every coarse level halves the number of cells along each dimension. Each rank keeps
+//   the coarsened version of its local domain, so the transfer operators only require
+//   halo exchanges. If a local domain cannot be halved, e.g. after load balancing, the
+//   coarse level is partitioned anew and the residue and the correction are redistributed
+//   between the fine layout and the refinement of the coarse one. Coarsening stops once
+//   the global domain can no longer be halved or the maximum number of levels is reached;
+//   the coarsest level is then solved with CG.
+//
+//   The residue is restricted by averaging over the 2^Dim fine cells in each coarse cell,
+//   and corrections are prolongated with (bi/tri)linear interpolation. Coarse levels use
+//   the periodic faces of the finest level and homogeneous Dirichlet conditions otherwise.
+//
+#ifndef IPPL_MULTIGRID_H
+#define IPPL_MULTIGRID_H
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "Field/Redistribution.h"
+
+#include "PCG.h"
+#include "PolynomialPreconditioner.h"
+#include "Preconditioner.h"
+#include "SolverAlgorithm.h"
+
+namespace ippl {
+
+    template <typename Field>
+    class Multigrid : public SolverAlgorithm<Field, Field> {
+        using Base                    = SolverAlgorithm<Field, Field>;
+        using T                       = typename Field::value_type;
+        constexpr static unsigned Dim = Field::dim;
+
+    public:
+        using typename Base::lhs_type, typename Base::rhs_type;
+        using field_type = Field;
+        using Mesh_t     = typename Field::Mesh_t;
+        using Layout_t   = typename Field::Layout_t;
+        using BConds_t   = typename Field::BConds_t;
+
+        enum Smoother {
+            JACOBI    = 0,
+            CHEBYSHEV = 1
+        };
+
+        Multigrid();
+
+        /*!
+         * Multigrid parameters:
+         *  levels            maximum number of levels, including the finest
+         *  cycles            number of V-cycles per preconditioner application
+         *                    or per level of full multigrid
+         *  pre_smoothing     number of smoothing steps before the coarse grid correction
+         *  post_smoothing    number of smoothing steps after the coarse grid correction
+         *  smoother          JACOBI or CHEBYSHEV
+         *  jacobi_weight     damping factor of the Jacobi smoother
+         *  chebyshev_degree  polynomial degree of one Chebyshev smoothing step
+         *  chebyshev_ratio   lower end of the smoothed part of the spectrum
+         *                    relative to the largest eigenvalue
+         *  coarse_iterations maximum number of CG iterations on the coarsest level
+         *  coarse_tolerance  relative tolerance of the coarsest level solve
+         * @return The default multigrid parameters
+         */
+        static ParameterList getDefaultParameters();
+
+        /*!
+         * Builds the grid hierarchy for a field on the finest level. The hierarchy
+         * is rebuilt only if the mesh, layout, local domains, boundary conditions
+         * or the maximum number of levels changed since the last call.
+         * @param x a field with the mesh, layout and boundary conditions of the problem
+         * @param params the multigrid parameters
+         */
+        void setup(Field& x, const ParameterList& params);
+
+        /*!
+         * Performs a V-cycle on the finest level
+         * @param x the approximate solution, updated in place
+         * @param b the right hand side
+         */
+        void vcycle(Field& x, Field& b) { vcycle(0, x, b); }
+
+        /*!
+         * Computes an initial solution with full multigrid: the problem is solved
+         * on the coarsest level and the solution is interpolated to each finer level,
+         * where it is improved with V-cycles. The coarse problems have homogeneous
+         * boundary conditions, which are corrected by the V-cycles on the finest level.
+         * @param x the solution
+         * @param b the right hand side
+         */
+        void fmg(Field& x, Field& b);
+
+        /*!
+         * Solves the problem with V-cycles, starting from a full multigrid
+         * solution if requested. In addition to the multigrid parameters,
+         * the parameter list must contain
+         *  max_iterations    maximum number of V-cycles
+         *  tolerance         tolerance for the residue norm relative to the RHS norm
+         *  fmg               whether to compute the initial guess with full multigrid
+         * @param lhs the solution, which also serves as initial guess
+         * @param rhs the right hand side
+         * @param params the solver parameters
+         */
+        void operator()(lhs_type& lhs, rhs_type& rhs, const ParameterList& params) override;
+
+        /*!
+         * Query how many V-cycles were required to obtain the solution
+         * the last time this solver was used
+         * @return Iteration count of last solve
+         */
+        int getIterationCount() const { return iterations_m; }
+
+        /*!
+         * Query the residue
+         * @return Residue norm from last solve
+         */
+        T getResidue() const { return residueNorm_m; }
+
+        /*!
+         * @return The number of levels in the hierarchy
+         */
+        unsigned getLevelCount() const { return levels_m.size(); }
+
+        /*!
+         * @return Whether all faces of the problem are periodic
+         */
+        bool isAllPeriodic() const;
+
+    protected:
+        struct Level {
+            // approximate solution and right hand side (unused on the finest level)
+            Field x, b;
+            // residue and work field for the smoothers
+            Field r, d;
+            // inverse of the diagonal of the discrete operator
+            T invDiag;
+            // If the local domains of this level cannot be halved, the transfers to
+            // and from the next level go through a field on the refinement of the
+            // layout of the next level
+            bool redistribute = false;
+            Field aligned;
+            detail::CommPlan<Dim> alignPlan;
+        };
+
+        void vcycle(unsigned level, Field& x, Field& b);
+
+        /*!
+         * Applies a number of smoothing steps on a level
+         * @param level the level
+         * @param x the approximate solution
+         * @param b the right hand side
+         * @param steps the number of smoothing steps
+         */
+        void smooth(Level& level, Field& x, Field& b, int steps);
+
+        /*!
+         * Restricts a fine residue to the coarse right hand side
+         * @param fine the fine residue
+         * @param coarse the coarse field
+         */
+        static void restrictResidue(const Field& fine, Field& coarse);
+
+        /*!
+         * Adds the interpolated coarse correction to a fine field
+         * @param coarse the coarse correction
+         * @param fine the fine field
+         */
+        static void prolongateCorrection(Field& coarse, Field& fine);
+
+        /*!
+         * Restricts a fine residue on a level to the right hand side of the next level,
+         * redistributing it first if necessary
+         * @param level the fine level
+         * @param fine the fine residue
+         * @param coarse the right hand side of the next level
+         */
+        void restrictTo(unsigned level, const Field& fine, Field& coarse);
+
+        /*!
+         * Adds the interpolated correction of the next level to a field on a level,
+         * redistributing it if necessary
+         * @param level the fine level
+         * @param coarse the correction on the next level
+         * @param fine the fine field
+         */
+        void prolongateTo(unsigned level, Field& coarse, Field& fine);
+
+        /*!
+         * Copies a field to a field on another layout
+         * @param plan the blocks to exchange
+         * @param src the field to copy from
+         * @param dst the field to copy to
+         */
+        void redistribute(const detail::CommPlan<Dim>& plan, const Field& src, Field& dst);
+
+        std::vector<Level> levels_m;
+        std::vector<std::unique_ptr<Mesh_t>> meshes_m;
+        std::vector<std::unique_ptr<Layout_t>> layouts_m;
+
+        // the finest level from which the hierarchy was built
+        const Mesh_t* mesh_mp     = nullptr;
+        const Layout_t* layout_mp = nullptr;
+        std::vector<NDIndex<Dim>> domains_m;
+        typename Mesh_t::vector_type spacing_m;
+        typename Mesh_t::vector_type origin_m;
+        std::array<bool, 2 * Dim> periodic_m{};
+        int maxLevels_m = 0;
+
+        ParameterList params_m;
+        ParameterList coarseParams_m;
+
+        PCG<UnaryMinus<detail::meta_laplace<Field>>, Field, Field> coarseSolver_m;
+
+        // buffer for the redistribution of levels
+        detail::FieldBufferData<T> fd_m;
+
+        T residueNorm_m  = 0;
+        int iterations_m = 0;
+    };
+
+    /*!
+     * Preconditioner that applies multigrid V-cycles to a zero initial guess
+     */
+    template <typename Field>
+    class MultigridPreconditioner : public Preconditioner<Field> {
+    public:
+        MultigridPreconditioner()
+            : params_m(Multigrid<Field>::getDefaultParameters()) {}
+
+        /*!
+         * Merges parameters into the multigrid parameters
+         * @param params Parameter list with the desired values
+         */
+        void mergeParameters(const ParameterList& params) override { params_m.merge(params); }
+
+        void operator()(Field& z, Field& r) override;
+
+        /*!
+         * @return The multigrid hierarchy
+         */
+        const Multigrid<Field>& getMultigrid() const { return mg_m; }
+
+    private:
+        Multigrid<Field> mg_m;
+        ParameterList params_m;
+    };
+}  // namespace ippl
+
+#include "Solver/Multigrid.hpp"
+
+#endif
@@ -0,0 +1,491 @@
+//
+// Class Multigrid
+//   Geometric multigrid for the Poisson equation -laplace(x) = b on cell-centered fields.
+//
+#include <utility>
+
+#include "Utility/IpplException.h"
+#include "Utility/IpplTimings.h"
+
+namespace ippl {
+
+    template <typename Field>
+    Multigrid<Field>::Multigrid() {
+        coarseSolver_m.setOperator([](Field arg) { return -laplace(arg); });
+    }
+
+    template <typename Field>
+    ParameterList Multigrid<Field>::getDefaultParameters() {
+        ParameterList params;
+        params.add("levels", 16);
+        params.add("cycles", 1);
+        params.add("pre_smoothing", 2);
+        params.add("post_smoothing", 2);
+        params.add("smoother", JACOBI);
+        // optimal damping for the high frequencies of the Laplacian
+        params.add("jacobi_weight", (T)(2.0 * Dim / (2.0 * Dim + 1)));
+        params.add("chebyshev_degree", 2);
+        params.add("chebyshev_ratio", (T)(1.0 / (2 * Dim)));
+        params.add("coarse_iterations", 1000);
+        params.add("coarse_tolerance", (T)1e-10);
+        return params;
+    }
+
+    template <typename Field>
+    bool Multigrid<Field>::isAllPeriodic() const {
+        for (bool periodic : periodic_m) {
+            if (!periodic) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename Field>
+    void Multigrid<Field>::setup(Field& x, const ParameterList& params) {
+        params_m = params;
+
+        coarseParams_m = ParameterList();
+        coarseParams_m.add("max_iterations", params.get<int>("coarse_iterations"));
+        coarseParams_m.add("tolerance", params.get<T>("coarse_tolerance"));
+
+        Mesh_t& mesh        = x.get_mesh();
+        Layout_t& layout    = x.getLayout();
+        const int maxLevels = params.get<int>("levels");
+
+        std::array<bool, 2 * Dim> periodic;
+        for (unsigned face = 0; face < 2 * Dim; ++face) {
+            FieldBC bcType = x.getFieldBC()[face]->getBCType();
+            if (!(bcType == PERIODIC_FACE || (bcType & CONSTANT_FACE))) {
+                throw IpplException("Multigrid::setup",
+                                    "Only periodic or constant BCs for LHS supported.");
+            }
+            periodic[face] = bcType == PERIODIC_FACE;
+        }
+
+        auto hDomains = layout.getHostLocalDomains();
+        std::vector<NDIndex<Dim>> domains(hDomains.extent(0));
+        for (unsigned rank = 0; rank < domains.size(); ++rank) {
+            domains[rank] = hDomains(rank);
+        }
+
+        auto sameDomains = [&]() {
+            if (domains.size() != domains_m.size()) {
+                return false;
+            }
+            for (unsigned rank = 0; rank < domains.size(); ++rank) {
+                for (unsigned d = 0; d < Dim; ++d) {
+                    if (domains[rank][d] != domains_m[rank][d]) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        };
+
+        // the coarse meshes and the inverse diagonals depend on the mesh spacing
+        const auto& spacing = mesh.getMeshSpacing();
+        const auto& origin  = mesh.getOrigin();
+        auto sameMesh       = [&]() {
+            for (unsigned d = 0; d < Dim; ++d) {
+                if (spacing[d] != spacing_m[d] || origin[d] != origin_m[d]) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        if (&mesh == mesh_mp && &layout == layout_mp && maxLevels == maxLevels_m
+            && periodic == periodic_m && sameDomains() && sameMesh()) {
+            return;
+        }
+
+        static IpplTimings::TimerRef setupTimer = IpplTimings::getTimer("Multigrid setup");
+        IpplTimings::startTimer(setupTimer);
+
+        mesh_mp     = &mesh;
+        layout_mp   = &layout;
+        maxLevels_m = maxLevels;
+        periodic_m  = periodic;
+        domains_m   = domains;
+        spacing_m   = spacing;
+        origin_m    = origin;
+
+        levels_m.clear();
+        meshes_m.clear();
+        layouts_m.clear();
+
+        bool allPeriodic = isAllPeriodic();
+
+        Level finest;
+        finest.r.initialize(mesh, layout);
+        finest.d.initialize(mesh, layout);
+        finest.invDiag = detail::inverseLaplaceDiagonal<T>(mesh);
+        levels_m.push_back(finest);
+
+        e_dim_tag decomp[Dim];
+        for (unsigned d = 0; d < Dim; ++d) {
+            decomp[d] = layout.getRequestedDistribution(d);
+        }
+
+        // A domain can be coarsened if it consists of pairs of cells
+        auto canHalve = [](const NDIndex<Dim>& domain, int minLength) {
+            for (unsigned d = 0; d < Dim; ++d) {
+                if (domain[d].first() % 2 != 0 || domain[d].length() % 2 != 0
+                    || (int)domain[d].length() < minLength) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        auto halve = [](const NDIndex<Dim>& domain) {
+            NDIndex<Dim> coarse;
+            for (unsigned d = 0; d < Dim; ++d) {
+                int first = domain[d].first() / 2;
+                coarse[d] = Index(first, first + domain[d].length() / 2 - 1);
+            }
+            return coarse;
+        };
+
+        NDIndex<Dim> gDomain = layout.getDomain();
+        Mesh_t* fineMesh     = &mesh;
+        Layout_t* fineLayout = &layout;
+        while ((int)levels_m.size() < maxLevels && canHalve(gDomain, 4)) {
+            bool halvable = true;
+            for (const auto& domain : domains) {
+                halvable = halvable && canHalve(domain, 2);
+            }
+
+            const NDIndex<Dim> fineDomain = gDomain;
+            gDomain                       = halve(gDomain);
+
+            auto coarseLayout = std::make_unique<Layout_t>(gDomain, decomp, allPeriodic);
+            if (halvable) {
+                // keep the coarsened local domains of the finer level on each rank
+                for (auto& domain : domains) {
+                    domain = halve(domain);
+                }
+                if (Comm->size() > 1) {
+                    coarseLayout->updateLayout(domains);
+                }
+            } else {
+                // partition the coarse grid anew; the finer level is redistributed to
+                // the refined local domains of the coarse layout for the transfers
+                auto hCoarse = coarseLayout->getHostLocalDomains();
+                if (hCoarse.extent(0) != domains.size()) {
+                    // fewer coarse cells than ranks
+                    break;
+                }
+
+                std::vector<NDIndex<Dim>> aligned(domains.size());
+                for (unsigned rank = 0; rank < domains.size(); ++rank) {
+                    domains[rank] = hCoarse(rank);
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        aligned[rank][d] =
+                            Index(2 * domains[rank][d].first(), 2 * domains[rank][d].last() + 1);
+                    }
+                }
+                auto alignedLayout = std::make_unique<Layout_t>(fineDomain, decomp, allPeriodic);
+                alignedLayout->updateLayout(aligned);
+
+                Level& fine = levels_m.back();
+                fine.aligned.initialize(*fineMesh, *alignedLayout);
+                fine.alignPlan    = detail::makeCommPlan(*fineLayout, *alignedLayout);
+                fine.redistribute = true;
+                layouts_m.push_back(std::move(alignedLayout));
+            }
+
+            typename Mesh_t::vector_type hx = fineMesh->getMeshSpacing();
+            for (unsigned d = 0; d < Dim; ++d) {
+                hx[d] *= 2;
+            }
+            auto coarseMesh = std::make_unique<Mesh_t>(gDomain, hx, fineMesh->getOrigin());
+
+            Level level;
+            level.x.initialize(*coarseMesh, *coarseLayout);
+            level.b.initialize(*coarseMesh, *coarseLayout);
+            level.r.initialize(*coarseMesh, *coarseLayout);
+            level.d.initialize(*coarseMesh, *coarseLayout);
+            level.invDiag = detail::inverseLaplaceDiagonal<T>(*coarseMesh);
+
+            // the coarse levels solve for corrections, so constant faces become zero faces
+            BConds_t bc;
+            for (unsigned face = 0; face < 2 * Dim; ++face) {
+                if (periodic[face]) {
+                    bc[face] = std::make_shared<PeriodicFace<Field>>(face);
+                } else {
+                    bc[face] = std::make_shared<ZeroFace<Field>>(face);
+                }
+            }
+            level.x.setFieldBC(bc);
+
+            fineMesh   = coarseMesh.get();
+            fineLayout = coarseLayout.get();
+            meshes_m.push_back(std::move(coarseMesh));
+            layouts_m.push_back(std::move(coarseLayout));
+            levels_m.push_back(level);
+        }
+
+        if (levels_m.size() == 1) {
+            *Warn << "Multigrid: the grid cannot be coarsened, so the problem is solved with CG"
+                  << endl;
+        }
+
+        IpplTimings::stopTimer(setupTimer);
+    }
+
+    template <typename Field>
+    void Multigrid<Field>::vcycle(unsigned l, Field& x, Field& b) {
+        if (l + 1 == levels_m.size()) {
+            coarseSolver_m(x, b, coarseParams_m);
+            return;
+        }
+
+        Level& level = levels_m[l];
+        smooth(level, x, b, params_m.get<int>("pre_smoothing"));
+
+        // the residue is given by b - (-laplace(x))
+        level.r = b + laplace(x);
+
+        Level& coarse = levels_m[l + 1];
+        restrictTo(l, level.r, coarse.b);
+        coarse.x = 0;
+        vcycle(l + 1, coarse.x, coarse.b);
+        prolongateTo(l, coarse.x, x);
+
+        smooth(level, x, b, params_m.get<int>("post_smoothing"));
+    }
+
+    template <typename Field>
+    void Multigrid<Field>::fmg(Field& x, Field& b) {
+        static IpplTimings::TimerRef fmgTimer = IpplTimings::getTimer("Multigrid FMG");
+        IpplTimings::startTimer(fmgTimer);
+
+        const unsigned coarsest = levels_m.size() - 1;
+        const int cycles        = params_m.get<int>("cycles");
+
+        // right hand sides on all levels
+        for (unsigned l = 1; l <= coarsest; ++l) {
+            restrictTo(l - 1, l == 1 ? b : levels_m[l - 1].b, levels_m[l].b);
+        }
+
+        for (unsigned l = coarsest + 1; l-- > 0;) {
+            Field& xl = l == 0 ? x : levels_m[l].x;
+            Field& bl = l == 0 ? b : levels_m[l].b;
+
+            if (l == coarsest) {
+                xl = 0;
+                coarseSolver_m(xl, bl, coarseParams_m);
+                continue;
+            }
+
+            xl = 0;
+            prolongateTo(l, levels_m[l + 1].x, xl);
+            for (int cycle = 0; cycle < cycles; ++cycle) {
+                vcycle(l, xl, bl);
+            }
+        }
+
+        IpplTimings::stopTimer(fmgTimer);
+    }
+
+    template <typename Field>
+    void Multigrid<Field>::operator()(lhs_type& lhs, rhs_type& rhs, const ParameterList& params) {
+        setup(lhs, params);
+
+        iterations_m            = 0;
+        const int maxIterations = params.get<int>("max_iterations");
+        const T tolerance       = params.get<T>("tolerance") * norm(rhs);
+
+        if (params.get<bool>("fmg")) {
+            fmg(lhs, rhs);
+        }
+
+        // the residue is given by rhs - (-laplace(lhs))
+        Field& r      = levels_m[0].r;
+        residueNorm_m = std::sqrt(fused(assign(r, rhs + laplace(lhs)), reduce(r * r))[0]);
+
+        while (iterations_m < maxIterations && residueNorm_m > tolerance) {
+            vcycle(0, lhs, rhs);
+
+            residueNorm_m = std::sqrt(fused(assign(r, rhs + laplace(lhs)), reduce(r * r))[0]);
+            ++iterations_m;
+        }
+
+        if (isAllPeriodic()) {
+            T avg = lhs.getVolumeAverage();
+            lhs   = lhs - avg;
+        }
+    }
+
+    template <typename Field>
+    void Multigrid<Field>::smooth(Level& level, Field& x, Field& b, int steps) {
+        if (steps <= 0) {
+            return;
+        }
+
+        const T invDiag = level.invDiag;
+        Field& r        = level.r;
+        Field& d        = level.d;
+
+        if (params_m.get<int>("smoother") == JACOBI) {
+            const T omega = params_m.get<T>("jacobi_weight") * invDiag;
+            for (int step = 0; step < steps; ++step) {
+                r = b + laplace(x);
+                x = x + omega * r;
+            }
+            return;
+        }
+
+        // Chebyshev iteration on the Jacobi-preconditioned operator, whose
+        // spectrum lies in (0, 2] for the Laplacian
+        const int degree = params_m.get<int>("chebyshev_degree");
+        const T upper    = 2;
+        const T lower    = upper * params_m.get<T>("chebyshev_ratio");
+        for (int step = 0; step < steps; ++step) {
+            detail::chebyshevIteration(x, b, r, d, invDiag, lower, upper, degree);
+        }
+    }
+
+    template <typename Field>
+    void Multigrid<Field>::restrictResidue(const Field& fine, Field& coarse) {
+        using view_type        = typename Field::view_type;
+        using exec_space       = typename view_type::execution_space;
+        using index_array_type = typename RangePolicy<Dim, exec_space>::index_array_type;
+
+        constexpr unsigned nChildren = 1 << Dim;
+        const T scale                = T(1) / nChildren;
+
+        const int ngf   = fine.getNghost();
+        const int ngc   = coarse.getNghost();
+        view_type fview = fine.getView();
+        view_type cview = coarse.getView();
+
+        ippl::parallel_for(
+            "Multigrid::restrictResidue", coarse.getFieldRangePolicy(),
+            KOKKOS_LAMBDA(const index_array_type& args) {
+                T sum = 0;
+                for (unsigned c = 0; c < nChildren; ++c) {
+                    index_array_type child;
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        child[d] = 2 * (args[d] - ngc) + ngf + ((c >> d) & 1);
+                    }
+                    sum += apply(fview, child);
+                }
+                apply(cview, args) = scale * sum;
+            });
+    }
+
+    template <typename Field>
+    void Multigrid<Field>::prolongateCorrection(Field& coarse, Field& fine) {
+        using view_type        = typename Field::view_type;
+        using exec_space       = typename view_type::execution_space;
+        using index_array_type = typename RangePolicy<Dim, exec_space>::index_array_type;
+
+        detail::prepareHalo(coarse);
+
+        constexpr unsigned nCorners = 1 << Dim;
+
+        const int ngf   = fine.getNghost();
+        const int ngc   = coarse.getNghost();
+        view_type cview = std::as_const(coarse).getView();
+        view_type fview = fine.getView();
+
+        ippl::parallel_for(
+            "Multigrid::prolongateCorrection", fine.getFieldRangePolicy(),
+            KOKKOS_LAMBDA(const index_array_type& args) {
+                // the coarse cell containing the fine cell and its nearest neighbor
+                index_array_type parent, neighbor;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    const int offset = args[d] - ngf;
+                    parent[d]        = offset / 2 + ngc;
+                    neighbor[d]      = (offset % 2 == 0) ? parent[d] - 1 : parent[d] + 1;
+                }
+
+                T sum = 0;
+                for (unsigned c = 0; c < nCorners; ++c) {
+                    index_array_type corner;
+                    T weight = 1;
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        if ((c >> d) & 1) {
+                            corner[d] = neighbor[d];
+                            weight *= 0.25;
+                        } else {
+                            corner[d] = parent[d];
+                            weight *= 0.75;
+                        }
+                    }
+                    sum += weight * apply(cview, corner);
+                }
+                apply(fview, args) += sum;
+            });
+    }
+
+    template <typename Field>
+    void Multigrid<Field>::restrictTo(unsigned l, const Field& fine, Field& coarse) {
+        Level& level = levels_m[l];
+        if (!level.redistribute) {
+            restrictResidue(fine, coarse);
+            return;
+        }
+
+        redistribute(level.alignPlan, fine, level.aligned);
+        restrictResidue(level.aligned, coarse);
+    }
+
+    template <typename Field>
+    void Multigrid<Field>::prolongateTo(unsigned l, Field& coarse, Field& fine) {
+        Level& level = levels_m[l];
+        if (!level.redistribute) {
+            prolongateCorrection(coarse, fine);
+            return;
+        }
+
+        // the search direction is not in use between the smoothing steps
+        level.aligned = 0;
+        prolongateCorrection(coarse, level.aligned);
+        redistribute(level.alignPlan.reversed(), level.aligned, level.d);
+        fine = fine + level.d;
+    }
+
+    template <typename Field>
+    void Multigrid<Field>::redistribute(const detail::CommPlan<Dim>& plan, const Field& src,
+                                        Field& dst) {
+        const int nghostSrc = src.getNghost();
+        const int nghostDst = dst.getNghost();
+
+        const auto& ldomSrc = src.getLayout().getLocalNDIndex();
+        const auto& ldomDst = dst.getLayout().getLocalNDIndex();
+
+        auto viewSrc = src.getView();
+        auto viewDst = dst.getView();
+
+        detail::exchange(plan.sends, plan.recvs, viewSrc, nghostSrc, ldomSrc, fd_m,
+                         MG_REDISTRIBUTION_TAG, IPPL_MG_SEND, IPPL_MG_RECV,
+                         [&](const auto& block) {
+                             detail::unpack(block.domain, viewDst, fd_m, nghostDst, ldomDst);
+                         });
+    }
+
+    template <typename Field>
+    void MultigridPreconditioner<Field>::operator()(Field& z, Field& r) {
+        static IpplTimings::TimerRef mgTimer = IpplTimings::getTimer("Multigrid preconditioner");
+        IpplTimings::startTimer(mgTimer);
+
+        mg_m.setup(z, params_m);
+
+        z                = 0;
+        const int cycles = params_m.get<int>("cycles");
+        for (int cycle = 0; cycle < cycles; ++cycle) {
+            mg_m.vcycle(z, r);
+        }
+
+        // the correction of a periodic problem is only defined up to a constant
+        if (mg_m.isAllPeriodic()) {
+            typename Field::value_type avg = z.getVolumeAverage();
+            z                              = z - avg;
+        }
+
+        IpplTimings::stopTimer(mgTimer);
+    }
+}  // namespace ippl
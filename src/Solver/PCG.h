@@ -6,6 +6,10 @@
 #ifndef IPPL_PCG_H
 #define IPPL_PCG_H
 
+#include <memory>
+
+#include "Field/FieldPool.h"
+#include "Preconditioner.h"
 #include "SolverAlgorithm.h"
 
 namespace ippl {
@@ -17,7 +21,8 @@ namespace ippl {
 
     public:
         using typename Base::lhs_type, typename Base::rhs_type;
-        using operator_type = std::function<OpRet(lhs_type)>;
+        using operator_type       = std::function<OpRet(lhs_type)>;
+        using preconditioner_type = Preconditioner<lhs_type>;
 
         /*!
          * Sets the differential operator for the conjugate gradient algorithm
@@ -25,6 +30,14 @@ namespace ippl {
          */
         void setOperator(operator_type op) { op_m = std::move(op); }
 
+        /*!
+         * Sets the preconditioner for the conjugate gradient algorithm
+         * @param precond The preconditioner, or nullptr for unpreconditioned CG
+         */
+        void setPreconditioner(std::shared_ptr<preconditioner_type> precond) {
+            preconditioner_m = std::move(precond);
+        }
+
         /*!
          * Query how many iterations were required to obtain the solution
          * the last time this solver was used
@@ -33,55 +46,50 @@ namespace ippl {
         int getIterationCount() { return iterations_m; }
 
         void operator()(lhs_type& lhs, rhs_type& rhs, const ParameterList& params) override {
-            constexpr unsigned Dim = lhs_type::dim;
-
-            typename lhs_type::Mesh_t mesh     = lhs.get_mesh();
-            typename lhs_type::Layout_t layout = lhs.getLayout();
+            typename lhs_type::Mesh_t& mesh     = lhs.get_mesh();
+            typename lhs_type::Layout_t& layout = lhs.getLayout();
 
             iterations_m            = 0;
             const int maxIterations = params.get<int>("max_iterations");
 
             // Variable names mostly based on description in
             // https://www.cs.cmu.edu/~quake-papers/painless-conjugate-gradient.pdf
-            lhs_type r(mesh, layout);
+            // The work fields are taken from a pool so that repeated solves on the
+            // same layout do not allocate
+            using pool_type = FieldPool<lhs_type>;
+            auto rHandle    = pool_type::acquire(mesh, layout);
+            auto dHandle    = pool_type::acquire(mesh, layout);
+            auto qHandle    = pool_type::acquire(mesh, layout);
+
+            lhs_type& r = *rHandle;
+            lhs_type& d = *dHandle;
+            lhs_type& q = *qHandle;
 
-            using bc_type  = BConds<lhs_type, Dim>;
-            bc_type lhsBCs = lhs.getFieldBC();
             bc_type bc;
+            bool allFacesPeriodic = makeResidueBCs(lhs, bc);
 
-            bool allFacesPeriodic = true;
-            for (unsigned int i = 0; i < 2 * Dim; ++i) {
-                FieldBC bcType = lhsBCs[i]->getBCType();
-                if (bcType == PERIODIC_FACE) {
-                    // If the LHS has periodic BCs, so does the residue
-                    bc[i] = std::make_shared<PeriodicFace<lhs_type>>(i);
-                } else if (bcType & CONSTANT_FACE) {
-                    // If the LHS has constant BCs, the residue is zero on the BCs
-                    // Bitwise AND with CONSTANT_FACE will succeed for ZeroFace or ConstantFace
-                    bc[i]            = std::make_shared<ZeroFace<lhs_type>>(i);
-                    allFacesPeriodic = false;
-                } else {
-                    throw IpplException("PCG::operator()",
-                                        "Only periodic or constant BCs for LHS supported.");
-                    return;
-                }
+            // Without a preconditioner, the preconditioned residue z is the residue itself
+            typename pool_type::Handle zHandle;
+            if (preconditioner_m) {
+                zHandle = pool_type::acquire(mesh, layout);
+                zHandle->setFieldBC(bc);
             }
+            lhs_type& z = preconditioner_m ? *zHandle : r;
 
-            r = rhs - op_m(lhs);
+            T rr     = fused(assign(r, rhs - op_m(lhs)), reduce(r * r))[0];
+            T delta1 = applyPreconditioner(z, r, rr);
 
-            lhs_type d = r.deepCopy();
+            Kokkos::deep_copy(d.getView(), z.getView());
             d.setFieldBC(bc);
 
-            T delta1          = innerProduct(r, r);
-            residueNorm       = std::sqrt(delta1);
+            residueNorm       = std::sqrt(rr);
             const T tolerance = params.get<T>("tolerance") * norm(rhs);
 
-            lhs_type q(mesh, layout);
-
             while (iterations_m < maxIterations && residueNorm > tolerance) {
-                q       = op_m(d);
-                T alpha = delta1 / innerProduct(d, q);
-                lhs     = lhs + alpha * d;
+                // The operator application and the vector updates are each fused
+                // with the following inner product into a single sweep
+                auto [dq] = fused(assign(q, op_m(d)), reduce(d * q));
+                T alpha   = delta1 / dq;
 
                 // The exact residue is given by
                 // r = rhs - op_m(lhs);
@@ -90,15 +98,16 @@ namespace ippl {
                 // the correction does not have a significant effect on accuracy;
                 // in some implementations, the correction may be applied every few
                 // iterations to offset accumulated floating point errors
-                r = r - alpha * q;
+                rr = fused(assign(lhs, lhs + alpha * d), assign(r, r - alpha * q),
+                           reduce(r * r))[0];
 
                 T delta0 = delta1;
-                delta1   = innerProduct(r, r);
+                delta1   = applyPreconditioner(z, r, rr);
                 T beta   = delta1 / delta0;
 
-                residueNorm = std::sqrt(delta1);
+                residueNorm = std::sqrt(rr);
 
-                d = r + beta * d;
+                d = z + beta * d;
 
                 ++iterations_m;
             }
@@ -112,7 +121,60 @@ namespace ippl {
         T getResidue() const { return residueNorm; }
 
     protected:
+        using bc_type = BConds<lhs_type, lhs_type::dim>;
+
+        /*!
+         * Creates the boundary conditions for the residue and search directions
+         * @tparam Field the type of the residue, which may differ from the LHS
+         * type in its precision
+         * @param lhs the problem LHS
+         * @param bc the boundary conditions to fill
+         * @return Whether all faces are periodic
+         * @throw IpplException if the LHS has boundary conditions other
+         * than periodic or constant
+         */
+        template <typename Field = lhs_type>
+        static bool makeResidueBCs(lhs_type& lhs, BConds<Field, lhs_type::dim>& bc) {
+            constexpr unsigned Dim = lhs_type::dim;
+
+            bc_type lhsBCs = lhs.getFieldBC();
+
+            bool allFacesPeriodic = true;
+            for (unsigned int i = 0; i < 2 * Dim; ++i) {
+                FieldBC bcType = lhsBCs[i]->getBCType();
+                if (bcType == PERIODIC_FACE) {
+                    // If the LHS has periodic BCs, so does the residue
+                    bc[i] = std::make_shared<PeriodicFace<Field>>(i);
+                } else if (bcType & CONSTANT_FACE) {
+                    // If the LHS has constant BCs, the residue is zero on the BCs
+                    // Bitwise AND with CONSTANT_FACE will succeed for ZeroFace or ConstantFace
+                    bc[i]            = std::make_shared<ZeroFace<Field>>(i);
+                    allFacesPeriodic = false;
+                } else {
+                    throw IpplException("PCG::operator()",
+                                        "Only periodic or constant BCs for LHS supported.");
+                }
+            }
+            return allFacesPeriodic;
+        }
+
+        /*!
+         * Computes the preconditioned residue z = M^{-1} r
+         * @param z the preconditioned residue
+         * @param r the residue
+         * @param rr the squared norm of the residue
+         * @return The inner product of r and z
+         */
+        T applyPreconditioner(lhs_type& z, lhs_type& r, T rr) {
+            if (!preconditioner_m) {
+                return rr;
+            }
+            (*preconditioner_m)(z, r);
+            return innerProduct(r, z);
+        }
+
         operator_type op_m;
+        std::shared_ptr<preconditioner_type> preconditioner_m;
         T residueNorm    = 0;
         int iterations_m = 0;
     };
@@ -0,0 +1,169 @@
+//
+// Class PipelinedCG
+//   Pipelined (preconditioned) conjugate gradient algorithm, based on
+//   P. Ghysels and W. Vanroose, "Hiding global synchronization latency in the
+//   preconditioned Conjugate Gradient algorithm", Parallel Computing 40 (2014).
+//   All inner products of an iteration are combined into a single non-blocking
+//   reduction, which is overlapped with the preconditioner and operator application.
+//   The algorithm needs more vector updates than standard CG, which are fused into
+//   a single kernel, and is slightly less stable in finite precision.
+//
+
+#ifndef IPPL_PIPELINED_CG_H
+#define IPPL_PIPELINED_CG_H
+
+#include <array>
+
+#include "PCG.h"
+
+namespace ippl {
+
+    template <typename OpRet, typename FieldLHS, typename FieldRHS = FieldLHS>
+    class PipelinedCG : public PCG<OpRet, FieldLHS, FieldRHS> {
+        using Base = PCG<OpRet, FieldLHS, FieldRHS>;
+        typedef typename Base::lhs_type::value_type T;
+
+    public:
+        using typename Base::lhs_type, typename Base::rhs_type;
+
+        void operator()(lhs_type& lhs, rhs_type& rhs, const ParameterList& params) override {
+            typename lhs_type::Mesh_t& mesh     = lhs.get_mesh();
+            typename lhs_type::Layout_t& layout = lhs.getLayout();
+
+            auto& op             = this->op_m;
+            auto& preconditioner = this->preconditioner_m;
+
+            this->iterations_m      = 0;
+            const int maxIterations = params.get<int>("max_iterations");
+
+            typename Base::bc_type bc;
+            bool allFacesPeriodic = Base::makeResidueBCs(lhs, bc);
+
+            // Variable names based on algorithm 3 in the paper; without a preconditioner,
+            // u is the residue r, m is w and q is s
+            using pool_type = FieldPool<lhs_type>;
+            auto rHandle    = pool_type::acquire(mesh, layout);
+            auto wHandle    = pool_type::acquire(mesh, layout);
+            auto nHandle    = pool_type::acquire(mesh, layout);
+            auto zHandle    = pool_type::acquire(mesh, layout);
+            auto sHandle    = pool_type::acquire(mesh, layout);
+            auto pHandle    = pool_type::acquire(mesh, layout);
+
+            lhs_type& r = *rHandle;
+            lhs_type& w = *wHandle;
+            lhs_type& n = *nHandle;
+            lhs_type& z = *zHandle;
+            lhs_type& s = *sHandle;
+            lhs_type& p = *pHandle;
+
+            typename pool_type::Handle uHandle, mHandle, qHandle;
+            if (preconditioner) {
+                uHandle  = pool_type::acquire(mesh, layout);
+                mHandle  = pool_type::acquire(mesh, layout);
+                qHandle  = pool_type::acquire(mesh, layout);
+                *qHandle = 0;
+            }
+            lhs_type& u = preconditioner ? *uHandle : r;
+            lhs_type& m = preconditioner ? *mHandle : w;
+            lhs_type& q = preconditioner ? *qHandle : s;
+
+            // the operator is applied to u and m
+            u.setFieldBC(bc);
+            m.setFieldBC(bc);
+
+            z = 0;
+            s = 0;
+            p = 0;
+
+            r = rhs - op(lhs);
+            if (preconditioner) {
+                (*preconditioner)(u, r);
+            }
+
+            // local parts of (r, u), (w, u) and (r, r); without a preconditioner
+            // (r, u) is (r, r), which is only reduced once
+            std::array<T, 3> local;
+            if (preconditioner) {
+                local = fusedLocal(assign(w, op(u)), reduce(r * u), reduce(w * u), reduce(r * r));
+            } else {
+                auto [rrLocal, wrLocal] =
+                    fusedLocal(assign(w, op(u)), reduce(r * r), reduce(w * r));
+                local = {rrLocal, wrLocal, rrLocal};
+            }
+
+            const T tolerance = params.get<T>("tolerance") * norm(rhs);
+
+            MPI_Datatype type = get_mpi_datatype(local[0]);
+
+            T alphaOld = 0, gammaOld = 0;
+            while (true) {
+                std::array<T, 3> global;
+                MPI_Request request;
+                MPI_Iallreduce(local.data(), global.data(), 3, type, MPI_SUM,
+                               Comm->getCommunicator(), &request);
+
+                // overlapped with the reduction
+                if (preconditioner) {
+                    (*preconditioner)(m, w);
+                }
+
+                // the operator is only needed if the iteration continues. It is applied while
+                // the reduction is still in flight, since it would otherwise wait anyway, and
+                // after the convergence check if the reduction has already completed
+                int done = 0;
+                MPI_Test(&request, &done, MPI_STATUS_IGNORE);
+                const bool overlapped = !done && this->iterations_m < maxIterations;
+                if (overlapped) {
+                    n = op(m);
+                }
+
+                MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+                auto [gamma, delta, rr] = global;
+                this->residueNorm       = std::sqrt(rr);
+                if (this->iterations_m >= maxIterations || this->residueNorm <= tolerance) {
+                    break;
+                }
+
+                if (!overlapped) {
+                    n = op(m);
+                }
+
+                T beta, alpha;
+                if (this->iterations_m == 0) {
+                    beta  = 0;
+                    alpha = gamma / delta;
+                } else {
+                    beta  = gamma / gammaOld;
+                    alpha = gamma / (delta - beta * gamma / alphaOld);
+                }
+
+                if (preconditioner) {
+                    local = fusedLocal(assign(z, n + beta * z), assign(q, m + beta * q),
+                                       assign(s, w + beta * s), assign(p, u + beta * p),
+                                       assign(lhs, lhs + alpha * p), assign(r, r - alpha * s),
+                                       assign(u, u - alpha * q), assign(w, w - alpha * z),
+                                       reduce(r * u), reduce(w * u), reduce(r * r));
+                } else {
+                    auto [rrLocal, wrLocal] = fusedLocal(
+                        assign(z, n + beta * z), assign(s, w + beta * s), assign(p, r + beta * p),
+                        assign(lhs, lhs + alpha * p), assign(r, r - alpha * s),
+                        assign(w, w - alpha * z), reduce(r * r), reduce(w * r));
+                    local = {rrLocal, wrLocal, rrLocal};
+                }
+
+                gammaOld = gamma;
+                alphaOld = alpha;
+                ++this->iterations_m;
+            }
+
+            if (allFacesPeriodic) {
+                T avg = lhs.getVolumeAverage();
+                lhs   = lhs - avg;
+            }
+        }
+    };
+
+}  // namespace ippl
+
+#endif
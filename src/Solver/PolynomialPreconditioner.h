@@ -0,0 +1,320 @@
+//
+// Class ChebyshevPreconditioner
+//   Preconditioner for the Poisson equation -laplace(x) = b that does not need coarse
+//   grids or collective communication when applied: a Chebyshev polynomial in the
+//   Jacobi-preconditioned operator. The spectral bounds for the polynomial are estimated
+//   with a few Lanczos iterations whenever the mesh or layout of the problem changes.
+//
+
+#ifndef IPPL_POLYNOMIAL_PRECONDITIONER_H
+#define IPPL_POLYNOMIAL_PRECONDITIONER_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Utility/IpplTimings.h"
+
+#include "Field/FieldPool.h"
+#include "Preconditioner.h"
+
+namespace ippl {
+    namespace detail {
+        /*!
+         * Computes the inverse of the (constant) diagonal of -laplace on a mesh
+         * @param mesh the mesh
+         * @return The inverse diagonal
+         */
+        template <typename T, typename Mesh>
+        T inverseLaplaceDiagonal(const Mesh& mesh) {
+            T diag = 0;
+            for (unsigned d = 0; d < Mesh::Dimension; ++d) {
+                T h = mesh.getMeshSpacing(d);
+                diag += 2 / (h * h);
+            }
+            return 1 / diag;
+        }
+
+        /*!
+         * Applies a Chebyshev iteration for -laplace(x) = b, preconditioned with the
+         * diagonal, whose spectrum is assumed to lie in [lower, upper]. The residue is
+         * updated with the Laplacian of the previous correction instead of being evaluated
+         * from x, so that each degree needs a single kernel in which no assigned field
+         * is read by the stencil.
+         * @param x the solution, updated in place
+         * @param b the right hand side
+         * @param r a work field for the residue
+         * @param d a work field for the corrections
+         * @param invDiag the inverse diagonal of the operator
+         * @param lower lower bound of the targeted spectrum
+         * @param upper upper bound of the targeted spectrum
+         * @param degree the polynomial degree, i.e. the number of updates of x
+         * @param zeroGuess whether x is zero on entry, in which case x is overwritten
+         * and the first operator application is skipped
+         */
+        template <typename Field, typename T>
+        void chebyshevIteration(Field& x, Field& b, Field& r, Field& d, T invDiag, T lower,
+                                T upper, int degree, bool zeroGuess = false) {
+            const T theta = (upper + lower) / 2;
+            const T delta = (upper - lower) / 2;
+            const T sigma = theta / delta;
+
+            // the corrections vanish on the faces where x is constant
+            typename Field::BConds_t bc;
+            for (unsigned face = 0; face < 2 * Field::dim; ++face) {
+                if (x.getFieldBC()[face]->getBCType() == PERIODIC_FACE) {
+                    bc[face] = std::make_shared<PeriodicFace<Field>>(face);
+                } else {
+                    bc[face] = std::make_shared<ZeroFace<Field>>(face);
+                }
+            }
+
+            // the corrections alternate between two fields, since the stencil is
+            // applied to the previous one while the next one is assigned
+            auto handle = FieldPool<Field>::acquire(d);
+            Field* dOld = &d;
+            Field* dNew = &*handle;
+            dOld->setFieldBC(bc);
+            dNew->setFieldBC(bc);
+
+            T rho = 1 / sigma;
+            if (zeroGuess) {
+                fused(assign(r, b), assign(*dOld, (invDiag / theta) * b), assign(x, *dOld));
+            } else {
+                r = b + laplace(x);
+                fused(assign(*dOld, (invDiag / theta) * r), assign(x, x + *dOld));
+            }
+
+            for (int k = 1; k < degree; ++k) {
+                const T rhoK = 1 / (2 * sigma - rho);
+                fused(assign(r, r + laplace(*dOld)),
+                      assign(*dNew, (rhoK * rho) * *dOld + (2 * rhoK / delta * invDiag) * r),
+                      assign(x, x + *dNew));
+                std::swap(dOld, dNew);
+                rho = rhoK;
+            }
+        }
+
+        /*!
+         * Counts the eigenvalues of a symmetric tridiagonal matrix that are smaller
+         * than a given value, using the Sturm sequence
+         * @param diag the diagonal entries
+         * @param offdiag the off-diagonal entries
+         * @param x the value
+         * @return The number of eigenvalues smaller than x
+         */
+        template <typename T>
+        unsigned sturmCount(const std::vector<T>& diag, const std::vector<T>& offdiag, T x) {
+            unsigned count = 0;
+            T q            = 1;
+            for (size_t i = 0; i < diag.size(); ++i) {
+                T b2 = i > 0 ? offdiag[i - 1] * offdiag[i - 1] : 0;
+                q    = diag[i] - x - (i > 0 ? b2 / q : 0);
+                if (q == 0) {
+                    q = std::numeric_limits<T>::epsilon() * (std::abs(diag[i]) + 1);
+                }
+                if (q < 0) {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        /*!
+         * Computes the extreme eigenvalues of a symmetric tridiagonal matrix by bisection
+         * @param diag the diagonal entries
+         * @param offdiag the off-diagonal entries
+         * @return The smallest and largest eigenvalues
+         */
+        template <typename T>
+        std::pair<T, T> tridiagonalExtremeEigenvalues(const std::vector<T>& diag,
+                                                      const std::vector<T>& offdiag) {
+            const size_t n = diag.size();
+
+            // Gershgorin bounds
+            T lo = diag[0], hi = diag[0];
+            for (size_t i = 0; i < n; ++i) {
+                T radius = (i > 0 ? std::abs(offdiag[i - 1]) : 0)
+                           + (i + 1 < n ? std::abs(offdiag[i]) : 0);
+                lo = std::min(lo, diag[i] - radius);
+                hi = std::max(hi, diag[i] + radius);
+            }
+
+            auto bisect = [&](unsigned k) {
+                // finds the (k+1)-th smallest eigenvalue
+                T a = lo, b = hi;
+                for (int it = 0; it < 100 && b - a > std::numeric_limits<T>::epsilon() * hi;
+                     ++it) {
+                    T mid = (a + b) / 2;
+                    if (sturmCount(diag, offdiag, mid) > k) {
+                        b = mid;
+                    } else {
+                        a = mid;
+                    }
+                }
+                return (a + b) / 2;
+            };
+
+            return {bisect(0), bisect(n - 1)};
+        }
+    }  // namespace detail
+
+    /*!
+     * Chebyshev polynomial preconditioner for -laplace. Parameters:
+     *  chebyshev_degree   the degree of the polynomial
+     *  lanczos_iterations the number of Lanczos iterations for the spectral bounds
+     */
+    template <typename Field>
+    class ChebyshevPreconditioner : public Preconditioner<Field> {
+        using T                       = typename Field::value_type;
+        constexpr static unsigned Dim = Field::dim;
+
+    public:
+        using Mesh_t   = typename Field::Mesh_t;
+        using Layout_t = typename Field::Layout_t;
+
+        ChebyshevPreconditioner() {
+            params_m.add("chebyshev_degree", 4);
+            params_m.add("lanczos_iterations", 10);
+        }
+
+        void mergeParameters(const ParameterList& params) override {
+            params_m.merge(params);
+        }
+
+        void operator()(Field& z, Field& r) override {
+            static IpplTimings::TimerRef chebyshevTimer =
+                IpplTimings::getTimer("Chebyshev preconditioner");
+            IpplTimings::startTimer(chebyshevTimer);
+
+            // The spectrum only needs to be estimated again if the problem changed.
+            // A repartition renews the generation of the layout on all ranks, so
+            // the collective estimate is either done by all ranks or by none
+            const T invDiag  = detail::inverseLaplaceDiagonal<T>(z.get_mesh());
+            bool sameProblem = &z.get_mesh() == mesh_mp && &z.getLayout() == layout_mp
+                               && z.getLayout().getGeneration() == generation_m
+                               && invDiag == invDiag_m;
+            for (unsigned face = 0; face < 2 * Dim; ++face) {
+                sameProblem = sameProblem && z.getFieldBC()[face]->getBCType() == bcTypes_m[face];
+            }
+            if (!sameProblem) {
+                estimateSpectrum(z, invDiag);
+            }
+
+            auto rHandle = FieldPool<Field>::acquire(z);
+            auto dHandle = FieldPool<Field>::acquire(z);
+            detail::chebyshevIteration(z, r, *rHandle, *dHandle, invDiag, lower_m, upper_m,
+                                       params_m.get<int>("chebyshev_degree"), true);
+
+            IpplTimings::stopTimer(chebyshevTimer);
+        }
+
+        /*!
+         * @return The bounds of the spectrum of the Jacobi-preconditioned operator
+         * that is targeted by the polynomial
+         */
+        std::pair<T, T> getSpectralBounds() const { return {lower_m, upper_m}; }
+
+    private:
+        /*!
+         * Estimates the extreme eigenvalues of the Jacobi-preconditioned operator
+         * with Lanczos iterations, starting from a pseudo-random vector
+         * @param z a field with the boundary conditions of the problem
+         * @param invDiag the inverse diagonal of the operator
+         */
+        void estimateSpectrum(Field& z, T invDiag) {
+            static IpplTimings::TimerRef lanczosTimer = IpplTimings::getTimer("Lanczos");
+            IpplTimings::startTimer(lanczosTimer);
+
+            using view_type        = typename Field::view_type;
+            using exec_space       = typename view_type::execution_space;
+            using index_array_type = typename RangePolicy<Dim, exec_space>::index_array_type;
+
+            auto h0 = FieldPool<Field>::acquire(z);
+            auto h1 = FieldPool<Field>::acquire(z);
+            auto h2 = FieldPool<Field>::acquire(z);
+
+            Field* vPrev = &*h0;
+            Field* v     = &*h1;
+            Field* w     = &*h2;
+            for (Field* f : {vPrev, v, w}) {
+                f->setFieldBC(z.getFieldBC());
+            }
+
+            bool allPeriodic = true;
+            for (unsigned face = 0; face < 2 * Dim; ++face) {
+                bcTypes_m[face] = z.getFieldBC()[face]->getBCType();
+                allPeriodic     = allPeriodic && bcTypes_m[face] == PERIODIC_FACE;
+            }
+
+            const auto& lDom = z.getLayout().getLocalNDIndex();
+            const int nghost = v->getNghost();
+            view_type view   = v->getView();
+            ippl::parallel_for(
+                "Lanczos start vector", v->getFieldRangePolicy(),
+                KOKKOS_LAMBDA(const index_array_type& args) {
+                    T h = 0;
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        h = 131 * h + (args[d] + lDom[d].first() - nghost);
+                    }
+                    apply(view, args) = Kokkos::sin(h);
+                });
+            if (allPeriodic) {
+                // the constant mode is the null space of the operator
+                T avg = v->getVolumeAverage();
+                *v    = *v - avg;
+            }
+            *v     = (1 / norm(*v)) * *v;
+            *vPrev = 0;
+
+            std::vector<T> diag, offdiag;
+            const int iterations = params_m.get<int>("lanczos_iterations");
+            T beta               = 0;
+            for (int j = 0; j < iterations; ++j) {
+                T alpha = fused(assign(*w, -invDiag * laplace(*v) - beta * *vPrev),
+                                reduce(*w * *v))[0];
+                diag.push_back(alpha);
+
+                T next = std::sqrt(fused(assign(*w, *w - alpha * *v), reduce(*w * *w))[0]);
+                if (j + 1 == iterations || next <= std::abs(alpha) * 1e-10) {
+                    break;
+                }
+                offdiag.push_back(next);
+
+                std::swap(vPrev, v);
+                std::swap(v, w);
+                *v   = (1 / next) * *v;
+                beta = next;
+            }
+
+            auto [lower, upper] = detail::tridiagonalExtremeEigenvalues(diag, offdiag);
+
+            // Lanczos underestimates the largest eigenvalue, and the spectrum of the
+            // Jacobi-preconditioned Laplacian is bounded by 2
+            upper_m = std::min<T>(1.1 * upper, 2);
+            lower_m = std::max<T>(lower, upper_m * 1e-6);
+
+            mesh_mp      = &z.get_mesh();
+            layout_mp    = &z.getLayout();
+            generation_m = z.getLayout().getGeneration();
+            invDiag_m    = invDiag;
+
+            IpplTimings::stopTimer(lanczosTimer);
+        }
+
+        ParameterList params_m;
+
+        const Mesh_t* mesh_mp     = nullptr;
+        const Layout_t* layout_mp = nullptr;
+        size_t generation_m       = 0;
+        std::array<FieldBC, 2 * Dim> bcTypes_m{};
+        T invDiag_m = 0;
+        T lower_m = 0, upper_m = 0;
+    };
+}  // namespace ippl
+
+#endif
@@ -0,0 +1,40 @@
+//
+// Class Preconditioner
+//   Base class for preconditioners of iterative solver algorithms
+//
+
+#ifndef IPPL_PRECONDITIONER_H
+#define IPPL_PRECONDITIONER_H
+
+#include "Utility/ParameterList.h"
+
+namespace ippl {
+
+    template <typename Field>
+    class Preconditioner {
+    public:
+        using field_type = Field;
+
+        virtual ~Preconditioner() = default;
+
+        /*!
+         * Merges parameters into the preconditioner's parameters; preconditioners
+         * without parameters ignore them
+         * @param params Parameter list with the desired values
+         */
+        virtual void mergeParameters(const ParameterList& /*params*/) {}
+
+        /*!
+         * Applies the preconditioner M to a residue, i.e. computes z = M^{-1} r,
+         * where M approximates the operator of the problem. The preconditioner
+         * must be symmetric positive definite for use with PCG.
+         * @param z The field in which to store the preconditioned residue; it must
+         * have the boundary conditions of the problem
+         * @param r The residue
+         */
+        virtual void operator()(field_type& z, field_type& r) = 0;
+    };
+
+}  // namespace ippl
+
+#endif
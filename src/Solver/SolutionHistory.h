@@ -0,0 +1,136 @@
+//
+// Class SolutionHistory
+//   Keeps the solutions of the last few solves of a sequence of related linear
+//   problems, e.g. one per timestep, to construct initial guesses for iterative
+//   solvers. Two kinds of initial guesses are supported:
+//    - polynomial extrapolation in time, assuming equidistant timesteps
+//    - the projection of the new solution onto the span of the stored solutions,
+//      which minimizes the error in the energy norm of the (symmetric positive
+//      definite) operator. This requires the right hand sides of the previous
+//      problems, which equal the operator applied to the stored solutions.
+//   The number of stored solutions is bounded; the oldest solution is evicted
+//   and its storage reused when the history is full.
+//
+
+#ifndef IPPL_SOLUTION_HISTORY_H
+#define IPPL_SOLUTION_HISTORY_H
+
+#include <deque>
+#include <vector>
+
+namespace ippl {
+
+    template <typename FieldLHS, typename FieldRHS = FieldLHS>
+    class SolutionHistory {
+        using T                       = typename FieldLHS::value_type;
+        constexpr static unsigned Dim = FieldLHS::dim;
+
+    public:
+        using Mesh_t   = typename FieldLHS::Mesh_t;
+        using Layout_t = typename FieldLHS::Layout_t;
+
+        /*!
+         * Sets the maximum number of stored solutions, evicting the oldest
+         * ones if there are more
+         * @param capacity the maximum number of solutions
+         */
+        void setCapacity(unsigned capacity);
+
+        unsigned capacity() const { return capacity_m; }
+
+        unsigned size() const { return entries_m.size(); }
+
+        /*!
+         * Removes all stored solutions
+         */
+        void clear();
+
+        /*!
+         * Stores a copy of a solution
+         * @param x the solution
+         */
+        void push(FieldLHS& x);
+
+        /*!
+         * Stores a copy of a solution and the corresponding right hand side
+         * for use with projection
+         * @param x the solution
+         * @param b the right hand side
+         */
+        void push(FieldLHS& x, FieldRHS& b);
+
+        /*!
+         * Extrapolates the stored solutions to the next timestep with the
+         * polynomial through all stored solutions
+         * @param x the field in which to store the initial guess; it is left
+         * unchanged if there are no stored solutions
+         * @return Whether an initial guess was computed
+         */
+        bool extrapolate(FieldLHS& x);
+
+        /*!
+         * Computes the linear combination of the stored solutions that is
+         * closest to the solution for a new right hand side in the energy norm
+         * @param x the field in which to store the initial guess; it is left
+         * unchanged if there are no stored solutions
+         * @param b the new right hand side
+         * @return Whether an initial guess was computed
+         */
+        bool project(FieldLHS& x, FieldRHS& b);
+
+    private:
+        struct Entry {
+            FieldLHS x;
+            FieldRHS b;
+            bool hasRhs = false;
+        };
+
+        /*!
+         * Clears the history if the mesh or layout of the problem changed, or
+         * the layout was repartitioned, since the solutions were stored
+         * @param x the solution field of the problem
+         */
+        void checkCompatibility(FieldLHS& x);
+
+        /*!
+         * Moves a new or the oldest entry to the front of the history
+         * @param x the solution field
+         * @param b the right hand side, if it should be stored
+         * @return The newest entry
+         */
+        Entry& makeEntry(FieldLHS& x, FieldRHS* b);
+
+        /*!
+         * Removes the inner products of the oldest entry, if any are stored
+         */
+        void dropOldestInnerProducts();
+
+        /*!
+         * Assigns a linear combination of the stored solutions to a field
+         * @param x the destination field
+         * @param coeffs the coefficients, ordered from the newest solution
+         */
+        void combine(FieldLHS& x, const std::vector<T>& coeffs);
+
+        template <typename Field1, typename Field2>
+        static T localInnerProduct(const Field1& f1, const Field2& f2);
+
+        static void allreduce(std::vector<T>& values);
+
+        // newest first
+        std::deque<Entry> entries_m;
+
+        // gram_m[i][j] is the inner product of solution i and right hand side j
+        std::vector<std::vector<T>> gram_m;
+
+        unsigned capacity_m = 0;
+
+        const Mesh_t* mesh_mp     = nullptr;
+        const Layout_t* layout_mp = nullptr;
+        size_t generation_m       = 0;
+    };
+}  // namespace ippl
+
+#include "Solver/SolutionHistory.hpp"
+
+#endif
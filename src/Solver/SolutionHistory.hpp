@@ -0,0 +1,263 @@
+//
+// Class SolutionHistory
+//   Keeps the solutions of the last few solves to construct initial guesses.
+//
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace ippl {
+
+    template <typename FieldLHS, typename FieldRHS>
+    void SolutionHistory<FieldLHS, FieldRHS>::setCapacity(unsigned capacity) {
+        capacity_m = capacity;
+        while (entries_m.size() > capacity_m) {
+            entries_m.pop_back();
+            dropOldestInnerProducts();
+        }
+    }
+
+    template <typename FieldLHS, typename FieldRHS>
+    void SolutionHistory<FieldLHS, FieldRHS>::dropOldestInnerProducts() {
+        if (gram_m.empty()) {
+            return;
+        }
+        gram_m.pop_back();
+        for (auto& row : gram_m) {
+            row.pop_back();
+        }
+    }
+
+    template <typename FieldLHS, typename FieldRHS>
+    void SolutionHistory<FieldLHS, FieldRHS>::clear() {
+        entries_m.clear();
+        gram_m.clear();
+        mesh_mp   = nullptr;
+        layout_mp = nullptr;
+    }
+
+    template <typename FieldLHS, typename FieldRHS>
+    void SolutionHistory<FieldLHS, FieldRHS>::checkCompatibility(FieldLHS& x) {
+        // A repartition starts a new generation of the layout on all ranks, even
+        // those whose local domain is unchanged, so all ranks clear together and
+        // keep the same number of solutions for the reductions
+        const size_t generation = x.getLayout().getGeneration();
+
+        const bool compatible = &x.get_mesh() == mesh_mp && &x.getLayout() == layout_mp
+                                && generation == generation_m;
+        if (!compatible) {
+            clear();
+            mesh_mp      = &x.get_mesh();
+            layout_mp    = &x.getLayout();
+            generation_m = generation;
+        }
+    }
+
+    template <typename FieldLHS, typename FieldRHS>
+    typename SolutionHistory<FieldLHS, FieldRHS>::Entry&
+    SolutionHistory<FieldLHS, FieldRHS>::makeEntry(FieldLHS& x, FieldRHS* b) {
+        checkCompatibility(x);
+
+        // the stored solutions must either all have right hand sides or none
+        if (!entries_m.empty() && entries_m.front().hasRhs != (b != nullptr)) {
+            clear();
+            checkCompatibility(x);
+        }
+
+        if (entries_m.size() < capacity_m) {
+            Entry entry;
+            entry.x.initialize(x.get_mesh(), x.getLayout(), x.getNghost());
+            if (b) {
+                entry.b.initialize(b->get_mesh(), b->getLayout(), b->getNghost());
+            }
+            entries_m.push_front(std::move(entry));
+        } else {
+            // reuse the storage of the oldest solution
+            Entry entry = std::move(entries_m.back());
+            entries_m.pop_back();
+            entries_m.push_front(std::move(entry));
+            dropOldestInnerProducts();
+        }
+
+        Entry& entry = entries_m.front();
+        entry.hasRhs = b != nullptr;
+        Kokkos::deep_copy(entry.x.getView(), x.getView());
+        if (b) {
+            Kokkos::deep_copy(entry.b.getView(), b->getView());
+        }
+        return entry;
+    }
+
+    template <typename FieldLHS, typename FieldRHS>
+    void SolutionHistory<FieldLHS, FieldRHS>::push(FieldLHS& x) {
+        if (capacity_m == 0) {
+            return;
+        }
+        makeEntry(x, nullptr);
+    }
+
+    template <typename FieldLHS, typename FieldRHS>
+    void SolutionHistory<FieldLHS, FieldRHS>::push(FieldLHS& x, FieldRHS& b) {
+        if (capacity_m == 0) {
+            return;
+        }
+        Entry& newest = makeEntry(x, &b);
+
+        // Only the inner products involving the new entry are computed, all
+        // of them with a single reduction
+        const unsigned n = entries_m.size();
+        std::vector<T> values(2 * n - 1);
+        for (unsigned j = 0; j < n; ++j) {
+            values[j] = localInnerProduct(newest.x, entries_m[j].b);
+        }
+        for (unsigned i = 1; i < n; ++i) {
+            values[n + i - 1] = localInnerProduct(entries_m[i].x, newest.b);
+        }
+        allreduce(values);
+
+        std::vector<std::vector<T>> gram(n, std::vector<T>(n));
+        for (unsigned i = 1; i < n; ++i) {
+            for (unsigned j = 1; j < n; ++j) {
+                gram[i][j] = gram_m[i - 1][j - 1];
+            }
+        }
+        for (unsigned j = 0; j < n; ++j) {
+            gram[0][j] = values[j];
+        }
+        for (unsigned i = 1; i < n; ++i) {
+            gram[i][0] = values[n + i - 1];
+        }
+        gram_m = std::move(gram);
+    }
+
+    template <typename FieldLHS, typename FieldRHS>
+    bool SolutionHistory<FieldLHS, FieldRHS>::extrapolate(FieldLHS& x) {
+        checkCompatibility(x);
+
+        const unsigned n = entries_m.size();
+        if (n == 0) {
+            return false;
+        }
+
+        // Lagrange extrapolation from equidistant points: the coefficients
+        // are alternating binomial coefficients, e.g. 2, -1 for two solutions
+        std::vector<T> coeffs(n);
+        T binomial = 1;
+        for (unsigned j = 0; j < n; ++j) {
+            binomial  = binomial * (n - j) / (j + 1);
+            coeffs[j] = (j % 2 == 0) ? binomial : -binomial;
+        }
+        combine(x, coeffs);
+        return true;
+    }
+
+    template <typename FieldLHS, typename FieldRHS>
+    bool SolutionHistory<FieldLHS, FieldRHS>::project(FieldLHS& x, FieldRHS& b) {
+        checkCompatibility(x);
+
+        const unsigned n = entries_m.size();
+        if (n == 0 || !entries_m.front().hasRhs) {
+            return false;
+        }
+
+        std::vector<T> rhs(n);
+        for (unsigned i = 0; i < n; ++i) {
+            rhs[i] = localInnerProduct(entries_m[i].x, b);
+        }
+        allreduce(rhs);
+
+        // Solve the Galerkin system with a Cholesky factorization of the
+        // symmetrized Gram matrix, dropping solutions that are numerically
+        // linearly dependent on newer ones
+        T maxDiag = 0;
+        for (unsigned i = 0; i < n; ++i) {
+            maxDiag = std::max(maxDiag, gram_m[i][i]);
+        }
+        const T dropTolerance = maxDiag * 1e-12;
+
+        std::vector<std::vector<T>> L(n, std::vector<T>(n, 0));
+        std::vector<bool> active(n, false);
+        for (unsigned j = 0; j < n; ++j) {
+            T pivot = gram_m[j][j];
+            for (unsigned k = 0; k < j; ++k) {
+                pivot -= L[j][k] * L[j][k];
+            }
+            if (pivot <= dropTolerance) {
+                continue;
+            }
+            active[j] = true;
+            L[j][j]   = std::sqrt(pivot);
+            for (unsigned i = j + 1; i < n; ++i) {
+                T value = (gram_m[i][j] + gram_m[j][i]) / 2;
+                for (unsigned k = 0; k < j; ++k) {
+                    value -= L[i][k] * L[j][k];
+                }
+                L[i][j] = value / L[j][j];
+            }
+        }
+
+        std::vector<T> coeffs(n, 0);
+        bool anyActive = false;
+        for (unsigned j = 0; j < n; ++j) {
+            if (active[j]) {
+                T value = rhs[j];
+                for (unsigned k = 0; k < j; ++k) {
+                    value -= L[j][k] * coeffs[k];
+                }
+                coeffs[j] = value / L[j][j];
+                anyActive = true;
+            }
+        }
+        if (!anyActive) {
+            return false;
+        }
+        for (int j = n - 1; j >= 0; --j) {
+            if (active[j]) {
+                T value = coeffs[j];
+                for (unsigned i = j + 1; i < n; ++i) {
+                    value -= L[i][j] * coeffs[i];
+                }
+                coeffs[j] = value / L[j][j];
+            }
+        }
+
+        combine(x, coeffs);
+        return true;
+    }
+
+    template <typename FieldLHS, typename FieldRHS>
+    void SolutionHistory<FieldLHS, FieldRHS>::combine(FieldLHS& x, const std::vector<T>& coeffs) {
+        x = coeffs[0] * entries_m[0].x;
+        for (unsigned j = 1; j < coeffs.size(); ++j) {
+            if (coeffs[j] != 0) {
+                x = x + coeffs[j] * entries_m[j].x;
+            }
+        }
+    }
+
+    template <typename FieldLHS, typename FieldRHS>
+    template <typename Field1, typename Field2>
+    typename SolutionHistory<FieldLHS, FieldRHS>::T
+    SolutionHistory<FieldLHS, FieldRHS>::localInnerProduct(const Field1& f1, const Field2& f2) {
+        using exec_space       = typename Field1::execution_space;
+        using index_array_type = typename RangePolicy<Dim, exec_space>::index_array_type;
+
+        T sum      = 0;
+        auto view1 = f1.getView();
+        auto view2 = f2.getView();
+        ippl::parallel_reduce(
+            "SolutionHistory::localInnerProduct", f1.getFieldRangePolicy(),
+            KOKKOS_LAMBDA(const index_array_type& args, T& val) {
+                val += apply(view1, args) * apply(view2, args);
+            },
+            Kokkos::Sum<T>(sum));
+        return sum;
+    }
+
+    template <typename FieldLHS, typename FieldRHS>
+    void SolutionHistory<FieldLHS, FieldRHS>::allreduce(std::vector<T>& values) {
+        MPI_Datatype type = get_mpi_datatype<T>(values[0]);
+        MPI_Allreduce(MPI_IN_PLACE, values.data(), values.size(), type, MPI_SUM,
+                      Comm->getCommunicator());
+    }
+}  // namespace ippl
@@ -87,6 +87,53 @@ void Timing::clearTimer(TimerRef t) {
     TimerList[t]->clear();
 }
 
+// create a counter, or get one that already exists
+Timing::CounterRef Timing::getCounter(const char* nm) {
+    std::string s(nm);
+    auto loc = CounterMap.find(s);
+    if (loc != CounterMap.end()) {
+        return loc->second;
+    }
+    CounterRef c = CounterNames.size();
+    CounterNames.push_back(s);
+    CounterValues.push_back(0);
+    CounterMap.insert(std::make_pair(s, c));
+    return c;
+}
+
+// add to the value of a counter
+void Timing::incrementCounter(CounterRef c, unsigned long n) {
+    if (c >= CounterValues.size())
+        return;
+    CounterValues[c] += n;
+}
+
+// return the local value of a counter
+unsigned long Timing::valueCounter(CounterRef c) const {
+    if (c >= CounterValues.size())
+        return 0;
+    return CounterValues[c];
+}
+
+// print the counters summed over all ranks
+void Timing::printCounters(Inform& msg) {
+    if (CounterValues.size() < 1)
+        return;
+
+    msg << "\n"
+        << "Counters (summed over all ranks):"
+        << "\n";
+    for (unsigned int i = 0; i < CounterValues.size(); ++i) {
+        unsigned long total = 0;
+        MPI_Reduce(&CounterValues[i], &total, 1, MPI_UNSIGNED_LONG, MPI_SUM, 0,
+                   ippl::Comm->getCommunicator());
+        size_t lengthName = std::min(CounterNames[i].length(), 19lu);
+        msg << CounterNames[i].substr(0, lengthName)
+            << std::string().assign(20 - lengthName, '.') << " Count = " << std::setw(10)
+            << total << "\n";
+    }
+}
+
 // print out the timing results
 void Timing::print() {
     if (TimerList.size() < 1)
@@ -131,6 +178,7 @@ void Timing::print() {
             << std::string().assign(20, ' ') << " Wall min = " << std::setw(10) << wallmin << "\n"
             << "\n";
     }
+    printCounters(msg);
     msg << "---------------------------------------------";
     msg << endl;
 }
@@ -195,6 +243,8 @@ void Timing::print(const std::string& fn, const std::map<std::string, unsigned i
              << wallmin << " " << std::setw(9) << std::setprecision(4)
              << wallavg / ippl::Comm->size() << endl;
     }
+    printCounters(*msg);
+    *msg << endl;
     timer_stream->close();
     delete msg;
     delete timer_stream;
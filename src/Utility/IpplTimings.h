@@ -21,6 +21,11 @@
 //    4) print out the results:
 //       IpplTimings::print();
 //
+//   Event counters work the same way:
+//       IpplTimings::CounterRef c = IpplTimings::getCounter("counter name");
+//       IpplTimings::incrementCounter(c);
+//    Counters are summed over all ranks when printed.
+//
 #ifndef IPPL_TIMINGS_H
 #define IPPL_TIMINGS_H
 
@@ -35,6 +40,8 @@
 #include "Utility/Timer.h"
 #include "Utility/my_auto_ptr.h"
 
+class Inform;
+
 // a simple class used to store timer values
 class IpplTimerInfo {
 public:
@@ -96,6 +103,9 @@ struct Timing {
     // typedef for reference to a timer
     typedef unsigned int TimerRef;
 
+    // typedef for reference to a counter
+    typedef unsigned int CounterRef;
+
     // a typedef for the timer information object
     typedef IpplTimerInfo TimerInfo;
 
@@ -120,6 +130,15 @@ struct Timing {
     // return a TimerInfo struct by asking for the name
     TimerInfo* infoTimer(const char* nm) { return TimerMap[std::string(nm)]; }
 
+    // create a counter, or get one that already exists
+    CounterRef getCounter(const char*);
+
+    // add to the value of a counter
+    void incrementCounter(CounterRef, unsigned long n);
+
+    // return the local value of a counter
+    unsigned long valueCounter(CounterRef) const;
+
     // print the results to standard out
     void print();
 
@@ -136,6 +155,16 @@ private:
 
     // a map of timers, keyed by string
     TimerMap_t TimerMap;
+
+    // names and local values of the counters
+    std::vector<std::string> CounterNames;
+    std::vector<unsigned long> CounterValues;
+
+    // a map of counters, keyed by string
+    std::map<std::string, CounterRef> CounterMap;
+
+    // print the counters summed over all ranks
+    void printCounters(Inform& msg);
 };
 
 class IpplTimings {
@@ -143,6 +172,9 @@ public:
     // typedef for reference to a timer
     typedef Timing::TimerRef TimerRef;
 
+    // typedef for reference to a counter
+    typedef Timing::CounterRef CounterRef;
+
     // a typedef for the timer information object
     typedef Timing::TimerInfo TimerInfo;
 
@@ -161,6 +193,17 @@ public:
     // return a TimerInfo struct by asking for the name
     static TimerInfo* infoTimer(const char* nm) { return instance->infoTimer(nm); }
 
+    // create a counter, or get one that already exists
+    static CounterRef getCounter(const char* nm) { return instance->getCounter(nm); }
+
+    // add to the value of a counter
+    static void incrementCounter(CounterRef c, unsigned long n = 1) {
+        instance->incrementCounter(c, n);
+    }
+
+    // return the local value of a counter
+    static unsigned long valueCounter(CounterRef c) { return instance->valueCounter(c); }
+
     // print the results to standard out
     static void print() { instance->print(); }
 
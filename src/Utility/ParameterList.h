@@ -59,6 +59,21 @@ namespace ippl {
             return std::get<T>(params_m.at(key));
         }
 
+        /*!
+         * Obtain the value of a parameter, or a default value
+         * if the key is not contained.
+         * @param key the name of the parameter
+         * @param defaultValue the value returned for a missing key
+         * @returns the value of a parameter
+         */
+        template <typename T>
+        T get(const std::string& key, const T& defaultValue) const {
+            if (!params_m.contains(key)) {
+                return defaultValue;
+            }
+            return std::get<T>(params_m.at(key));
+        }
+
         /*!
          * Merge a parameter list into this parameter list.
          * @param p the parameter list to merge into this
@@ -105,14 +105,15 @@ namespace ippl {
         template <typename View, size_t... Idx>
         decltype(auto) shrinkView_impl(std::string label, const View& view, int nghost,
                                        const std::index_sequence<Idx...>&) {
-            using view_type = typename Kokkos::View<typename View::data_type, Kokkos::LayoutLeft,
-                                                    typename View::memory_space>::uniform_type;
+            using view_type =
+                typename Kokkos::View<typename View::data_type, typename View::array_layout,
+                                      typename View::memory_space>::uniform_type;
             return view_type(label, (view.extent(Idx) - 2 * nghost)...);
         }
 
         /*!
-         * Constructs a new view with size equal to that of the given view, minus the ghost cells
-         * (used for heFFTe, which expects the data to have a certain layout and no ghost cells)
+         * Constructs a new view with size equal to that of the given view, minus the ghost cells,
+         * and the same layout (used for heFFTe, which expects the data without ghost cells)
          * @param label the new view's name
          * @param view the view to shrink
          * @param nghost the number of ghost cells on the view's boundary
@@ -122,6 +123,52 @@ namespace ippl {
         decltype(auto) shrinkView(std::string label, const View& view, int nghost) {
             return shrinkView_impl(label, view, nghost, std::make_index_sequence<View::rank>{});
         }
+
+        /*!
+         * The slowest running dimension of a view, along which batches of arrays are
+         * stored one after the other
+         * @tparam View a view with layout left or layout right
+         * @return The index of the dimension
+         */
+        template <typename View>
+        constexpr size_t batchDimension() {
+            using layout = typename View::array_layout;
+            static_assert(std::is_same_v<layout, Kokkos::LayoutLeft>
+                              || std::is_same_v<layout, Kokkos::LayoutRight>,
+                          "Batches require layout left or layout right");
+            return std::is_same_v<layout, Kokkos::LayoutLeft> ? View::rank - 1 : 0;
+        }
+
+        /*!
+         * Utility function for batchedShrinkView
+         */
+        template <typename BatchView, typename View, size_t... Idx>
+        BatchView batchedShrinkView_impl(std::string label, const View& view, int nghost,
+                                         size_t batch, const std::index_sequence<Idx...>&) {
+            constexpr size_t slowest = batchDimension<BatchView>();
+            return BatchView(label,
+                             (view.extent(Idx) - 2 * nghost) * (Idx == slowest ? batch : 1)...);
+        }
+
+        /*!
+         * Constructs a new view that holds a batch of arrays the size of the given view
+         * minus the ghost cells (see shrinkView), stored contiguously one after the other.
+         * The array with index b is found by offsetting the index of the slowest running
+         * dimension (see batchDimension) by b times the shrunken extent.
+         * @tparam BatchView the type of the new view
+         * @param label the new view's name
+         * @param view the view to shrink
+         * @param nghost the number of ghost cells on the view's boundary
+         * @param batch the number of arrays
+         * @return The batched view
+         */
+        template <typename BatchView, typename View>
+        BatchView batchedShrinkView(std::string label, const View& view, int nghost,
+                                    size_t batch) {
+            static_assert(BatchView::rank == View::rank);
+            return batchedShrinkView_impl<BatchView>(label, view, nghost, batch,
+                                                     std::make_index_sequence<View::rank>{});
+        }
     }  // namespace detail
 }  // namespace ippl
 
@@ -1,7 +1,11 @@
 // Tests the conjugate gradient solver for electrostatics problems
 // by checking the relative error from the exact solution
 // Usage:
-//      TestCGSolver [size [scaling_type]]
+//      TestCGSolver [size [scaling_type [variant]]]
+//      where scaling_type is 'w' for weak scaling (any other value for strong scaling)
+//      and variant is 'mg' or 'chebyshev' for a multigrid or Chebyshev polynomial
+//      preconditioner, 'pipelined' for pipelined CG or 'mixed' for mixed precision CG
+//      (default: unpreconditioned CG)
 
 #include "Ippl.h"
 
@@ -9,6 +13,7 @@
 #include <Kokkos_MathematicalFunctions.hpp>
 #include <cstdlib>
 #include <iostream>
+#include <string>
 #include <typeinfo>
 
 #include "Utility/Inform.h"
@@ -22,10 +27,15 @@ int main(int argc, char* argv[]) {
         constexpr unsigned int dim = 3;
         using Mesh_t               = ippl::UniformCartesian<double, 3>;
         using Centering_t          = Mesh_t::DefaultCentering;
+        typedef ippl::Field<double, dim, Mesh_t, Centering_t> field_type;
 
         int pt = 4, ptY = 4;
         bool isWeak = false;
 
+        using solver_type  = ippl::ElectrostaticsCG<field_type, field_type, true>;
+        int algorithm      = solver_type::CG;
+        int preconditioner = solver_type::NO_PRECONDITIONER;
+
         Inform info("Config");
         if (argc >= 2) {
             // First argument is the problem size (log2)
@@ -42,6 +52,22 @@ int main(int argc, char* argv[]) {
                     info << "Performing weak scaling" << endl;
                     isWeak = true;
                 }
+                if (argc >= 4 && std::string(argv[3]) == "mg") {
+                    info << "Using multigrid preconditioner" << endl;
+                    preconditioner = solver_type::MULTIGRID;
+                }
+                if (argc >= 4 && std::string(argv[3]) == "chebyshev") {
+                    info << "Using Chebyshev preconditioner" << endl;
+                    preconditioner = solver_type::CHEBYSHEV;
+                }
+                if (argc >= 4 && std::string(argv[3]) == "pipelined") {
+                    info << "Using pipelined CG" << endl;
+                    algorithm = solver_type::PIPELINED_CG;
+                }
+                if (argc >= 4 && std::string(argv[3]) == "mixed") {
+                    info << "Using mixed precision CG" << endl;
+                    algorithm = solver_type::MIXED_PRECISION_CG;
+                }
             }
         }
 
@@ -65,7 +91,6 @@ int main(int argc, char* argv[]) {
 
         double pi = Kokkos::numbers::pi_v<double>;
 
-        typedef ippl::Field<double, dim, Mesh_t, Centering_t> field_type;
         field_type rhs(mesh, layout), lhs(mesh, layout), solution(mesh, layout);
 
         typedef ippl::BConds<field_type, dim> bc_type;
@@ -121,10 +146,12 @@ int main(int argc, char* argv[]) {
                              * sin(sin(pi * z)));
             });
 
-        ippl::ElectrostaticsCG<field_type> lapsolver;
+        solver_type lapsolver;
 
         ippl::ParameterList params;
         params.add("max_iterations", 2000);
+        params.add("preconditioner", preconditioner);
+        params.add("algorithm", algorithm);
         lapsolver.mergeParameters(params);
 
         lapsolver.setRhs(rhs);
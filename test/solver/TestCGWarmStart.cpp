@@ -0,0 +1,130 @@
+// Tests warm starting of the conjugate gradient solver for a sequence of
+// periodic problems whose solution drifts slowly in time, and compares the
+// total number of iterations with and without warm starting
+// Usage:
+//      TestCGWarmStart [size [steps [history]]]
+//      where size is the log2 of the number of cells per dimension, steps is
+//      the number of timesteps and history the number of stored solutions
+
+#include "Ippl.h"
+
+#include <Kokkos_MathematicalConstants.hpp>
+#include <Kokkos_MathematicalFunctions.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "Utility/Inform.h"
+#include "Utility/IpplTimings.h"
+
+#include "Solver/ElectrostaticsCG.h"
+
+int main(int argc, char* argv[]) {
+    ippl::initialize(argc, argv);
+    {
+        constexpr unsigned int dim = 3;
+        using Mesh_t               = ippl::UniformCartesian<double, 3>;
+        using Centering_t          = Mesh_t::DefaultCentering;
+
+        typedef ippl::Field<double, dim, Mesh_t, Centering_t> field_type;
+        typedef ippl::ElectrostaticsCG<field_type> solver_type;
+
+        int pt      = 32;
+        int steps   = 20;
+        int history = 3;
+
+        Inform info("Config");
+        if (argc >= 2) {
+            pt = 1 << strtol(argv[1], NULL, 10);
+        }
+        if (argc >= 3) {
+            steps = strtol(argv[2], NULL, 10);
+        }
+        if (argc >= 4) {
+            history = strtol(argv[3], NULL, 10);
+        }
+        info << "Size " << pt << ", " << steps << " steps, history " << history << endl;
+
+        ippl::Index I(pt);
+        ippl::NDIndex<dim> owned(I, I, I);
+
+        ippl::e_dim_tag allParallel[dim];  // Specifies SERIAL, PARALLEL dims
+        for (unsigned int d = 0; d < dim; d++) {
+            allParallel[d] = ippl::PARALLEL;
+        }
+
+        ippl::FieldLayout<dim> layout(owned, allParallel);
+
+        // Unit box
+        double dx                        = 1.0 / double(pt);
+        ippl::Vector<double, dim> hx     = dx;
+        ippl::Vector<double, dim> origin = 0;
+        Mesh_t mesh(owned, hx, origin);
+
+        double pi = Kokkos::numbers::pi_v<double>;
+
+        field_type rhs(mesh, layout), lhs(mesh, layout);
+
+        typedef ippl::BConds<field_type, dim> bc_type;
+
+        bc_type bcField;
+        for (unsigned int i = 0; i < 2 * dim; ++i) {
+            bcField[i] = std::make_shared<ippl::PeriodicFace<field_type>>(i);
+        }
+        lhs.setFieldBC(bcField);
+
+        const ippl::NDIndex<dim>& lDom = layout.getLocalNDIndex();
+        const int shift                = rhs.getNghost();
+
+        // the right hand side for the solution sin(2 pi (x - vt)) sin(2 pi y) sin(2 pi z)
+        auto assignRhs = [&](double time) {
+            typename field_type::view_type viewRHS = rhs.getView();
+            Kokkos::parallel_for(
+                "Assign rhs", rhs.getFieldRangePolicy(),
+                KOKKOS_LAMBDA(const int i, const int j, const int k) {
+                    const size_t ig = i + lDom[0].first() - shift;
+                    const size_t jg = j + lDom[1].first() - shift;
+                    const size_t kg = k + lDom[2].first() - shift;
+                    double x        = (ig + 0.5) * hx[0];
+                    double y        = (jg + 0.5) * hx[1];
+                    double z        = (kg + 0.5) * hx[2];
+
+                    viewRHS(i, j, k) = 12 * pi * pi * Kokkos::sin(2 * pi * (x - 0.01 * time))
+                                       * Kokkos::sin(2 * pi * y) * Kokkos::sin(2 * pi * z);
+                });
+        };
+
+        Inform m("Warm start");
+
+        const std::string names[] = {"none", "extrapolation", "projection"};
+        for (int warmStart :
+             {solver_type::NO_WARM_START, solver_type::EXTRAPOLATION, solver_type::PROJECTION}) {
+            solver_type solver;
+
+            ippl::ParameterList params;
+            params.add("tolerance", 1e-10);
+            params.add("warm_start", warmStart);
+            params.add("warm_start_history", history);
+            solver.mergeParameters(params);
+
+            solver.setRhs(rhs);
+            solver.setLhs(lhs);
+
+            lhs            = 0;
+            int iterations = 0;
+            for (int step = 0; step < steps; ++step) {
+                assignRhs(step);
+                solver.solve();
+                iterations += solver.getIterationCount();
+            }
+
+            m << names[warmStart] << "," << iterations << "," << std::setprecision(16)
+              << solver.getResidue() << endl;
+        }
+
+        IpplTimings::print("timings" + std::to_string(pt) + ".dat");
+    }
+    ippl::finalize();
+
+    return 0;
+}
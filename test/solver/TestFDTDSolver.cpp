@@ -0,0 +1,285 @@
+//
+// TestFDTDSolver
+// This program tests the FDTDSolver class. It checks
+//   1. the propagation of a plane wave over one period in a periodic box,
+//   2. the discrete continuity equation for the deposited current of
+//      randomly moving particles,
+//   3. the absorption of a pulse by the absorbing boundaries.
+//   Usage:
+//     srun ./TestFDTDSolver <n> <np> --info 5
+//     n  = No. cells in each direction
+//     np = No. particles for the continuity test
+//
+//     Example:
+//       srun ./TestFDTDSolver 32 10000 --info 5
+//
+//
+
+#include "Ippl.h"
+
+#include <Kokkos_MathematicalConstants.hpp>
+#include <Kokkos_MathematicalFunctions.hpp>
+#include <Kokkos_Random.hpp>
+#include <cstdlib>
+
+#include "Utility/IpplTimings.h"
+
+#include "Solver/FDTDSolver.h"
+
+constexpr unsigned int Dim = 3;
+
+using Mesh_t   = ippl::UniformCartesian<double, Dim>;
+using vector_t = ippl::Vector<double, Dim>;
+using field    = ippl::Field<double, Dim, Mesh_t, Mesh_t::DefaultCentering>;
+using fieldE   = ippl::Field<vector_t, Dim, Mesh_t, ippl::Face>;
+using fieldB   = ippl::Field<vector_t, Dim, Mesh_t, ippl::Edge>;
+using Solver_t = ippl::FDTDSolver<fieldE, fieldB>;
+
+using playout_type = ippl::ParticleSpatialLayout<double, Dim>;
+
+struct Bunch : public ippl::ParticleBase<playout_type> {
+    Bunch(playout_type& playout)
+        : ippl::ParticleBase<playout_type>(playout) {
+        this->addAttribute(Q);
+        this->addAttribute(R0);
+    }
+
+    ippl::ParticleAttrib<double> Q;
+
+    // positions at the beginning of the time step
+    typename ippl::ParticleBase<playout_type>::particle_position_type R0;
+};
+
+// the maximum of a field over the owned cells
+template <typename Functor>
+double maxNorm(fieldE& E, Functor&& f) {
+    double localMax = 0.0;
+    Kokkos::parallel_reduce(
+        "max norm", E.getFieldRangePolicy(),
+        KOKKOS_LAMBDA(const int i, const int j, const int k, double& val) {
+            val = Kokkos::max(val, Kokkos::abs(f(i, j, k)));
+        },
+        Kokkos::Max<double>(localMax));
+
+    double globalMax = 0.0;
+    MPI_Allreduce(&localMax, &globalMax, 1, MPI_DOUBLE, MPI_MAX, ippl::Comm->getCommunicator());
+    return globalMax;
+}
+
+int main(int argc, char* argv[]) {
+    ippl::initialize(argc, argv);
+    {
+        Inform msg(argv[0]);
+
+        static IpplTimings::TimerRef allTimer = IpplTimings::getTimer("allTimer");
+        IpplTimings::startTimer(allTimer);
+
+        const int n        = std::atoi(argv[1]);
+        const size_t npTot = std::atol(argv[2]);
+
+        const double pi = Kokkos::numbers::pi_v<double>;
+
+        ippl::NDIndex<Dim> owned;
+        ippl::e_dim_tag decomp[Dim];
+        for (unsigned d = 0; d < Dim; d++) {
+            owned[d]  = ippl::Index(n);
+            decomp[d] = ippl::PARALLEL;
+        }
+
+        // unit box
+        const double h  = 1.0 / n;
+        vector_t hr     = {h, h, h};
+        vector_t origin = {0.0, 0.0, 0.0};
+        Mesh_t mesh(owned, hr, origin);
+
+        ippl::FieldLayout<Dim> periodicLayout(owned, decomp, true);
+        ippl::FieldLayout<Dim> openLayout(owned, decomp);
+
+        /////////////////////////////////////////////////////////////////////
+        // plane wave along x, E along y and B along z, with c = 1
+        {
+            fieldE E(mesh, periodicLayout);
+            fieldB B(mesh, periodicLayout);
+            fieldE J(mesh, periodicLayout, 2);
+            J = 0.0;
+
+            // the wave travels through the box in a time of 1, which is split into
+            // whole steps below the stability limit
+            const int steps = std::ceil(std::sqrt(3.0) / (0.95 * h));
+            const double dt = 1.0 / steps;
+
+            ippl::ParameterList params;
+            params.add("boundary", Solver_t::PERIODIC);
+            params.add("dt", dt);
+            Solver_t solver(E, B, J, params);
+
+            auto viewE       = E.getView();
+            auto viewB       = B.getView();
+            const int nghost = E.getNghost();
+            const auto& ldom = periodicLayout.getLocalNDIndex();
+            const double k   = 2 * pi;
+
+            // E_y lies at the cell center in x and B_z at the upper cell boundary
+            Kokkos::parallel_for(
+                "Assign plane wave", ippl::getRangePolicy(viewE),
+                KOKKOS_LAMBDA(const int i, const int j, const int l) {
+                    const int ig = i + ldom[0].first() - nghost;
+
+                    viewE(i, j, l) = {0.0, Kokkos::cos(k * (ig + 0.5) * h), 0.0};
+                    viewB(i, j, l) = {0.0, 0.0, Kokkos::cos(k * (ig + 1.0) * h)};
+                });
+
+            const double energy0 = solver.getFieldEnergy();
+            for (int it = 0; it < steps; ++it) {
+                solver.solve();
+            }
+            const double energy1 = solver.getFieldEnergy();
+
+            auto viewE1   = E.getView();
+            double errorE = maxNorm(E, KOKKOS_LAMBDA(const int i, const int j, const int l) {
+                const int ig = i + ldom[0].first() - nghost;
+                return viewE1(i, j, l)[1] - Kokkos::cos(k * (ig + 0.5) * h);
+            });
+
+            msg << "Plane wave: " << steps << " steps, max error E_y = " << errorE
+                << ", relative energy change = " << (energy1 - energy0) / energy0 << endl;
+        }
+
+        /////////////////////////////////////////////////////////////////////
+        // continuity equation for the current of particles moving by up to half a cell
+        {
+            fieldE E(mesh, periodicLayout);
+            fieldB B(mesh, periodicLayout);
+            fieldE J(mesh, periodicLayout, 2);
+            field rho0(mesh, periodicLayout);
+            field rho1(mesh, periodicLayout);
+            J = 0.0;
+
+            ippl::ParameterList params;
+            params.add("boundary", Solver_t::PERIODIC);
+            Solver_t solver(E, B, J, params);
+            const double dt = solver.getTimeStep();
+
+            playout_type pl(periodicLayout, mesh);
+            Bunch bunch(pl);
+            bunch.setParticleBC(ippl::BC::PERIODIC);
+
+            size_t np = npTot / ippl::Comm->size();
+            if (ippl::Comm->rank() < int(npTot % ippl::Comm->size())) {
+                ++np;
+            }
+            bunch.create(np);
+
+            Kokkos::Random_XorShift64_Pool<> pool(42 + ippl::Comm->rank());
+            auto viewR = bunch.R.getView();
+            auto viewQ = bunch.Q.getView();
+            Kokkos::parallel_for(
+                "Assign particles", np, KOKKOS_LAMBDA(const size_t i) {
+                    auto generator = pool.get_state();
+                    for (unsigned d = 0; d < Dim; d++) {
+                        viewR(i)[d] = generator.drand(0.0, 1.0);
+                    }
+                    viewQ(i) = generator.drand(-1.0, 1.0);
+                    pool.free_state(generator);
+                });
+            bunch.update();
+
+            rho0 = 0.0;
+            scatter(bunch.Q, rho0, bunch.R);
+
+            viewR       = bunch.R.getView();
+            auto viewR0 = bunch.R0.getView();
+            Kokkos::parallel_for(
+                "Move particles", bunch.getLocalNum(), KOKKOS_LAMBDA(const size_t i) {
+                    viewR0(i) = viewR(i);
+
+                    auto generator = pool.get_state();
+                    for (unsigned d = 0; d < Dim; d++) {
+                        viewR(i)[d] += generator.drand(-0.5 * h, 0.5 * h);
+                    }
+                    pool.free_state(generator);
+                });
+
+            // the current is deposited before the particles change ranks
+            solver.depositCurrent(bunch.Q, bunch.R0, bunch.R);
+            bunch.update();
+
+            rho1 = 0.0;
+            scatter(bunch.Q, rho1, bunch.R);
+
+            J.fillHalo();
+            auto viewJ        = J.getView();
+            auto viewRho0     = rho0.getView();
+            auto viewRho1     = rho1.getView();
+            const int nghostJ = J.getNghost();
+            const int nghostR = rho0.getNghost();
+            const int shift   = nghostJ - nghostR;
+            const double V    = h * h * h;
+
+            // scatter deposits the charge of the cells, which is divided by the cell volume
+            double residual = maxNorm(J, KOKKOS_LAMBDA(const int i, const int j, const int l) {
+                const int ir = i - shift, jr = j - shift, lr = l - shift;
+
+                const double drho = (viewRho1(ir, jr, lr) - viewRho0(ir, jr, lr)) / (V * dt);
+                const double divJ = (viewJ(i, j, l)[0] - viewJ(i - 1, j, l)[0]) / h
+                                    + (viewJ(i, j, l)[1] - viewJ(i, j - 1, l)[1]) / h
+                                    + (viewJ(i, j, l)[2] - viewJ(i, j, l - 1)[2]) / h;
+                return drho + divJ;
+            });
+
+            double scale = maxNorm(J, KOKKOS_LAMBDA(const int i, const int j, const int l) {
+                return viewJ(i, j, l)[0] / h;
+            });
+
+            msg << "Continuity: max residual = " << residual << ", relative to max |J_x| / h = "
+                << residual / scale << endl;
+        }
+
+        /////////////////////////////////////////////////////////////////////
+        // a pulse leaving the box through the absorbing boundaries
+        {
+            fieldE E(mesh, openLayout);
+            fieldB B(mesh, openLayout);
+            fieldE J(mesh, openLayout, 2);
+            E = 0.0;
+            B = 0.0;
+            J = 0.0;
+
+            ippl::ParameterList params;
+            params.add("boundary", Solver_t::ABSORBING);
+            Solver_t solver(E, B, J, params);
+
+            auto viewE          = E.getView();
+            const int nghost    = E.getNghost();
+            const auto& ldom    = openLayout.getLocalNDIndex();
+            const double sigma2 = 0.01;
+
+            // E_z does not depend on z, so the pulse is divergence free
+            Kokkos::parallel_for(
+                "Assign pulse", E.getFieldRangePolicy(),
+                KOKKOS_LAMBDA(const int i, const int j, const int l) {
+                    const double x = (i + ldom[0].first() - nghost + 0.5) * h - 0.5;
+                    const double y = (j + ldom[1].first() - nghost + 0.5) * h - 0.5;
+
+                    viewE(i, j, l)[2] = Kokkos::exp(-(x * x + y * y) / (2 * sigma2));
+                });
+
+            // the pulse crosses the box twice
+            const int steps      = 2.0 / solver.getTimeStep();
+            const double energy0 = solver.getFieldEnergy();
+            for (int it = 0; it < steps; ++it) {
+                solver.solve();
+            }
+            const double energy1 = solver.getFieldEnergy();
+
+            msg << "Absorbing boundaries: " << steps
+                << " steps, remaining energy fraction = " << energy1 / energy0 << endl;
+        }
+
+        IpplTimings::stopTimer(allTimer);
+        IpplTimings::print(std::string("timing.dat"));
+    }
+    ippl::finalize();
+
+    return 0;
+}
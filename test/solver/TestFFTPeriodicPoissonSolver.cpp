@@ -3,6 +3,7 @@
 #include <Kokkos_MathematicalConstants.hpp>
 #include <Kokkos_MathematicalFunctions.hpp>
 #include <iostream>
+#include <string>
 #include <typeinfo>
 
 #include "Solver/FFTPeriodicPoissonSolver.h"
@@ -17,6 +18,9 @@ int main(int argc, char* argv[]) {
         const int npts            = 7;
         std::array<int, npts> pts = {2, 4, 8, 16, 32, 64, 128};
 
+        // with the argument "single", the transforms are done in single precision
+        const bool single = argc > 1 && std::string(argv[1]) == "single";
+
         if (ippl::Comm->size() > 4) {
             if (ippl::Comm->rank() == 0) {
                 std::cerr << " Too many MPI ranks please use <= 4 ranks" << std::endl;
@@ -51,7 +55,7 @@ int main(int argc, char* argv[]) {
             Field_t field;
             field.initialize(mesh, layout);
 
-            typedef ippl::FFTPeriodicPoissonSolver<VField_t, Field_t> Solver_t;
+            typedef ippl::FFTPeriodicPoissonSolver<VField_t, Field_t, true> Solver_t;
 
             ippl::ParameterList params;
             params.add("output_type", Solver_t::SOL);
@@ -61,6 +65,7 @@ int main(int argc, char* argv[]) {
             params.add("use_gpu_aware", true);
             params.add("comm", ippl::a2av);
             params.add("r2c_direction", 0);
+            params.add("single_precision", single);
 
             Solver_t FFTsolver;
 
@@ -118,7 +123,9 @@ int main(int argc, char* argv[]) {
                     double error_norm2 = error1 / error2;
 
                     if (ippl::Comm->rank() == 0) {
-                        std::cout << "L2 relative error norm: " << error_norm2 << std::endl;
+                        std::cout << "L2 relative error norm: " << error_norm2
+                                  << ", rounding error estimate: " << FFTsolver.getErrorEstimate()
+                                  << std::endl;
                     }
                     break;
                 }
@@ -0,0 +1,133 @@
+// This program tests the FFTDirichletPoissonSolver and the FFTNeumannPoissonSolver
+// on the unit cube with the potentials
+//     phi = sin(pi x) sin(pi y) sin(pi z)   (Dirichlet)
+//     phi = cos(pi x) cos(pi y) cos(pi z)   (Neumann)
+// whose charge density is 3 pi^2 phi in both cases. The relative L2 errors of the
+// potential and of the electric field are printed for a sequence of grid sizes
+// and should decrease at second order.
+//   Usage:
+//     srun ./TestFFTTrigPoissonSolver --info 5
+
+#include "Ippl.h"
+
+#include <Kokkos_MathematicalConstants.hpp>
+#include <Kokkos_MathematicalFunctions.hpp>
+#include <iostream>
+#include <string>
+
+#include "Solver/FFTDirichletPoissonSolver.h"
+#include "Solver/FFTNeumannPoissonSolver.h"
+
+constexpr unsigned int dim = 3;
+using Mesh_t               = ippl::UniformCartesian<double, dim>;
+using Centering_t          = Mesh_t::DefaultCentering;
+using Vector_t             = ippl::Vector<double, dim>;
+using Field_t              = ippl::Field<double, dim, Mesh_t, Centering_t>;
+using VField_t             = ippl::Field<Vector_t, dim, Mesh_t, Centering_t>;
+
+template <typename Solver, bool Dirichlet>
+void test(const std::string& name) {
+    const double pi = Kokkos::numbers::pi_v<double>;
+
+    for (int pt : {8, 16, 32, 64, 128}) {
+        ippl::Index I(pt);
+        ippl::NDIndex<dim> owned(I, I, I);
+
+        ippl::e_dim_tag decomp[dim];
+        for (unsigned int d = 0; d < dim; d++) {
+            decomp[d] = ippl::PARALLEL;
+        }
+
+        ippl::FieldLayout<dim> layout(owned, decomp);
+
+        // unit cube
+        double dx       = 1.0 / double(pt);
+        Vector_t hx     = {dx, dx, dx};
+        Vector_t origin = {0.0, 0.0, 0.0};
+        Mesh_t mesh(owned, hx, origin);
+
+        Field_t rho(mesh, layout);
+        Field_t phi_exact(mesh, layout);
+        VField_t E(mesh, layout);
+        VField_t E_exact(mesh, layout);
+
+        const ippl::NDIndex<dim>& lDom = layout.getLocalNDIndex();
+        const int nghost               = rho.getNghost();
+        auto view                      = rho.getView();
+        auto view_exact                = phi_exact.getView();
+        auto Eview_exact               = E_exact.getView();
+
+        Kokkos::parallel_for(
+            "Assign rhs", rho.getFieldRangePolicy(),
+            KOKKOS_LAMBDA(const int i, const int j, const int k) {
+                using Kokkos::cos, Kokkos::sin;
+                Vector_t x;
+                x[0] = origin[0] + (i + lDom[0].first() - nghost + 0.5) * hx[0];
+                x[1] = origin[1] + (j + lDom[1].first() - nghost + 0.5) * hx[1];
+                x[2] = origin[2] + (k + lDom[2].first() - nghost + 0.5) * hx[2];
+
+                Vector_t f, df;
+                for (unsigned d = 0; d < dim; ++d) {
+                    f[d]  = Dirichlet ? sin(pi * x[d]) : cos(pi * x[d]);
+                    df[d] = Dirichlet ? pi * cos(pi * x[d]) : -pi * sin(pi * x[d]);
+                }
+
+                view_exact(i, j, k) = f[0] * f[1] * f[2];
+                view(i, j, k)       = 3 * pi * pi * view_exact(i, j, k);
+
+                Eview_exact(i, j, k)[0] = -df[0] * f[1] * f[2];
+                Eview_exact(i, j, k)[1] = -f[0] * df[1] * f[2];
+                Eview_exact(i, j, k)[2] = -f[0] * f[1] * df[2];
+            });
+
+        ippl::ParameterList params;
+        params.add("output_type", Solver::SOL_AND_GRAD);
+        params.add("use_heffte_defaults", false);
+        params.add("use_pencils", true);
+        params.add("use_gpu_aware", true);
+        params.add("comm", ippl::a2av);
+
+        Solver solver(E, rho, params);
+        solver.solve();
+
+        // relative error of the potential
+        rho             = rho - phi_exact;
+        rho             = pow(rho, 2);
+        phi_exact       = pow(phi_exact, 2);
+        double errorPhi = Kokkos::sqrt(rho.sum() / phi_exact.sum());
+
+        // relative error of the electric field
+        auto Eview     = E.getView();
+        double localNr = 0, localDr = 0;
+        Kokkos::parallel_reduce(
+            "Error reduce", E.getFieldRangePolicy(),
+            KOKKOS_LAMBDA(const int i, const int j, const int k, double& nr, double& dr) {
+                for (unsigned d = 0; d < dim; ++d) {
+                    const double diff = Eview(i, j, k)[d] - Eview_exact(i, j, k)[d];
+                    nr += diff * diff;
+                    dr += Eview_exact(i, j, k)[d] * Eview_exact(i, j, k)[d];
+                }
+            },
+            Kokkos::Sum<double>(localNr), Kokkos::Sum<double>(localDr));
+
+        double errorNr = 0, errorDr = 0;
+        MPI_Allreduce(&localNr, &errorNr, 1, MPI_DOUBLE, MPI_SUM, ippl::Comm->getCommunicator());
+        MPI_Allreduce(&localDr, &errorDr, 1, MPI_DOUBLE, MPI_SUM, ippl::Comm->getCommunicator());
+
+        if (ippl::Comm->rank() == 0) {
+            std::cout << name << " " << pt << " " << errorPhi << " "
+                      << Kokkos::sqrt(errorNr / errorDr) << std::endl;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    ippl::initialize(argc, argv);
+    {
+        test<ippl::FFTDirichletPoissonSolver<VField_t, Field_t>, true>("Dirichlet");
+        test<ippl::FFTNeumannPoissonSolver<VField_t, Field_t>, false>("Neumann");
+    }
+    ippl::finalize();
+
+    return 0;
+}
@@ -0,0 +1,230 @@
+//
+// TestGaussian2D
+// This program tests the FFTPoissonSolver class in 2D with a Gaussian source.
+// The electric field is compared to the exact field of the Gaussian.
+//   Usage:
+//     srun ./TestGaussian2D
+//                  <nx> <ny> <reshape> <comm>
+//                  <reorder> <algorithm> --info 5
+//     nx        = No. cell-centered points in the x-direction
+//     ny        = No. cell-centered points in the y-direction
+//     reshape   = "pencils" or "slabs" (heffte parameter)
+//     comm      = "a2a", "a2av", "p2p", "p2p_pl" (heffte parameter)
+//     reorder   = "reorder" or "no-reorder" (heffte parameter)
+//     algorithm = "HOCKNEY" or "VICO", types of open BC algorithms
+//
+//     For more info on the heffte parameters, see:
+//     https://github.com/icl-utk-edu/heffte
+//
+//     Example:
+//       srun ./TestGaussian2D 128 128 pencils a2a no-reorder HOCKNEY --info 5
+//
+//
+
+#include "Ippl.h"
+
+#include <Kokkos_MathematicalConstants.hpp>
+#include <Kokkos_MathematicalFunctions.hpp>
+#include <cstdlib>
+
+#include "Utility/IpplException.h"
+#include "Utility/IpplTimings.h"
+
+#include "Solver/FFTPoissonSolver.h"
+
+KOKKOS_INLINE_FUNCTION double gaussian(double x, double y, double sigma = 0.05,
+                                       double mu = 0.5) {
+    double pi        = Kokkos::numbers::pi_v<double>;
+    double prefactor = 1 / (2 * pi * sigma * sigma);
+    double r2        = (x - mu) * (x - mu) + (y - mu) * (y - mu);
+
+    return prefactor * exp(-r2 / (2 * sigma * sigma));
+}
+
+KOKKOS_INLINE_FUNCTION ippl::Vector<double, 2> exact_E(double x, double y, double sigma = 0.05,
+                                                       double mu = 0.5) {
+    double pi     = Kokkos::numbers::pi_v<double>;
+    double r2     = (x - mu) * (x - mu) + (y - mu) * (y - mu);
+    double factor = (1.0 / (2.0 * pi * r2)) * (1.0 - exp(-r2 / (2 * sigma * sigma)));
+
+    ippl::Vector<double, 2> Efield = {(x - mu), (y - mu)};
+    return factor * Efield;
+}
+
+int main(int argc, char* argv[]) {
+    ippl::initialize(argc, argv);
+    {
+        Inform msg(argv[0]);
+
+        const unsigned int Dim = 2;
+
+        using Mesh_t      = ippl::UniformCartesian<double, Dim>;
+        using Centering_t = Mesh_t::DefaultCentering;
+        typedef ippl::Field<double, Dim, Mesh_t, Centering_t> field;
+        typedef ippl::Field<ippl::Vector<double, Dim>, Dim, Mesh_t, Centering_t> fieldV;
+        using Solver_t = ippl::FFTPoissonSolver<fieldV, field>;
+
+        // start a timer
+        static IpplTimings::TimerRef allTimer = IpplTimings::getTimer("allTimer");
+        IpplTimings::startTimer(allTimer);
+
+        // get the gridsize from the user
+        ippl::Vector<int, Dim> nr = {std::atoi(argv[1]), std::atoi(argv[2])};
+
+        // get heffte parameters from the user
+        std::string reshape       = argv[3];  // slabs or pencils
+        std::string communication = argv[4];  // a2a or p2p
+        std::string reordering    = argv[5];  // reorder or no-reorder
+
+        // get the algorithm to be used
+        std::string algorithm = argv[6];  // Hockney or Vico
+
+        msg << "Test Gaussian 2D, grid = " << nr << ", heffte params: " << reshape << " "
+            << communication << " " << reordering << ", algorithm = " << algorithm << endl;
+        msg << "Spacing ErrorEx ErrorEy" << endl;
+
+        // domain
+        ippl::NDIndex<Dim> owned;
+        for (unsigned i = 0; i < Dim; i++) {
+            owned[i] = ippl::Index(nr[i]);
+        }
+
+        // specifies decomposition; here all dimensions are parallel
+        ippl::e_dim_tag decomp[Dim];
+        for (unsigned int d = 0; d < Dim; d++) {
+            decomp[d] = ippl::PARALLEL;
+        }
+
+        // unit box
+        double dx                        = 1.0 / nr[0];
+        double dy                        = 1.0 / nr[1];
+        ippl::Vector<double, Dim> hr     = {dx, dy};
+        ippl::Vector<double, Dim> origin = {0.0, 0.0};
+        Mesh_t mesh(owned, hr, origin);
+
+        // all parallel layout, standard domain, normal axis order
+        ippl::FieldLayout<Dim> layout(owned, decomp);
+
+        field rho;
+        rho.initialize(mesh, layout);
+
+        fieldV exactE, fieldE;
+        exactE.initialize(mesh, layout);
+        fieldE.initialize(mesh, layout);
+
+        // assign the rho field with a gaussian and the exact E field
+        auto view_rho    = rho.getView();
+        auto view_exactE = exactE.getView();
+        const int nghost = rho.getNghost();
+        const auto& ldom = layout.getLocalNDIndex();
+
+        Kokkos::parallel_for(
+            "Assign rho and exact E-field", rho.getFieldRangePolicy(),
+            KOKKOS_LAMBDA(const int i, const int j) {
+                // go from local to global indices
+                const int ig = i + ldom[0].first() - nghost;
+                const int jg = j + ldom[1].first() - nghost;
+
+                // define the physical points (cell-centered)
+                double x = (ig + 0.5) * hr[0] + origin[0];
+                double y = (jg + 0.5) * hr[1] + origin[1];
+
+                view_rho(i, j)    = gaussian(x, y);
+                view_exactE(i, j) = exact_E(x, y);
+            });
+
+        // Parameter List to pass to solver
+        ippl::ParameterList params;
+
+        // set the FFT parameters
+        if (reshape == "pencils") {
+            params.add("use_pencils", true);
+        } else if (reshape == "slabs") {
+            params.add("use_pencils", false);
+        } else {
+            throw IpplException("TestGaussian2D.cpp main()", "Unrecognized heffte parameter");
+        }
+
+        if (communication == "a2a") {
+            params.add("comm", ippl::a2a);
+        } else if (communication == "a2av") {
+            params.add("comm", ippl::a2av);
+        } else if (communication == "p2p") {
+            params.add("comm", ippl::p2p);
+        } else if (communication == "p2p_pl") {
+            params.add("comm", ippl::p2p_pl);
+        } else {
+            throw IpplException("TestGaussian2D.cpp main()", "Unrecognized heffte parameter");
+        }
+
+        if (reordering == "reorder") {
+            params.add("use_reorder", true);
+        } else if (reordering == "no-reorder") {
+            params.add("use_reorder", false);
+        } else {
+            throw IpplException("TestGaussian2D.cpp main()", "Unrecognized heffte parameter");
+        }
+        params.add("use_heffte_defaults", false);
+        params.add("use_gpu_aware", true);
+        params.add("r2c_direction", 0);
+
+        // set the algorithm
+        if (algorithm == "HOCKNEY") {
+            params.add("algorithm", Solver_t::HOCKNEY);
+        } else if (algorithm == "VICO") {
+            params.add("algorithm", Solver_t::VICO);
+        } else {
+            throw IpplException("TestGaussian2D.cpp main()", "Unrecognized algorithm type");
+        }
+
+        params.add("output_type", Solver_t::GRAD);
+
+        Solver_t FFTsolver(fieldE, rho, params);
+        FFTsolver.solve();
+
+        // compute relative error norm for the E-field components
+        ippl::Vector<double, Dim> errE{0.0, 0.0};
+        fieldE = fieldE - exactE;
+
+        auto Eview = fieldE.getView();
+
+        for (size_t d = 0; d < Dim; ++d) {
+            double temp = 0.0;
+            Kokkos::parallel_reduce(
+                "Vector errorNr reduce", fieldE.getFieldRangePolicy(),
+                KOKKOS_LAMBDA(const size_t i, const size_t j, double& valL) {
+                    valL += Kokkos::pow(Eview(i, j)[d], 2);
+                },
+                Kokkos::Sum<double>(temp));
+
+            double globaltemp = 0.0;
+            MPI_Allreduce(&temp, &globaltemp, 1, MPI_DOUBLE, MPI_SUM,
+                          ippl::Comm->getCommunicator());
+            double errorNr = std::sqrt(globaltemp);
+
+            temp = 0.0;
+            Kokkos::parallel_reduce(
+                "Vector errorDr reduce", exactE.getFieldRangePolicy(),
+                KOKKOS_LAMBDA(const size_t i, const size_t j, double& valL) {
+                    valL += Kokkos::pow(view_exactE(i, j)[d], 2);
+                },
+                Kokkos::Sum<double>(temp));
+
+            globaltemp = 0.0;
+            MPI_Allreduce(&temp, &globaltemp, 1, MPI_DOUBLE, MPI_SUM,
+                          ippl::Comm->getCommunicator());
+            double errorDr = std::sqrt(globaltemp);
+
+            errE[d] = errorNr / errorDr;
+        }
+
+        msg << std::setprecision(16) << dx << " " << errE[0] << " " << errE[1] << endl;
+
+        // stop the timers
+        IpplTimings::stopTimer(allTimer);
+        IpplTimings::print(std::string("timing.dat"));
+    }
+    ippl::finalize();
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+// Tests the multigrid solver for electrostatics problems with homogeneous
+// Dirichlet boundary conditions by checking the relative error from the
+// exact solution
+// Usage:
+//      TestMGSolver [size [smoother]]
+//      where size is the log2 of the number of cells per dimension
+//      and smoother is 'jacobi' (default) or 'chebyshev'
+
+#include "Ippl.h"
+
+#include <Kokkos_MathematicalConstants.hpp>
+#include <Kokkos_MathematicalFunctions.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "Utility/Inform.h"
+#include "Utility/IpplTimings.h"
+
+#include "Solver/ElectrostaticsMG.h"
+
+int main(int argc, char* argv[]) {
+    ippl::initialize(argc, argv);
+    {
+        constexpr unsigned int dim = 3;
+        using Mesh_t               = ippl::UniformCartesian<double, 3>;
+        using Centering_t          = Mesh_t::DefaultCentering;
+
+        typedef ippl::Field<double, dim, Mesh_t, Centering_t> field_type;
+        typedef ippl::ElectrostaticsMG<field_type> solver_type;
+
+        int pt       = 32;
+        int smoother = solver_type::algo::JACOBI;
+
+        Inform info("Config");
+        if (argc >= 2) {
+            // First argument is the problem size (log2)
+            int N = strtol(argv[1], NULL, 10);
+            info << "Got " << N << " as size parameter" << endl;
+            pt = 1 << N;
+        }
+        if (argc >= 3 && std::string(argv[2]) == "chebyshev") {
+            info << "Using Chebyshev smoother" << endl;
+            smoother = solver_type::algo::CHEBYSHEV;
+        }
+
+        ippl::Index I(pt);
+        ippl::NDIndex<dim> owned(I, I, I);
+
+        ippl::e_dim_tag allParallel[dim];  // Specifies SERIAL, PARALLEL dims
+        for (unsigned int d = 0; d < dim; d++) {
+            allParallel[d] = ippl::PARALLEL;
+        }
+
+        ippl::FieldLayout<dim> layout(owned, allParallel);
+
+        // Unit box
+        double dx                        = 1.0 / double(pt);
+        ippl::Vector<double, dim> hx     = dx;
+        ippl::Vector<double, dim> origin = 0;
+        Mesh_t mesh(owned, hx, origin);
+
+        double pi = Kokkos::numbers::pi_v<double>;
+
+        field_type rhs(mesh, layout), lhs(mesh, layout), solution(mesh, layout);
+
+        typedef ippl::BConds<field_type, dim> bc_type;
+
+        bc_type bcField;
+        for (unsigned int i = 0; i < 2 * dim; ++i) {
+            bcField[i] = std::make_shared<ippl::ZeroFace<field_type>>(i);
+        }
+        lhs.setFieldBC(bcField);
+
+        typename field_type::view_type &viewRHS = rhs.getView(), viewSol = solution.getView();
+
+        const ippl::NDIndex<dim>& lDom = layout.getLocalNDIndex();
+
+        using Kokkos::sin;
+
+        const int shift = solution.getNghost();
+        Kokkos::parallel_for(
+            "Assign solution and rhs", solution.getFieldRangePolicy(),
+            KOKKOS_LAMBDA(const int i, const int j, const int k) {
+                const size_t ig = i + lDom[0].first() - shift;
+                const size_t jg = j + lDom[1].first() - shift;
+                const size_t kg = k + lDom[2].first() - shift;
+                double x        = (ig + 0.5) * hx[0];
+                double y        = (jg + 0.5) * hx[1];
+                double z        = (kg + 0.5) * hx[2];
+
+                viewSol(i, j, k) = sin(pi * x) * sin(pi * y) * sin(pi * z);
+                viewRHS(i, j, k) = 3 * pi * pi * viewSol(i, j, k);
+            });
+
+        solver_type solver;
+
+        ippl::ParameterList params;
+        params.add("smoother", smoother);
+        params.add("tolerance", 1e-10);
+        solver.mergeParameters(params);
+
+        solver.setRhs(rhs);
+        solver.setLhs(lhs);
+
+        lhs = 0;
+        solver.solve();
+
+        Inform m("Convergence");
+
+        field_type error(mesh, layout);
+        // Solver solution - analytical solution
+        error           = lhs - solution;
+        double relError = norm(error) / norm(solution);
+
+        // Laplace(solver solution) - rhs
+        error          = -laplace(lhs) - rhs;
+        double residue = norm(error) / norm(rhs);
+
+        m << pt << "," << solver.getLevelCount() << "," << std::setprecision(16) << relError << ","
+          << residue << "," << solver.getIterationCount() << endl;
+
+        IpplTimings::print("timings" + std::to_string(pt) + ".dat");
+    }
+    ippl::finalize();
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+// This program tests the FFTMixedPoissonSolver with a Gaussian line charge that is
+// uniform along the periodic z-axis, for which the electric field is known:
+//     E_r = (1 - exp(-r^2 / (2 sigma^2))) / (2 pi r)
+// The relative L2 error of the transverse field components and the RMS of the
+// longitudinal component are printed for a sequence of grid sizes.
+//   Usage:
+//     srun ./TestMixedPoissonSolver --info 5
+
+#include "Ippl.h"
+
+#include <Kokkos_MathematicalConstants.hpp>
+#include <Kokkos_MathematicalFunctions.hpp>
+#include <iostream>
+
+#include "Solver/FFTMixedPoissonSolver.h"
+
+int main(int argc, char* argv[]) {
+    ippl::initialize(argc, argv);
+    {
+        constexpr unsigned int dim = 3;
+        using Mesh_t               = ippl::UniformCartesian<double, dim>;
+        using Centering_t          = Mesh_t::DefaultCentering;
+
+        typedef ippl::Field<double, dim, Mesh_t, Centering_t> Field_t;
+        typedef ippl::Vector<double, dim> Vector_t;
+        typedef ippl::Field<Vector_t, dim, Mesh_t, Centering_t> VField_t;
+        typedef ippl::FFTMixedPoissonSolver<VField_t, Field_t> Solver_t;
+
+        const double pi    = Kokkos::numbers::pi_v<double>;
+        const double sigma = 0.1;
+
+        for (int pt : {16, 32, 64, 128}) {
+            ippl::Index I(pt);
+            ippl::NDIndex<dim> owned(I, I, I);
+
+            ippl::e_dim_tag decomp[dim];
+            for (unsigned int d = 0; d < dim; d++) {
+                decomp[d] = ippl::PARALLEL;
+            }
+
+            ippl::FieldLayout<dim> layout(owned, decomp);
+
+            // [-1, 1]^3 box, periodic in z
+            double dx                        = 2.0 / double(pt);
+            ippl::Vector<double, dim> hx     = {dx, dx, dx};
+            ippl::Vector<double, dim> origin = {-1.0, -1.0, -1.0};
+            Mesh_t mesh(owned, hx, origin);
+
+            Field_t rho(mesh, layout);
+            VField_t E(mesh, layout);
+            VField_t E_exact(mesh, layout);
+
+            const ippl::NDIndex<dim>& lDom = layout.getLocalNDIndex();
+            const int nghost               = rho.getNghost();
+            auto view                      = rho.getView();
+            auto view_exact                = E_exact.getView();
+
+            Kokkos::parallel_for(
+                "Assign rhs", rho.getFieldRangePolicy(),
+                KOKKOS_LAMBDA(const int i, const int j, const int k) {
+                    const int ig = i + lDom[0].first() - nghost;
+                    const int jg = j + lDom[1].first() - nghost;
+
+                    const double x  = origin[0] + (ig + 0.5) * hx[0];
+                    const double y  = origin[1] + (jg + 0.5) * hx[1];
+                    const double r2 = x * x + y * y;
+
+                    const double gauss = Kokkos::exp(-r2 / (2 * sigma * sigma));
+                    view(i, j, k)      = gauss / (2 * pi * sigma * sigma);
+
+                    const double factor    = (1 - gauss) / (2 * pi * r2);
+                    view_exact(i, j, k)[0] = factor * x;
+                    view_exact(i, j, k)[1] = factor * y;
+                    view_exact(i, j, k)[2] = 0;
+                });
+
+            ippl::ParameterList params;
+            params.add("output_type", Solver_t::GRAD);
+            params.add("use_heffte_defaults", false);
+            params.add("use_pencils", true);
+            params.add("use_gpu_aware", true);
+            params.add("comm", ippl::a2av);
+            params.add("r2c_direction", 0);
+            params.add("periodic_dims", 0b100);
+
+            Solver_t solver(E, rho, params);
+            solver.solve();
+
+            auto Eview = E.getView();
+            ippl::Vector<double, dim> errorNr, errorDr;
+            for (unsigned d = 0; d < dim; ++d) {
+                double localNr = 0, localDr = 0;
+                Kokkos::parallel_reduce(
+                    "Error reduce", E.getFieldRangePolicy(),
+                    KOKKOS_LAMBDA(const int i, const int j, const int k, double& nr, double& dr) {
+                        const double diff = Eview(i, j, k)[d] - view_exact(i, j, k)[d];
+                        nr += diff * diff;
+                        dr += view_exact(i, j, k)[d] * view_exact(i, j, k)[d];
+                    },
+                    Kokkos::Sum<double>(localNr), Kokkos::Sum<double>(localDr));
+                MPI_Allreduce(&localNr, &errorNr[d], 1, MPI_DOUBLE, MPI_SUM,
+                              ippl::Comm->getCommunicator());
+                MPI_Allreduce(&localDr, &errorDr[d], 1, MPI_DOUBLE, MPI_SUM,
+                              ippl::Comm->getCommunicator());
+            }
+
+            if (ippl::Comm->rank() == 0) {
+                std::cout << pt << " " << std::sqrt(errorNr[0] / errorDr[0]) << " "
+                          << std::sqrt(errorNr[1] / errorDr[1]) << " "
+                          << std::sqrt(errorNr[2] / (pt * pt * pt)) << std::endl;
+            }
+        }
+    }
+    ippl::finalize();
+
+    return 0;
+}
@@ -0,0 +1,239 @@
+//
+// Unit test Convolution
+//   Test FFT-based convolutions of fields
+//
+#include "Ippl.h"
+
+#include <Kokkos_MathematicalConstants.hpp>
+
+#include "FFT/Convolution.h"
+#include "TestUtils.h"
+#include "gtest/gtest.h"
+
+template <typename>
+class ConvolutionTest;
+
+// Restrict testing to 2 and 3 dimensions since this is what heFFTe supports
+template <typename T, typename ExecSpace, unsigned Dim>
+class ConvolutionTest<Parameters<T, ExecSpace, Rank<Dim>>> : public ::testing::Test {
+protected:
+    void SetUp() override { CHECK_SKIP_SERIAL; }
+
+public:
+    using value_type              = T;
+    using exec_space              = ExecSpace;
+    constexpr static unsigned dim = Dim;
+
+    using mesh_type        = ippl::UniformCartesian<T, Dim>;
+    using centering_type   = typename mesh_type::DefaultCentering;
+    using field_type       = ippl::Field<T, Dim, mesh_type, centering_type, ExecSpace>;
+    using layout_type      = ippl::FieldLayout<Dim>;
+    using convolution_type = ippl::Convolution<field_type>;
+    using vector_type      = typename convolution_type::vector_type;
+
+    ConvolutionTest()
+        : pt(getGridSizes<Dim>()) {
+        CHECK_SKIP_SERIAL_CONSTRUCTOR;
+
+        std::array<ippl::Index, Dim> domains;
+
+        ippl::Vector<T, Dim> hx;
+        ippl::Vector<T, Dim> origin;
+
+        ippl::e_dim_tag domDec[Dim];  // Specifies SERIAL, PARALLEL dims
+        for (unsigned d = 0; d < Dim; d++) {
+            domDec[d]  = ippl::PARALLEL;
+            domains[d] = ippl::Index(pt[d]);
+            hx[d]      = 1;
+            origin[d]  = 0;
+        }
+
+        auto owned = std::make_from_tuple<ippl::NDIndex<Dim>>(domains);
+        layout     = layout_type(owned, domDec);
+
+        mesh = mesh_type(owned, hx, origin);
+
+        in  = std::make_shared<field_type>(mesh, layout);
+        out = std::make_shared<field_type>(mesh, layout);
+    }
+
+    /*!
+     * Gets the convolution parameters
+     * @param boundary the boundary type of the convolution
+     */
+    [[nodiscard]] ippl::ParameterList getParams(int boundary) const {
+        ippl::ParameterList params;
+        params.add("boundary", boundary);
+        params.add("use_heffte_defaults", true);
+        params.add("r2c_direction", 0);
+        return params;
+    }
+
+    /*!
+     * Fills a field with the values of a function of the global cell index
+     * @param field the field
+     * @param f the function
+     */
+    template <typename Function>
+    void fill(field_type& field, Function&& f) {
+        auto mirror      = field.getHostMirror();
+        const int nghost = field.getNghost();
+        const auto& ldom = field.getLayout().getLocalNDIndex();
+
+        nestedViewLoop(mirror, nghost, [&]<typename... Idx>(const Idx... args) {
+            std::array<int, Dim> ig{static_cast<int>(args)...};
+            for (unsigned d = 0; d < Dim; d++) {
+                ig[d] += ldom[d].first() - nghost;
+            }
+            mirror(args...) = f(ig);
+        });
+        Kokkos::deep_copy(field.getView(), mirror);
+    }
+
+    /*!
+     * Compares a field with a function of the global cell index
+     * @param field the field
+     * @param f the expected values
+     */
+    template <typename Function>
+    void verify(field_type& field, Function&& f) {
+        T tol = (std::is_same_v<T, double>) ? 1e-10 : 1e-3;
+
+        auto result      = field.getHostMirror();
+        const int nghost = field.getNghost();
+        const auto& ldom = field.getLayout().getLocalNDIndex();
+        Kokkos::deep_copy(result, field.getView());
+
+        nestedViewLoop(result, nghost, [&]<typename... Idx>(const Idx... args) {
+            std::array<int, Dim> ig{static_cast<int>(args)...};
+            for (unsigned d = 0; d < Dim; d++) {
+                ig[d] += ldom[d].first() - nghost;
+            }
+            ASSERT_NEAR(result(args...), f(ig), tol);
+        });
+    }
+
+    // a smooth periodic function in the first dimension plus a ramp in the second
+    T periodicRamp(const std::array<int, Dim>& ig) const {
+        const T pi = Kokkos::numbers::pi_v<T>;
+        return Kokkos::sin(2 * pi * ig[0] / pt[0]) + ig[1];
+    }
+
+    mesh_type mesh;
+    layout_type layout;
+    std::shared_ptr<field_type> in;
+    std::shared_ptr<field_type> out;
+
+    std::array<size_t, Dim> pt;
+};
+
+using Tests = TestParams::tests<2, 3>;
+TYPED_TEST_CASE(ConvolutionTest, Tests);
+
+TYPED_TEST(ConvolutionTest, PeriodicShift) {
+    using T                = typename TestFixture::value_type;
+    using vector_type      = typename TestFixture::vector_type;
+    using convolution_type = typename TestFixture::convolution_type;
+
+    constexpr unsigned Dim = TestFixture::dim;
+
+    convolution_type conv(this->layout, this->mesh, this->getParams(convolution_type::PERIODIC));
+
+    // the kernel is 1 at the displacement of one cell in the first dimension, so the
+    // convolution shifts the field by one cell
+    conv.setKernel(KOKKOS_LAMBDA(const vector_type& x) {
+        bool shift = Kokkos::abs(x[0] - 1) < 0.5;
+        for (unsigned d = 1; d < Dim; d++) {
+            shift = shift && Kokkos::abs(x[d]) < 0.5;
+        }
+        return T(shift);
+    });
+
+    this->fill(*this->in, [&](const std::array<int, Dim>& ig) {
+        return this->periodicRamp(ig);
+    });
+
+    conv.convolve(*this->in, *this->out);
+
+    // the field wraps around in the periodic dimension
+    const int n = this->pt[0];
+    this->verify(*this->out, [&](std::array<int, Dim> ig) {
+        ig[0] = (ig[0] + n - 1) % n;
+        return this->periodicRamp(ig);
+    });
+}
+
+TYPED_TEST(ConvolutionTest, PeriodicFieldKernel) {
+    using T                = typename TestFixture::value_type;
+    using field_type       = typename TestFixture::field_type;
+    using convolution_type = typename TestFixture::convolution_type;
+
+    constexpr unsigned Dim = TestFixture::dim;
+
+    convolution_type conv(this->layout, this->mesh, this->getParams(convolution_type::PERIODIC));
+
+    // a unit impulse at the origin leaves the field unchanged
+    field_type kernel(conv.getKernelMesh(), conv.getKernelLayout());
+    this->fill(kernel, [](const std::array<int, Dim>& ig) {
+        bool origin = true;
+        for (unsigned d = 0; d < Dim; d++) {
+            origin = origin && ig[d] == 0;
+        }
+        return T(origin);
+    });
+    conv.setKernel(kernel);
+
+    this->fill(*this->in, [&](const std::array<int, Dim>& ig) {
+        return this->periodicRamp(ig);
+    });
+
+    // in place
+    conv.convolve(*this->in);
+
+    this->verify(*this->in, [&](const std::array<int, Dim>& ig) {
+        return this->periodicRamp(ig);
+    });
+}
+
+TYPED_TEST(ConvolutionTest, ZeroPadded) {
+    using T                = typename TestFixture::value_type;
+    using vector_type      = typename TestFixture::vector_type;
+    using convolution_type = typename TestFixture::convolution_type;
+
+    constexpr unsigned Dim = TestFixture::dim;
+
+    convolution_type conv(this->layout, this->mesh,
+                          this->getParams(convolution_type::ZERO_PADDED));
+
+    // the kernel adds the left neighbour in the first dimension to each cell
+    conv.setKernel(KOKKOS_LAMBDA(const vector_type& x) {
+        bool inside = Kokkos::abs(x[0]) < 0.5 || Kokkos::abs(x[0] - 1) < 0.5;
+        for (unsigned d = 1; d < Dim; d++) {
+            inside = inside && Kokkos::abs(x[d]) < 0.5;
+        }
+        return T(inside);
+    });
+
+    this->fill(*this->in, [](const std::array<int, Dim>&) {
+        return T(1);
+    });
+
+    conv.convolve(*this->in, *this->out);
+
+    // the first cell has no left neighbour, as the field is not periodic
+    this->verify(*this->out, [](const std::array<int, Dim>& ig) {
+        return T(ig[0] == 0 ? 1 : 2);
+    });
+}
+
+int main(int argc, char* argv[]) {
+    int success = 1;
+    TestParams::checkArgs(argc, argv);
+    ippl::initialize(argc, argv);
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        success = RUN_ALL_TESTS();
+    }
+    ippl::finalize();
+    return success;
+}
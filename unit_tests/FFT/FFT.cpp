@@ -171,6 +171,50 @@ public:
         verifyResult(nghost, field_result, field_host);
     }
 
+    /*!
+     * Tests the real-to-complex FFT
+     * @param field a pointer to the real field
+     * @param nghostOutput number of ghost cells of the complex field
+     */
+    void testRC(std::shared_ptr<field_type_real>& field, int nghostOutput) {
+        ippl::ParameterList fftParams;
+        fftParams.add("use_heffte_defaults", true);
+        fftParams.add("r2c_direction", 0);
+
+        ippl::NDIndex<Dim> ownedOutput;
+        ippl::e_dim_tag allParallel[Dim];
+        for (unsigned d = 0; d < Dim; d++) {
+            allParallel[d] = ippl::PARALLEL;
+            if (static_cast<int>(d) == fftParams.get<int>("r2c_direction")) {
+                ownedOutput[d] = ippl::Index(pt[d] / 2 + 1);
+            } else {
+                ownedOutput[d] = ippl::Index(pt[d]);
+            }
+        }
+
+        layout_type layoutOutput(ownedOutput, allParallel);
+
+        mesh_type meshOutput(ownedOutput, mesh.getMeshSpacing(), mesh.getOrigin());
+        field_type_complex fieldOutput(meshOutput, layoutOutput, nghostOutput);
+
+        auto fft = std::make_unique<FFT_type<ippl::RCTransform>>(layout, layoutOutput, fftParams);
+
+        auto& view      = field->getView();
+        auto input_host = field->getHostMirror();
+
+        const int nghost = field->getNghost();
+        randomizeRealField(nghost, input_host);
+
+        Kokkos::deep_copy(view, input_host);
+
+        fft->transform(ippl::FORWARD, *field, fieldOutput);
+        fft->transform(ippl::BACKWARD, *field, fieldOutput);
+
+        auto field_result = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), view);
+
+        verifyResult(nghost, field_result, input_host);
+    }
+
     mesh_type mesh;
     layout_type layout;
     std::shared_ptr<field_type_real> realField;
@@ -191,12 +235,29 @@ TYPED_TEST(FFTTest, Sin) {
     this->template testTrig<ippl::SineTransform>(this->realField, this->layout);
 }
 
+TYPED_TEST(FFTTest, SinNoGhosts) {
+    // fields without ghost cells are transformed without a temporary copy
+    auto field =
+        std::make_shared<typename TestFixture::field_type_real>(this->mesh, this->layout, 0);
+    this->template testTrig<ippl::SineTransform>(field, this->layout);
+}
+
 TYPED_TEST(FFTTest, RC) {
-    constexpr unsigned Dim = TestFixture::dim;
+    this->testRC(this->realField, 1);
+}
 
-    auto& mesh   = this->mesh;
-    auto& layout = this->layout;
-    auto& field  = this->realField;
+TYPED_TEST(FFTTest, RCNoGhosts) {
+    auto field =
+        std::make_shared<typename TestFixture::field_type_real>(this->mesh, this->layout, 0);
+    this->testRC(field, 0);
+}
+
+TYPED_TEST(FFTTest, RCBatchedFields) {
+    using T          = typename TestFixture::value_type;
+    using field_type = typename TestFixture::field_type_real;
+    using FFT_type   = typename TestFixture::template FFT_type<ippl::RCTransform>;
+
+    constexpr unsigned Dim = TestFixture::dim;
 
     ippl::ParameterList fftParams;
     fftParams.add("use_heffte_defaults", true);
@@ -206,37 +267,107 @@ TYPED_TEST(FFTTest, RC) {
     ippl::e_dim_tag allParallel[Dim];
     for (unsigned d = 0; d < Dim; d++) {
         allParallel[d] = ippl::PARALLEL;
-        if (static_cast<int>(d) == fftParams.get<int>("r2c_direction")) {
-            ownedOutput[d] = ippl::Index(this->pt[d] / 2 + 1);
-        } else {
-            ownedOutput[d] = ippl::Index(this->pt[d]);
-        }
+        ownedOutput[d] = ippl::Index(d == 0 ? this->pt[d] / 2 + 1 : this->pt[d]);
     }
 
     typename TestFixture::layout_type layoutOutput(ownedOutput, allParallel);
-
-    typename TestFixture::mesh_type meshOutput(ownedOutput, mesh.getMeshSpacing(),
-                                               mesh.getOrigin());
+    typename TestFixture::mesh_type meshOutput(ownedOutput, this->mesh.getMeshSpacing(),
+                                               this->mesh.getOrigin());
     typename TestFixture::field_type_complex fieldOutput(meshOutput, layoutOutput);
 
-    std::shared_ptr<typename TestFixture::template FFT_type<ippl::RCTransform>> fft =
-        std::make_unique<typename TestFixture::template FFT_type<ippl::RCTransform>>(
-            layout, layoutOutput, fftParams);
+    FFT_type fft(this->layout, layoutOutput, fftParams);
+
+    // the fields hold different multiples of the same random values
+    constexpr size_t batch = 3;
+    std::vector<field_type> fields;
+    fields.reserve(batch);
+    std::vector<field_type*> ptrs(batch);
+    std::vector<typename field_type::HostMirror> inputs(batch);
+    for (size_t b = 0; b < batch; ++b) {
+        fields.emplace_back(this->mesh, this->layout);
+        ptrs[b] = &fields[b];
+
+        const int nghost = fields[b].getNghost();
+        inputs[b]        = fields[b].getHostMirror();
+        this->randomizeRealField(nghost, inputs[b]);
+        nestedViewLoop(inputs[b], nghost, [&]<typename... Idx>(const Idx... args) {
+            inputs[b](args...) *= T(b + 1);
+        });
+        Kokkos::deep_copy(fields[b].getView(), inputs[b]);
+    }
 
-    auto& view      = field->getView();
-    auto input_host = field->getHostMirror();
+    auto transforms = ippl::detail::batchedShrinkView<typename FFT_type::batch_view_type>(
+        "transforms", fieldOutput.getView(), fieldOutput.getNghost(), batch);
 
-    const int nghost = field->getNghost();
-    this->randomizeRealField(nghost, input_host);
+    fft.transform(ippl::FORWARD, ptrs, transforms);
+    fft.transform(ippl::BACKWARD, ptrs, transforms);
+
+    for (size_t b = 0; b < batch; ++b) {
+        auto result =
+            Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), fields[b].getView());
+        this->verifyResult(fields[b].getNghost(), result, inputs[b]);
+    }
+}
 
-    Kokkos::deep_copy(view, input_host);
+TYPED_TEST(FFTTest, RCPruned) {
+    using T          = typename TestFixture::value_type;
+    using field_type = typename TestFixture::field_type_real;
+    using FFT_type   = typename TestFixture::template FFT_type<ippl::RCTransform>;
 
-    fft->transform(ippl::FORWARD, *field, fieldOutput);
-    fft->transform(ippl::BACKWARD, *field, fieldOutput);
+    constexpr unsigned Dim = TestFixture::dim;
+    T tol                  = (std::is_same_v<T, double>) ? 1e-13 : 1e-5;
 
-    auto field_result = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), view);
+    ippl::ParameterList fftParams;
+    fftParams.add("use_heffte_defaults", true);
+    fftParams.add("r2c_direction", 0);
+
+    ippl::NDIndex<Dim> ownedOutput, region;
+    ippl::e_dim_tag allParallel[Dim];
+    for (unsigned d = 0; d < Dim; d++) {
+        allParallel[d] = ippl::PARALLEL;
+        ownedOutput[d] = ippl::Index(d == 0 ? this->pt[d] / 2 + 1 : this->pt[d]);
+        region[d]      = ippl::Index(this->pt[d] / 2);
+    }
 
-    this->verifyResult(nghost, field_result, input_host);
+    typename TestFixture::layout_type layoutOutput(ownedOutput, allParallel);
+    typename TestFixture::mesh_type meshOutput(ownedOutput, this->mesh.getMeshSpacing(),
+                                               this->mesh.getOrigin());
+    typename TestFixture::field_type_complex full(meshOutput, layoutOutput);
+    typename TestFixture::field_type_complex pruned(meshOutput, layoutOutput);
+
+    FFT_type fft(this->layout, layoutOutput, fftParams);
+
+    // the field is zero outside of the region, as on the doubled grid of the open solvers
+    field_type field(this->mesh, this->layout);
+    const int nghost = field.getNghost();
+    const auto& ldom = this->layout.getLocalNDIndex();
+    auto input       = field.getHostMirror();
+    this->randomizeRealField(nghost, input);
+    nestedViewLoop(input, nghost, [&]<typename... Idx>(const Idx... args) {
+        const std::array<size_t, Dim> idx{static_cast<size_t>(args)...};
+        for (unsigned d = 0; d < Dim; d++) {
+            const int ig = idx[d] - nghost + ldom[d].first();
+            if (ig < region[d].first() || ig > region[d].last()) {
+                input(args...) = 0;
+            }
+        }
+    });
+    Kokkos::deep_copy(field.getView(), input);
+
+    fft.transform(ippl::FORWARD, field, full);
+    fft.transform(ippl::FORWARD, field, pruned, region);
+
+    auto fullHost   = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), full.getView());
+    auto prunedHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), pruned.getView());
+    nestedViewLoop(fullHost, full.getNghost(), [&]<typename... Idx>(const Idx... args) {
+        ASSERT_NEAR(Kokkos::abs(fullHost(args...) - prunedHost(args...)), 0, tol);
+    });
+
+    field = 0;
+    fft.transform(ippl::BACKWARD, field, pruned, region);
+
+    auto result = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), field.getView());
+    this->verifyResult(nghost, result, input);
 }
 
 TYPED_TEST(FFTTest, CC) {
@@ -294,6 +425,21 @@ TYPED_TEST(FFTTest, CC) {
     ASSERT_NEAR(max_error.imag(), 0, tol);
 }
 
+TYPED_TEST(FFTTest, CachedPlan) {
+    using FFT_type = typename TestFixture::template FFT_type<ippl::SineTransform>;
+
+    auto params = this->getTrigParams();
+    FFT_type::plan_cache::clear();
+
+    // a second FFT with the same boxes and options reuses the plan of the first
+    auto first = std::make_unique<FFT_type>(this->layout, params);
+    ASSERT_EQ(FFT_type::plan_cache::size(), 1u);
+    first.reset();
+
+    this->template testTrig<ippl::SineTransform>(this->realField, this->layout);
+    ASSERT_EQ(FFT_type::plan_cache::size(), 1u);
+}
+
 int main(int argc, char* argv[]) {
     int success = 1;
     TestParams::checkArgs(argc, argv);
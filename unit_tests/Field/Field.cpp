@@ -215,6 +215,97 @@ TYPED_TEST(FieldTest, Norm2) {
     assertEqual<T>(std::sqrt(squared), norm2);
 }
 
+TYPED_TEST(FieldTest, Fused) {
+    using T = typename TestFixture::value_type;
+
+    T nCells = std::reduce(this->nPoints.begin(), this->nPoints.end(), T(1), std::multiplies<>{});
+
+    auto& field = this->field;
+    auto other  = field->deepCopy();
+
+    *field = 1.5;
+    other  = 2;
+
+    // the reductions see the values assigned earlier in the same kernel
+    auto [sum, dot] = ippl::fused(ippl::assign(*field, *field + other), ippl::assign(other, -other),
+                                  ippl::reduce(*field), ippl::reduce(*field * other));
+
+    assertEqual<T>(3.5 * nCells, sum);
+    assertEqual<T>(-7 * nCells, dot);
+    assertEqual<T>(3.5 * nCells, field->sum());
+    assertEqual<T>(-2 * nCells, other.sum());
+
+    ippl::fused(ippl::assign(other, *field - 1));
+    assertEqual<T>(2.5 * nCells, other.sum());
+}
+
+TYPED_TEST(FieldTest, ExpressionReductions) {
+    using T = typename TestFixture::value_type;
+
+    T nCells = std::reduce(this->nPoints.begin(), this->nPoints.end(), T(1), std::multiplies<>{});
+
+    auto& field = *this->field;
+
+    field = 1.5;
+
+    assertEqual<T>(4.5 * nCells, ippl::sum(2 * field * field, field));
+    assertEqual<T>(-0.5, ippl::max(field - 2, field));
+    assertEqual<T>(-3, ippl::min(-2 * field, field));
+    assertEqual<T>(1, ippl::prod(field / field, field));
+    assertEqual<T>(2.25 * nCells, ippl::innerProduct(field, field + 0, field));
+    assertEqual<T>(std::sqrt(2.25 * nCells), ippl::norm(field + 0, field));
+    assertEqual<T>(1.5, ippl::norm(-field, field, 0));
+}
+
+TYPED_TEST(FieldTest, FieldPool) {
+    using T                = typename TestFixture::value_type;
+    constexpr unsigned Dim = TestFixture::dim;
+    using pool_type        = ippl::FieldPool<typename TestFixture::field_type>;
+
+    T nCells = std::reduce(this->nPoints.begin(), this->nPoints.end(), T(1), std::multiplies<>{});
+
+    pool_type::clear();
+
+    const T* data = nullptr;
+    {
+        auto handle = pool_type::acquire(*this->mesh, *this->layout);
+        *handle     = 2;
+        data        = handle->getView().data();
+    }
+    ASSERT_EQ(pool_type::size(), 1u);
+
+    {
+        // the released field is reused and keeps its contents
+        auto first  = pool_type::acquire(*this->field);
+        auto second = pool_type::acquire(*this->mesh, *this->layout);
+        ASSERT_EQ(pool_type::size(), 0u);
+        ASSERT_EQ(first->getView().data(), data);
+        ASSERT_NE(second->getView().data(), data);
+        assertEqual<T>(2 * nCells, first->sum());
+
+        first.release();
+        ASSERT_FALSE(first.isActive());
+        ASSERT_EQ(pool_type::size(), 1u);
+    }
+    ASSERT_EQ(pool_type::size(), 2u);
+
+    // repartitioning the layout retires its idle fields
+    auto hostDomains = this->layout->getHostLocalDomains();
+    std::vector<ippl::NDIndex<Dim>> domains(hostDomains.extent(0));
+    for (size_t r = 0; r < domains.size(); ++r) {
+        domains[r] = hostDomains(r);
+    }
+    this->layout->updateLayout(domains);
+    {
+        auto handle = pool_type::acquire(*this->mesh, *this->layout);
+        ASSERT_EQ(pool_type::size(), 0u);
+    }
+    ASSERT_EQ(pool_type::size(), 1u);
+
+    pool_type::clear();
+    ASSERT_EQ(pool_type::size(), 0u);
+}
+
 TYPED_TEST(FieldTest, NormInf) {
     using T                = typename TestFixture::value_type;
     constexpr unsigned Dim = TestFixture::dim;
@@ -223,6 +223,129 @@ TYPED_TEST(HaloTest, AccumulateHalo) {
     });
 }
 
+TYPED_TEST(HaloTest, DeepHalo) {
+    constexpr unsigned Dim = TestFixture::dim;
+    using T                = typename TestFixture::value_type;
+    using field_type       = typename TestFixture::field_type;
+
+    const int nghost = 2;
+    field_type field(this->mesh, this->layout, nghost);
+
+    const auto& lDom = this->layout.getLocalNDIndex();
+    const auto& gDom = this->layout.getDomain();
+
+    // Each point stores the sum of its global indices, so that the
+    // received ghost values can be checked independently of the neighbor
+    auto globalValue = [&]<typename... Idx>(bool& inside, const Idx... args) {
+        std::array<long, Dim> local = {static_cast<long>(args)...};
+        T value                     = 0;
+        inside                      = true;
+        for (unsigned d = 0; d < Dim; d++) {
+            long global = lDom[d].first() + local[d] - nghost;
+            inside      = inside && global >= gDom[d].first() && global <= gDom[d].last();
+            value += global;
+        }
+        return value;
+    };
+
+    field = 0;
+    auto mirror = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), field.getView());
+    nestedViewLoop(mirror, nghost, [&]<typename... Idx>(const Idx... args) {
+        bool inside;
+        mirror(args...) = globalValue(inside, args...);
+    });
+    Kokkos::deep_copy(field.getView(), mirror);
+
+    field.fillHalo();
+    EXPECT_EQ(field.getValidGhostDepth(), nghost);
+
+    Kokkos::deep_copy(mirror, field.getView());
+    nestedViewLoop(mirror, 0, [&]<typename... Idx>(const Idx... args) {
+        bool inside;
+        T expected = globalValue(inside, args...);
+        if (inside) {
+            assertEqual<T>(mirror(args...), expected);
+        }
+    });
+
+    // In deep-halo mode, exchanges only happen once the valid depth is exhausted
+    field.setDeepHalo();
+    EXPECT_FALSE(field.refreshHalo(nghost));
+
+    field.assign(2 * field, nghost - 1);
+    EXPECT_EQ(field.getValidGhostDepth(), nghost - 1);
+    EXPECT_FALSE(field.refreshHalo(nghost - 1));
+    EXPECT_TRUE(field.refreshHalo(nghost));
+
+    field = field + 1;
+    EXPECT_EQ(field.getValidGhostDepth(), 0);
+    EXPECT_TRUE(field.refreshHalo());
+}
+
+TYPED_TEST(HaloTest, SkipRedundantFillHalo) {
+    auto& field = this->field;
+
+    IpplTimings::CounterRef performed = IpplTimings::getCounter("fillHalo performed");
+    IpplTimings::CounterRef skipped   = IpplTimings::getCounter("fillHalo skipped");
+
+    *field = 1;
+    EXPECT_EQ(field->getValidGhostDepth(), 0);
+
+    unsigned long nPerformed = IpplTimings::valueCounter(performed);
+    unsigned long nSkipped   = IpplTimings::valueCounter(skipped);
+
+    // fillHalo always exchanges, refreshHalo only if the halo is out of date
+    field->fillHalo();
+    field->fillHalo();
+    EXPECT_EQ(IpplTimings::valueCounter(performed), nPerformed + 2);
+    EXPECT_FALSE(field->refreshHalo());
+    EXPECT_EQ(IpplTimings::valueCounter(skipped), nSkipped + 1);
+
+    // read-only access keeps the halo valid
+    const auto& constField = *field;
+    constField.getView();
+    EXPECT_FALSE(field->refreshHalo());
+    EXPECT_EQ(IpplTimings::valueCounter(skipped), nSkipped + 2);
+
+    // mutable access through a copy invalidates the halo of the original
+    auto copy = *field;
+    copy.getView();
+    EXPECT_EQ(field->getValidGhostDepth(), 0);
+    EXPECT_TRUE(field->refreshHalo());
+    EXPECT_EQ(IpplTimings::valueCounter(performed), nPerformed + 3);
+    EXPECT_EQ(copy.getValidGhostDepth(), field->getNghost());
+
+    *field = *field + 1;
+    EXPECT_TRUE(field->refreshHalo());
+    EXPECT_EQ(IpplTimings::valueCounter(performed), nPerformed + 4);
+}
+
+TYPED_TEST(HaloTest, OperatorsSkipExchange) {
+    using field_type = typename TestFixture::field_type;
+
+    auto& field = this->field;
+    field_type result(this->mesh, this->layout);
+
+    IpplTimings::CounterRef performed = IpplTimings::getCounter("fillHalo performed");
+
+    *field                   = 1;
+    unsigned long nPerformed = IpplTimings::valueCounter(performed);
+
+    // the operand is unchanged between the operators, so its halo is exchanged once
+    result = laplace(*field);
+    result = laplace(*field);
+    EXPECT_EQ(IpplTimings::valueCounter(performed), nPerformed + 1);
+    EXPECT_TRUE(field->isBoundaryValid());
+
+    // an exchange by hand does not apply the boundary conditions
+    *field = 2;
+    field->fillHalo();
+    EXPECT_FALSE(field->isBoundaryValid());
+    result = laplace(*field);
+    EXPECT_EQ(IpplTimings::valueCounter(performed), nPerformed + 2);
+    EXPECT_TRUE(field->isBoundaryValid());
+}
+
 int main(int argc, char* argv[]) {
     int success = 1;
     TestParams::checkArgs(argc, argv);
@@ -0,0 +1,254 @@
+//
+// Unit test GreensFunctionCache
+//   Test the sharing, eviction and storage of the Green's functions of FFT-based solvers
+//
+#include "Ippl.h"
+
+#include <cstdio>
+#include <string>
+
+#include "Solver/FFTPoissonSolver.h"
+#include "TestUtils.h"
+#include "gtest/gtest.h"
+
+template <typename>
+class GreensFunctionCacheTest;
+
+// Restrict testing to 2 and 3 dimensions since this is what the solver supports
+template <typename T, typename ExecSpace, unsigned Dim>
+class GreensFunctionCacheTest<Parameters<T, ExecSpace, Rank<Dim>>> : public ::testing::Test {
+protected:
+    void SetUp() override {
+        CHECK_SKIP_SERIAL;
+        cache_type::clear();
+        cache_type::setCapacity(4);
+    }
+
+    void TearDown() override {
+        cache_type::clear();
+        std::remove((path + "." + std::to_string(ippl::Comm->rank())).c_str());
+    }
+
+public:
+    using value_type              = T;
+    using exec_space              = ExecSpace;
+    constexpr static unsigned dim = Dim;
+
+    using mesh_type      = ippl::UniformCartesian<T, Dim>;
+    using centering_type = typename mesh_type::DefaultCentering;
+    using field_type     = ippl::Field<T, Dim, mesh_type, centering_type, ExecSpace>;
+    using vfield_type =
+        ippl::Field<ippl::Vector<T, Dim>, Dim, mesh_type, centering_type, ExecSpace>;
+    using layout_type = ippl::FieldLayout<Dim>;
+    using solver_type = ippl::FFTPoissonSolver<vfield_type, field_type>;
+    using cfield_type = typename solver_type::CxField_t;
+    using cache_type  = ippl::GreensFunctionCache<cfield_type>;
+    using key_type    = typename cache_type::Key;
+
+    GreensFunctionCacheTest()
+        : pt(getGridSizes<Dim>()) {
+        CHECK_SKIP_SERIAL_CONSTRUCTOR;
+
+        std::array<ippl::Index, Dim> domains;
+
+        ippl::Vector<T, Dim> origin;
+
+        ippl::e_dim_tag domDec[Dim];  // Specifies SERIAL, PARALLEL dims
+        for (unsigned d = 0; d < Dim; d++) {
+            domDec[d]  = ippl::PARALLEL;
+            domains[d] = ippl::Index(pt[d]);
+            hx[d]      = T(1) / pt[d];
+            origin[d]  = 0;
+        }
+
+        auto owned = std::make_from_tuple<ippl::NDIndex<Dim>>(domains);
+        layout     = layout_type(owned, domDec);
+
+        mesh = mesh_type(owned, hx, origin);
+
+        rho = std::make_shared<field_type>(mesh, layout);
+    }
+
+    /*!
+     * Gets the solver parameters
+     * @param file the file in which Green's functions are stored
+     * @param entries the capacity of the cache
+     */
+    [[nodiscard]] ippl::ParameterList getParams(const std::string& file, int entries) const {
+        ippl::ParameterList params;
+        params.add("output_type", solver_type::SOL);
+        params.add("algorithm", solver_type::HOCKNEY);
+        params.add("use_heffte_defaults", true);
+        params.add("r2c_direction", 0);
+        params.add("green_cache_entries", entries);
+        params.add("green_cache_file", file);
+        return params;
+    }
+
+    /*!
+     * Gets the key of the Green's function of the solvers on this rank
+     * @param grntr the transformed Green's function
+     * @param algorithm the algorithm of the key
+     */
+    [[nodiscard]] key_type getKey(const cfield_type& grntr,
+                                  int algorithm = solver_type::HOCKNEY) const {
+        key_type key;
+        key.algorithm = algorithm;
+        for (unsigned d = 0; d < Dim; d++) {
+            key.size[d]    = pt[d];
+            key.spacing[d] = hx[d];
+        }
+        key.localDomain = grntr.getLayout().getLocalNDIndex();
+        key.ranks       = ippl::Comm->size();
+        return key;
+    }
+
+    /*!
+     * Solves for the zero charge density, which sets up the Green's function
+     * @param solver the solver
+     */
+    void solve(solver_type& solver) {
+        *rho = 0;
+        solver.solve();
+    }
+
+    /*!
+     * Compares two complex fields on the same layout
+     * @param field the field
+     * @param expected the expected values
+     */
+    void verify(const cfield_type& field, const cfield_type& expected) {
+        T tol = (std::is_same_v<T, double>) ? 1e-12 : 1e-5;
+
+        auto result      = field.getHostMirror();
+        auto reference   = expected.getHostMirror();
+        const int nghost = field.getNghost();
+        Kokkos::deep_copy(result, field.getView());
+        Kokkos::deep_copy(reference, expected.getView());
+
+        nestedViewLoop(result, nghost, [&]<typename... Idx>(const Idx... args) {
+            ASSERT_NEAR(Kokkos::abs(result(args...) - reference(args...)), 0,
+                        tol * Kokkos::abs(reference(args...)) + tol);
+        });
+    }
+
+    mesh_type mesh;
+    layout_type layout;
+    std::shared_ptr<field_type> rho;
+
+    std::array<size_t, Dim> pt;
+    ippl::Vector<T, Dim> hx;
+
+    const std::string path = "greens_function_cache_test";
+};
+
+using Tests = TestParams::tests<2, 3>;
+TYPED_TEST_CASE(GreensFunctionCacheTest, Tests);
+
+TYPED_TEST(GreensFunctionCacheTest, SharedBetweenSolvers) {
+    using field_type  = typename TestFixture::field_type;
+    using solver_type = typename TestFixture::solver_type;
+    using cache_type  = typename TestFixture::cache_type;
+
+    auto params = this->getParams("", 4);
+    solver_type first(*this->rho, params);
+    this->solve(first);
+
+    field_type rho(this->mesh, this->layout);
+    solver_type second(rho, params);
+    rho = 0;
+    second.solve();
+
+    EXPECT_EQ(cache_type::size(), 1u);
+    EXPECT_EQ(first.getGreensFunction().getView().data(),
+              second.getGreensFunction().getView().data());
+}
+
+TYPED_TEST(GreensFunctionCacheTest, EvictsLeastRecentlyUsed) {
+    using cfield_type = typename TestFixture::cfield_type;
+    using cache_type  = typename TestFixture::cache_type;
+
+    cfield_type first(this->mesh, this->layout);
+    cfield_type second(this->mesh, this->layout);
+    cfield_type third(this->mesh, this->layout);
+    cfield_type probe(this->mesh, this->layout);
+
+    const auto keyFirst  = this->getKey(first, 1);
+    const auto keySecond = this->getKey(second, 2);
+    const auto keyThird  = this->getKey(third, 3);
+
+    cache_type::setCapacity(2);
+    cache_type::insert(keyFirst, first);
+    cache_type::insert(keySecond, second);
+
+    // the first entry becomes more recently used than the second
+    ASSERT_TRUE(cache_type::lookup(keyFirst, probe));
+    cache_type::insert(keyThird, third);
+
+    EXPECT_EQ(cache_type::size(), 2u);
+    EXPECT_FALSE(cache_type::lookup(keySecond, probe));
+    EXPECT_TRUE(cache_type::lookup(keyFirst, probe));
+    EXPECT_EQ(probe.getView().data(), first.getView().data());
+    EXPECT_TRUE(cache_type::lookup(keyThird, probe));
+    EXPECT_EQ(probe.getView().data(), third.getView().data());
+}
+
+TYPED_TEST(GreensFunctionCacheTest, SaveAndLoad) {
+    using cfield_type = typename TestFixture::cfield_type;
+    using solver_type = typename TestFixture::solver_type;
+
+    // computes the Green's function and writes it to the file
+    auto params = this->getParams(this->path, 0);
+    solver_type solver(*this->rho, params);
+    this->solve(solver);
+
+    const cfield_type& grntr = solver.getGreensFunction();
+    cfield_type loaded(this->mesh, grntr.getLayout());
+    ASSERT_TRUE(TestFixture::cache_type::load(this->path, this->getKey(grntr), loaded));
+    this->verify(loaded, grntr);
+
+    // a solver with the same setup reads the file instead
+    solver_type reader(*this->rho, params);
+    this->solve(reader);
+    this->verify(reader.getGreensFunction(), grntr);
+}
+
+TYPED_TEST(GreensFunctionCacheTest, IgnoresMismatchedFile) {
+    using T           = typename TestFixture::value_type;
+    using cfield_type = typename TestFixture::cfield_type;
+    using solver_type = typename TestFixture::solver_type;
+    using cache_type  = typename TestFixture::cache_type;
+
+    auto reference = this->getParams("", 0);
+    solver_type fresh(*this->rho, reference);
+    this->solve(fresh);
+    const cfield_type& grntr = fresh.getGreensFunction();
+
+    // a zero Green's function stored for another mesh spacing
+    auto key = this->getKey(grntr);
+    for (unsigned d = 0; d < TestFixture::dim; d++) {
+        key.spacing[d] *= 2;
+    }
+    cfield_type zero(this->mesh, grntr.getLayout());
+    zero = Kokkos::complex<T>(0);
+    cache_type::save(this->path, key, zero);
+
+    EXPECT_FALSE(cache_type::load(this->path, this->getKey(grntr), zero));
+
+    auto params = this->getParams(this->path, 0);
+    solver_type solver(*this->rho, params);
+    this->solve(solver);
+    this->verify(solver.getGreensFunction(), grntr);
+}
+
+int main(int argc, char* argv[]) {
+    int success = 1;
+    TestParams::checkArgs(argc, argv);
+    ippl::initialize(argc, argv);
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        success = RUN_ALL_TESTS();
+    }
+    ippl::finalize();
+    return success;
+}
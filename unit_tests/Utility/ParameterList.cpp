@@ -49,6 +49,14 @@ TEST_F(ParameterListTest, UpdateSingle) {
     ASSERT_FALSE(isContained);
 }
 
+TEST_F(ParameterListTest, GetDefault) {
+    ippl::ParameterList p;
+    p.add<int>("size", 5);
+
+    ASSERT_EQ(p.get<int>("size", 3), 5);
+    ASSERT_EQ(p.get<int>("missing", 3), 3);
+}
+
 TEST_F(ParameterListTest, Merge) {
     ippl::ParameterList p1;
     p1.add<double>("tolerance", 1.0e-8);